@@ -0,0 +1,31 @@
+#version 460
+#extension GL_EXT_buffer_reference : require
+
+struct Instance {
+    mat4 transform;
+    uint meshIndex;
+    uint padding0;
+    uint padding1;
+    uint padding2;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer InstanceBuffer {
+    Instance instances[];
+};
+
+layout(push_constant) uniform DrawParams {
+    mat4 viewProjection;
+    InstanceBuffer instanceBuffer;
+} params;
+
+layout(location = 0) in vec3 posIn;
+layout(location = 1) in vec4 colorIn;
+
+layout(location = 0) out vec4 fragColor;
+
+void main() {
+    // firstInstance of each indirect command is the instance index written by cull.comp
+    mat4 model = params.instanceBuffer.instances[gl_InstanceIndex].transform;
+    gl_Position = params.viewProjection * model * vec4(posIn, 1.0);
+    fragColor = colorIn;
+}
@@ -0,0 +1,16 @@
+#version 460
+
+layout(location = 0) out vec4 fragColor;
+
+// per vertex
+layout(location = 0) in vec2 posIn;
+layout(location = 1) in vec4 colorIn;
+
+// per instance
+layout(location = 2) in vec4 instanceTransform; // xy offset, zw scale
+layout(location = 3) in vec4 instanceColor;
+
+void main() {
+    gl_Position = vec4(posIn * instanceTransform.zw + instanceTransform.xy, 0.0, 1.0);
+    fragColor = colorIn * instanceColor;
+}
@@ -0,0 +1,47 @@
+#version 460
+#extension GL_EXT_buffer_reference : require
+
+// Vertex pulling: six vertices per sprite, no vertex or index buffers bound.
+
+struct Sprite {
+    vec2 position;
+    vec2 size;
+    vec2 origin;
+    float rotation;
+    uint color;
+    vec4 uvRect;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer SpriteBuffer {
+    Sprite sprites[];
+};
+
+layout(push_constant) uniform SpriteParams {
+    mat4 viewProjection;
+    SpriteBuffer spriteBuffer;
+    uint texture;
+} params;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragUv;
+layout(location = 2) flat out uint fragTexture;
+
+const vec2 corners[6] = vec2[](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
+void main() {
+    Sprite sprite = params.spriteBuffer.sprites[gl_VertexIndex / 6];
+    vec2 corner = corners[gl_VertexIndex % 6];
+
+    vec2 local = (corner - sprite.origin) * sprite.size;
+    float s = sin(sprite.rotation);
+    float c = cos(sprite.rotation);
+    vec2 world = sprite.position + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+    gl_Position = params.viewProjection * vec4(world, 0.0, 1.0);
+    fragColor = unpackUnorm4x8(sprite.color);
+    fragUv = mix(sprite.uvRect.xy, sprite.uvRect.zw, corner);
+    fragTexture = params.texture;
+}
@@ -2,7 +2,7 @@ Get-ChildItem "assets\shaders\" -Exclude *.spv |
 ForEach-Object {
     $inname = $_.FullName
     $outname = $_.FullName + ".spv"
-    $output = glslc.exe $inname -o $outname 2>&1
+    $output = glslc.exe --target-env=vulkan1.3 $inname -o $outname 2>&1
     if (-not $?) {
         Write-Host "Failed to compile shader $inname" -ForegroundColor Red
         Write-Host "$output" -ForegroundColor Red
@@ -1,3 +1,3 @@
 #!/bin/bash
 
-find assets/shaders/ ! -name *.spv -type f -exec glslc {} -o {}.spv \; -exec echo "Compiled shader {} -> {}.spv" \;
+find assets/shaders/ ! -name *.spv -type f -exec glslc --target-env=vulkan1.3 {} -o {}.spv \; -exec echo "Compiled shader {} -> {}.spv" \;
@@ -4,7 +4,14 @@
 
 #include "engine_app.hpp"
 
+#include "engine/render/vertex_layout.hpp"
+
 #include <glm/glm.hpp>
+#include <stb_image_write.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
 
 namespace app {
     glfw_lib::glfw_lib() {
@@ -16,15 +23,30 @@ namespace app {
     }
 
     struct Vertex {
-        glm::vec2 position;
-        glm::vec4 color;
+        glm::vec3        position;
+        engine::Unorm8x4 color;
     };
 
-    EngineApp::EngineApp() {
-        m_RenderDevice   = std::make_shared<engine::RenderDevice>();
-        m_Window         = std::make_shared<engine::Window>(m_RenderDevice);
-        m_Swapchain      = std::make_shared<engine::Swapchain>(m_RenderDevice, m_Window);
-        m_WindowRenderer = std::make_shared<engine::WindowRenderer>(m_RenderDevice, m_Swapchain);
+    // a grid of triangles reaching past the screen edges, so the cull pass has something to drop
+    constexpr uint32_t GRID_SIZE     = 12;
+    constexpr float    GRID_EXTENT   = 1.5f;
+    constexpr float    TRIANGLE_SIZE = 0.2f;
+
+    EngineApp::EngineApp(const EngineAppOptions &options) : m_Options(options) {
+        if (m_Options.headless) {
+            m_RenderDevice     = std::make_shared<engine::RenderDevice>(engine::RenderDeviceOptions{.headless = true});
+            m_HeadlessRenderer = std::make_shared<engine::HeadlessRenderer>(m_RenderDevice, m_Options.extent);
+            m_Renderer         = m_HeadlessRenderer;
+        } else {
+            _glfw.emplace();
+            m_RenderDevice = std::make_shared<engine::RenderDevice>();
+            m_Window       = std::make_shared<engine::Window>(m_RenderDevice);
+            m_Swapchain    = std::make_shared<engine::Swapchain>(m_RenderDevice, m_Window);
+            m_Renderer     = std::make_shared<engine::WindowRenderer>(m_RenderDevice, m_Swapchain);
+        }
+        m_ThreadPool    = std::make_shared<engine::ThreadPool>();
+        m_Scheduler     = std::make_shared<engine::SystemScheduler>(m_ThreadPool);
+        m_AssetStreamer = std::make_unique<engine::AssetStreamer>(m_RenderDevice, m_ThreadPool);
         // m_Shader         = engine::Shader::create_linked(
         //     m_RenderDevice,
         //     {
@@ -45,36 +67,81 @@ namespace app {
         //     }
         // );
 
-        m_Shader = engine::MaterialShader::create_shared(
-            m_RenderDevice,
-            {
-                engine::MaterialShaderStage{
-                    .path       = "assets/shaders/main.vert.spv",
-                    .stage      = vk::ShaderStageFlagBits::eVertex,
-                    .entryPoint = "main",
-                    .sil        = {},
-                },
-                engine::MaterialShaderStage{
-                    .path       = "assets/shaders/main.frag.spv",
-                    .stage      = vk::ShaderStageFlagBits::eFragment,
-                    .entryPoint = "main",
-                    .sil        = {},
-                },
-            }
-        );
+        // loose files first so a cooked archive, when present, takes precedence
+        m_FileSystem = std::make_shared<engine::VirtualFileSystem>();
+        m_FileSystem->mountDirectory({});
+        if (std::filesystem::exists("assets.pak")) {
+            m_FileSystem->mountArchive("assets.pak");
+        }
+
+        m_ShaderLibrary = std::make_shared<engine::ShaderLibrary>(m_RenderDevice, m_ThreadPool, m_FileSystem);
+        m_ShaderLibrary->load({
+            engine::MaterialManifestEntry{
+                .name = "indirect",
+                .stages =
+                    {
+                        engine::MaterialShaderStage{
+                            .path       = "assets/shaders/indirect.vert.spv",
+                            .stage      = vk::ShaderStageFlagBits::eVertex,
+                            .entryPoint = "main",
+                            .sil        = {},
+                        },
+                        engine::MaterialShaderStage{
+                            .path       = "assets/shaders/main.frag.spv",
+                            .stage      = vk::ShaderStageFlagBits::eFragment,
+                            .entryPoint = "main",
+                            .sil        = {},
+                        },
+                    },
+            },
+        });
+
+        for (const auto &[name, read_time, create_time] : m_ShaderLibrary->timings()) {
+            std::cout << "Material " << name << " loaded (read " << read_time.count() << "us, create " << create_time.count() << "us)" << std::endl;
+        }
+        std::cout << "Shader library loaded in " << m_ShaderLibrary->lastLoadTime().count() << "us" << std::endl;
+
+        m_Shader = m_ShaderLibrary->get("indirect");
+
+        // only when running from a source tree, cooked builds ship without shader sources; headless runs stay reproducible
+        if (!m_Options.headless && std::filesystem::is_directory("assets/shaders")) {
+            m_ShaderReloader = std::make_unique<engine::ShaderHotReloader>(m_RenderDevice, m_ShaderLibrary, "assets/shaders");
+        }
 
         std::vector<Vertex> vertices = {
-            {{-0.5f, 0.5f}, {1.0f, 1.0f, 0.0f, 1.0f}},
-            {{0.0f, -0.5f}, {0.0f, 1.0f, 1.0f, 1.0f}},
-            {{0.5f, 0.5f}, {1.0f, 0.0f, 1.0f, 1.0f}},
+            {{-0.5f, 0.5f, 0.0f}, engine::packUnorm8x4({1.0f, 1.0f, 0.0f, 1.0f})},
+            {{0.0f, -0.5f, 0.0f}, engine::packUnorm8x4({0.0f, 1.0f, 1.0f, 1.0f})},
+            {{0.5f, 0.5f, 0.0f}, engine::packUnorm8x4({1.0f, 0.0f, 1.0f, 1.0f})},
         };
+        const std::array<uint32_t, 3> indices = {0, 1, 2};
 
         m_VertexBuffer = engine::VertexBuffer::create(
-            m_RenderDevice, engine::VertexBufferStorage::Static, vertices,
-            {vk::VertexInputBindingDescription2EXT(0, sizeof(Vertex), vk::VertexInputRate::eVertex),
-             {vk::VertexInputAttributeDescription2EXT(0, 0, vk::Format::eR32G32Sfloat, offsetof(Vertex, position)),
-              vk::VertexInputAttributeDescription2EXT(1, 0, vk::Format::eR32G32B32A32Sfloat, offsetof(Vertex, color))}}
+            m_RenderDevice, engine::VertexBufferStorage::Static, vertices, engine::makeVertexLayout<ENGINE_VERTEX_ATTRIBUTE(Vertex, position), ENGINE_VERTEX_ATTRIBUTE(Vertex, color)>()
         );
+        m_IndexBuffer = engine::IndexBuffer::create(m_RenderDevice, indices);
+
+        m_Culling = std::make_unique<engine::GpuCulling>(m_RenderDevice, GRID_SIZE * GRID_SIZE);
+        m_Culling->setMeshes(std::array{engine::GpuMesh{
+            .indexCount     = 3,
+            .firstIndex     = 0,
+            .vertexOffset   = 0,
+            ._padding       = 0,
+            .boundingSphere = glm::vec4(0.0f, 0.0f, 0.0f, 0.71f),
+        }});
+
+        std::vector<engine::GpuInstance> instances;
+        for (uint32_t y = 0; y < GRID_SIZE; y++) {
+            for (uint32_t x = 0; x < GRID_SIZE; x++) {
+                engine::GpuInstance instance{};
+                instance.transform    = glm::mat4(TRIANGLE_SIZE);
+                instance.transform[3] = glm::vec4(GRID_EXTENT * (2.0f * static_cast<float>(x) / (GRID_SIZE - 1) - 1.0f),
+                                                  GRID_EXTENT * (2.0f * static_cast<float>(y) / (GRID_SIZE - 1) - 1.0f), 0.5f, 1.0f);
+                instance.meshIndex    = 0;
+                instances.push_back(instance);
+            }
+        }
+        m_Culling->setInstances(0, instances);
+        m_Culling->setInstanceCount(static_cast<uint32_t>(instances.size()));
     }
 
     EngineApp::~EngineApp() {
@@ -82,23 +149,77 @@ namespace app {
     }
 
     void EngineApp::run() {
+        if (m_Options.headless) {
+            runHeadless();
+            return;
+        }
+
         while (!m_Window->shouldClose()) {
             glfwPollEvents();
+            renderFrame();
+            m_Swapchain->update();
+        }
+    }
 
+    void EngineApp::renderFrame() {
+        m_Scheduler->run(m_Registry);
 
-            m_WindowRenderer->renderFrame([&](const vk::raii::CommandBuffer &cmd, const engine::SwapchainFrameInfo &frameInfo, uint32_t currentFrame) {
-                frameInfo.setViewportAndScissor(cmd);
-                engine::Shader::setGenericState(cmd);
+        if (m_ShaderReloader) {
+            m_ShaderReloader->applyPending(*m_Renderer);
+        }
 
-                engine::Shader::bindNull(cmd);
-                m_Shader->bindTo(cmd);
+        m_Renderer->renderFrame(
+            [&](const vk::raii::CommandBuffer &cmd, const engine::SwapchainFrameInfo &, const uint32_t currentFrame) {
+                m_AssetStreamer->update(cmd, currentFrame);
+                // clip space is the world for now, the frustum is the unit cube
+                m_Culling->cull(cmd, currentFrame, engine::Frustum::fromViewProjection(glm::mat4(1.0f)));
+            },
+            [&](const vk::raii::CommandBuffer &cmd, const engine::SwapchainFrameInfo &frameInfo, uint32_t currentFrame) {
+                // a fresh tracker per recording, the frame's command buffer starts with no known state
+                engine::CommandState state(cmd);
+
+                frameInfo.setViewportAndScissor(state);
+                engine::Shader::setGenericState(state);
+
+                engine::Shader::bindNull(state);
+                m_Shader->bindTo(state);
+
+                m_VertexBuffer->bindAndSetState(state, currentFrame);
+                m_IndexBuffer->bind(cmd);
+
+                const engine::GpuDrawPushConstants push_constants{
+                    .viewProjection = glm::mat4(1.0f),
+                    .instances      = m_Culling->instanceBufferAddress(currentFrame),
+                };
+                // reflected from indirect.vert, read every frame since a hot reload can swap the layout
+                const auto &push_range = m_Shader->inputLayout().push_constant_ranges.front();
+                cmd.pushConstants<engine::GpuDrawPushConstants>(m_Shader->layout(), push_range.stageFlags, 0, push_constants);
+
+                m_Culling->draw(cmd, currentFrame);
+            }
+        );
+    }
+
+    void EngineApp::runHeadless() {
+        using Clock = std::chrono::steady_clock;
 
-                m_VertexBuffer->bindAndSetState(cmd, 0);
+        const auto start = Clock::now();
+        for (uint32_t frame = 0; frame < m_Options.frames; frame++) {
+            renderFrame();
+        }
+        // the last frames are still in flight, they count towards the run
+        m_RenderDevice->waitDeviceIdle();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
 
-                cmd.draw(3, 1, 0, 0);
-            });
+        std::cout << "Rendered " << m_Options.frames << " frames at " << m_Options.extent.width << "x" << m_Options.extent.height << " in " << elapsed.count() / 1000
+                  << "ms (" << (m_Options.frames > 0 ? elapsed.count() / m_Options.frames : 0) << "us per frame)" << std::endl;
 
-            m_Swapchain->update();
+        if (!m_Options.capture.empty() && m_Options.frames > 0) {
+            const engine::TextureImage image = m_HeadlessRenderer->capture();
+            const auto                 width = static_cast<int>(image.width);
+            if (!stbi_write_png(m_Options.capture.string().c_str(), width, static_cast<int>(image.height), 4, image.pixels.data(), width * 4)) {
+                throw std::runtime_error("EngineApp::runHeadless(): Failed to write " + m_Options.capture.string());
+            }
         }
     }
 } // namespace app
@@ -4,14 +4,25 @@
 
 #pragma once
 
+#include "engine/assets/asset_streamer.hpp"
+#include "engine/assets/virtual_file_system.hpp"
+#include "engine/ecs/system_scheduler.hpp"
+#include "engine/render/gpu_culling.hpp"
+#include "engine/render/headless_renderer.hpp"
+#include "engine/render/index_buffer.hpp"
 #include "engine/render/material.hpp"
+#include "engine/render/shader_hot_reload.hpp"
+#include "engine/render/shader_library.hpp"
 #include "engine/render/shader_object.hpp"
 #include "engine/render/vertex_buffer.hpp"
 #include "engine/render/window_renderer.hpp"
 #include "engine/swapchain.hpp"
+#include "engine/thread_pool.hpp"
 #include "engine/window.hpp"
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 
 namespace app {
 
@@ -20,22 +31,46 @@ namespace app {
         ~glfw_lib();
     };
 
+    struct EngineAppOptions {
+        // No window or swapchain: renders `frames` frames of `extent` offscreen, prints the average frame time and optionally writes the last
+        // frame to `capture` (PNG). Runs without a display, on software Vulkan in CI or on render servers.
+        bool                  headless = false;
+        vk::Extent2D          extent   = {640, 480};
+        uint32_t              frames   = 1000;
+        std::filesystem::path capture;
+    };
+
     class EngineApp {
       public:
-        EngineApp();
+        explicit EngineApp(const EngineAppOptions &options = {});
         ~EngineApp();
 
         void run();
 
       private:
-        glfw_lib _glfw{};
-
-        std::shared_ptr<engine::Window>         m_Window;
-        std::shared_ptr<engine::RenderDevice>   m_RenderDevice;
-        std::shared_ptr<engine::Swapchain>      m_Swapchain;
-        std::shared_ptr<engine::WindowRenderer> m_WindowRenderer;
-        std::shared_ptr<engine::MaterialShader> m_Shader;
-        std::shared_ptr<engine::VertexBuffer>   m_VertexBuffer;
+        void renderFrame();
+        void runHeadless();
+
+        EngineAppOptions        m_Options;
+        std::optional<glfw_lib> _glfw; // only initialized with a window
+
+        std::shared_ptr<engine::Window>            m_Window;
+        std::shared_ptr<engine::RenderDevice>      m_RenderDevice;
+        std::shared_ptr<engine::Swapchain>         m_Swapchain;
+        std::shared_ptr<engine::FrameRenderer>     m_Renderer; // WindowRenderer, or HeadlessRenderer when headless
+        std::shared_ptr<engine::HeadlessRenderer>  m_HeadlessRenderer;
+        std::shared_ptr<engine::VirtualFileSystem> m_FileSystem;
+        std::shared_ptr<engine::ShaderLibrary>     m_ShaderLibrary;
+        std::shared_ptr<engine::MaterialShader>    m_Shader;
+        std::unique_ptr<engine::ShaderHotReloader> m_ShaderReloader;
+        std::shared_ptr<engine::VertexBuffer>      m_VertexBuffer;
+        std::shared_ptr<engine::IndexBuffer>       m_IndexBuffer;
+        std::unique_ptr<engine::GpuCulling>        m_Culling;
+
+        std::shared_ptr<engine::ThreadPool>      m_ThreadPool;
+        std::shared_ptr<engine::SystemScheduler> m_Scheduler;
+        std::unique_ptr<engine::AssetStreamer>   m_AssetStreamer; // after the pool, its destructor waits on pool jobs
+        entt::registry                           m_Registry;
     };
 
 } // namespace app
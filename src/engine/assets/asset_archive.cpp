@@ -0,0 +1,282 @@
+#include "asset_archive.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Defined with the stb_image_write implementation but not declared by its header.
+extern "C" unsigned char *stbi_zlib_compress(unsigned char *data, int data_len, int *out_len, int quality);
+
+namespace engine {
+    namespace {
+        constexpr char     ARCHIVE_MAGIC[4] = {'G', 'E', 'P', 'K'};
+        constexpr uint32_t ARCHIVE_VERSION  = 1;
+        constexpr int      DEFLATE_QUALITY  = 8;
+
+        constexpr uint64_t alignUp(const uint64_t value) {
+            return (value + ARCHIVE_ALIGNMENT - 1) & ~static_cast<uint64_t>(ARCHIVE_ALIGNMENT - 1);
+        }
+    } // namespace
+
+    MappedFile::MappedFile(const std::filesystem::path &path) {
+#ifdef WIN32
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("MappedFile::MappedFile(): Failed to open file " + path.string());
+        }
+
+        LARGE_INTEGER size{};
+        GetFileSizeEx(file, &size);
+        m_Size = static_cast<std::size_t>(size.QuadPart);
+
+        if (m_Size > 0) {
+            m_Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_Mapping) {
+                m_Data = static_cast<const std::byte *>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+        }
+        CloseHandle(file);
+
+        if (m_Size > 0 && !m_Data) {
+            unmap();
+            throw std::runtime_error("MappedFile::MappedFile(): Failed to map file " + path.string());
+        }
+#else
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("MappedFile::MappedFile(): Failed to open file " + path.string());
+        }
+
+        struct stat st{};
+        fstat(fd, &st);
+        m_Size = static_cast<std::size_t>(st.st_size);
+
+        if (m_Size > 0) {
+            void *data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("MappedFile::MappedFile(): Failed to map file " + path.string());
+            }
+            m_Data = static_cast<const std::byte *>(data);
+        }
+        close(fd); // the mapping keeps its own reference to the file
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+        unmap();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+        : m_Data(std::exchange(other.m_Data, nullptr)), m_Size(std::exchange(other.m_Size, 0))
+#ifdef WIN32
+          ,
+          m_Mapping(std::exchange(other.m_Mapping, nullptr))
+#endif
+    {
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            m_Data = std::exchange(other.m_Data, nullptr);
+            m_Size = std::exchange(other.m_Size, 0);
+#ifdef WIN32
+            m_Mapping = std::exchange(other.m_Mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    void MappedFile::unmap() {
+#ifdef WIN32
+        if (m_Data) {
+            UnmapViewOfFile(m_Data);
+        }
+        if (m_Mapping) {
+            CloseHandle(m_Mapping);
+        }
+        m_Mapping = nullptr;
+#else
+        if (m_Data) {
+            munmap(const_cast<std::byte *>(m_Data), m_Size);
+        }
+#endif
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+
+    AssetArchive::AssetArchive(const std::filesystem::path &path) : m_File(path) {
+        const auto bytes = m_File.bytes();
+
+        ArchiveHeader header{};
+        if (bytes.size() < sizeof(header)) {
+            throw std::invalid_argument("AssetArchive::AssetArchive(): " + path.string() + " is not an asset archive");
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0) {
+            throw std::invalid_argument("AssetArchive::AssetArchive(): " + path.string() + " is not an asset archive");
+        }
+        if (header.version != ARCHIVE_VERSION) {
+            throw std::invalid_argument("AssetArchive::AssetArchive(): " + path.string() + " has unsupported version " + std::to_string(header.version));
+        }
+
+        const uint64_t toc_size = sizeof(ArchiveEntry) * static_cast<uint64_t>(header.entryCount);
+        if (header.tocOffset % alignof(ArchiveEntry) != 0 || header.tocOffset > bytes.size() || toc_size + header.namesSize > bytes.size() - header.tocOffset) {
+            throw std::invalid_argument("AssetArchive::AssetArchive(): " + path.string() + " is truncated");
+        }
+
+        m_Entries        = {reinterpret_cast<const ArchiveEntry *>(bytes.data() + header.tocOffset), header.entryCount};
+        const auto names = reinterpret_cast<const char *>(bytes.data() + header.tocOffset + toc_size);
+
+        m_Index.reserve(header.entryCount);
+        for (uint32_t i = 0; i < header.entryCount; i++) {
+            const auto &entry = m_Entries[i];
+            if (static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header.namesSize || entry.offset > header.tocOffset ||
+                entry.storedSize > header.tocOffset - entry.offset) {
+                throw std::invalid_argument("AssetArchive::AssetArchive(): " + path.string() + " has a corrupt entry");
+            }
+            m_Index.emplace(std::string_view(names + entry.nameOffset, entry.nameLength), i);
+        }
+    }
+
+    const ArchiveEntry *AssetArchive::find(const std::string_view name) const {
+        const auto it = m_Index.find(name);
+        return it == m_Index.end() ? nullptr : &m_Entries[it->second];
+    }
+
+    std::span<const std::byte> AssetArchive::view(const ArchiveEntry &entry) const {
+        if (entry.compression != AssetCompression::None) {
+            throw std::invalid_argument("AssetArchive::view(): Compressed entries have to be read");
+        }
+        return m_File.bytes().subspan(entry.offset, entry.storedSize);
+    }
+
+    std::vector<std::byte> AssetArchive::read(const ArchiveEntry &entry) const {
+        const auto stored = m_File.bytes().subspan(entry.offset, entry.storedSize);
+
+        switch (entry.compression) {
+        case AssetCompression::None:
+            return {stored.begin(), stored.end()};
+        case AssetCompression::Deflate: {
+            if (entry.size > INT_MAX || entry.storedSize > INT_MAX) {
+                throw std::runtime_error("AssetArchive::read(): Entry is too large to inflate");
+            }
+            std::vector<std::byte> data(entry.size);
+            const int              inflated = stbi_zlib_decode_buffer(
+                reinterpret_cast<char *>(data.data()), static_cast<int>(data.size()), reinterpret_cast<const char *>(stored.data()), static_cast<int>(stored.size())
+            );
+            if (inflated != static_cast<int>(entry.size)) {
+                throw std::runtime_error("AssetArchive::read(): Corrupt compressed entry");
+            }
+            return data;
+        }
+        default:
+            throw std::runtime_error("AssetArchive::read(): Unknown compression");
+        }
+    }
+
+    void AssetArchiveWriter::add(const std::string &name, const std::span<const std::byte> data, const AssetCompression compression) {
+        if (std::ranges::any_of(m_Entries, [&](const Entry &entry) { return entry.name == name; })) {
+            throw std::invalid_argument("AssetArchiveWriter::add(): Duplicate entry " + name);
+        }
+        if (name.size() > UINT16_MAX) {
+            throw std::invalid_argument("AssetArchiveWriter::add(): Entry name is too long");
+        }
+
+        Entry entry{name, {data.begin(), data.end()}, data.size(), AssetCompression::None};
+
+        if (compression == AssetCompression::Deflate && !data.empty() && data.size() <= INT_MAX) {
+            int            compressed_size = 0;
+            unsigned char *compressed =
+                stbi_zlib_compress(reinterpret_cast<unsigned char *>(entry.stored.data()), static_cast<int>(entry.stored.size()), &compressed_size, DEFLATE_QUALITY);
+            if (compressed && static_cast<std::size_t>(compressed_size) < data.size()) {
+                const auto begin  = reinterpret_cast<const std::byte *>(compressed);
+                entry.stored      = {begin, begin + compressed_size};
+                entry.compression = AssetCompression::Deflate;
+            }
+            std::free(compressed);
+        }
+
+        m_Entries.push_back(std::move(entry));
+    }
+
+    void AssetArchiveWriter::addFile(const std::string &name, const std::filesystem::path &path, const AssetCompression compression) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            throw std::runtime_error("AssetArchiveWriter::addFile(): Failed to open file " + path.string());
+        }
+
+        std::vector<std::byte> data(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        add(name, data, compression);
+    }
+
+    void AssetArchiveWriter::write(const std::filesystem::path &path) const {
+        std::vector<ArchiveEntry> toc;
+        std::string               names;
+        uint64_t                  offset = alignUp(sizeof(ArchiveHeader));
+        for (const auto &entry : m_Entries) {
+            toc.push_back({
+                .offset      = offset,
+                .storedSize  = entry.stored.size(),
+                .size        = entry.size,
+                .nameOffset  = static_cast<uint32_t>(names.size()),
+                .nameLength  = static_cast<uint16_t>(entry.name.size()),
+                .compression = entry.compression,
+                ._padding    = 0,
+            });
+            names += entry.name;
+            offset = alignUp(offset + entry.stored.size());
+        }
+
+        ArchiveHeader header{};
+        std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+        header.version    = ARCHIVE_VERSION;
+        header.entryCount = static_cast<uint32_t>(toc.size());
+        header.namesSize  = static_cast<uint32_t>(names.size());
+        header.tocOffset  = offset;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("AssetArchiveWriter::write(): Failed to open file " + path.string());
+        }
+
+        const auto pad_to = [&](const uint64_t target) {
+            static constexpr char zeros[ARCHIVE_ALIGNMENT]{};
+            file.write(zeros, static_cast<std::streamsize>(target - static_cast<uint64_t>(file.tellp())));
+        };
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (std::size_t i = 0; i < m_Entries.size(); i++) {
+            pad_to(toc[i].offset);
+            file.write(reinterpret_cast<const char *>(m_Entries[i].stored.data()), static_cast<std::streamsize>(m_Entries[i].stored.size()));
+        }
+        pad_to(header.tocOffset);
+        file.write(reinterpret_cast<const char *>(toc.data()), static_cast<std::streamsize>(sizeof(ArchiveEntry) * toc.size()));
+        file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+        if (!file) {
+            throw std::runtime_error("AssetArchiveWriter::write(): Failed to write " + path.string());
+        }
+    }
+} // namespace engine
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+    // Archive layout (little endian):
+    //   ArchiveHeader | blobs, each starting on an ARCHIVE_ALIGNMENT boundary | ArchiveEntry[entryCount] | entry names
+    // Uncompressed blobs can be used straight out of the mapping, the alignment covers SPIR-V words and vertex data.
+    constexpr std::size_t ARCHIVE_ALIGNMENT = 64;
+
+    enum class AssetCompression : uint8_t {
+        None    = 0,
+        Deflate = 1, // zlib stream
+    };
+
+    struct ArchiveHeader {
+        char     magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t namesSize;
+        uint64_t tocOffset;
+    };
+    static_assert(sizeof(ArchiveHeader) == 24);
+
+    struct ArchiveEntry {
+        uint64_t         offset;
+        uint64_t         storedSize; // bytes in the archive
+        uint64_t         size;       // bytes once decompressed
+        uint32_t         nameOffset; // into the name table
+        uint16_t         nameLength;
+        AssetCompression compression;
+        uint8_t          _padding;
+    };
+    static_assert(sizeof(ArchiveEntry) == 32);
+
+    // Read-only memory mapping of a whole file. Pages are only read when touched.
+    class MappedFile {
+      public:
+        // Throws std::runtime_error when the file cannot be opened or mapped.
+        explicit MappedFile(const std::filesystem::path &path);
+        ~MappedFile();
+
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        MappedFile(const MappedFile &)            = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        [[nodiscard]] inline std::span<const std::byte> bytes() const { return {m_Data, m_Size}; }
+
+      private:
+        void unmap();
+
+        const std::byte *m_Data = nullptr;
+        std::size_t      m_Size = 0;
+#ifdef WIN32
+        void *m_Mapping = nullptr;
+#endif
+    };
+
+    // Mapped archive. Names are looked up in a table built once at open and pointing into the mapping.
+    class AssetArchive {
+      public:
+        // Throws std::runtime_error when the file cannot be mapped and std::invalid_argument when it is not a valid archive.
+        explicit AssetArchive(const std::filesystem::path &path);
+
+        [[nodiscard]] bool                contains(std::string_view name) const { return m_Index.contains(name); }
+        [[nodiscard]] const ArchiveEntry *find(std::string_view name) const;
+        [[nodiscard]] std::size_t         size() const { return m_Index.size(); }
+
+        // Bytes of an uncompressed entry, pointing into the mapping (valid as long as the archive). Throws std::invalid_argument for compressed entries.
+        [[nodiscard]] std::span<const std::byte> view(const ArchiveEntry &entry) const;
+        // Decompressed copy of any entry. Throws std::runtime_error if the stored data is corrupt.
+        [[nodiscard]] std::vector<std::byte> read(const ArchiveEntry &entry) const;
+
+      private:
+        MappedFile                                          m_File;
+        std::span<const ArchiveEntry>                       m_Entries;
+        std::unordered_map<std::string_view, std::uint32_t> m_Index;
+    };
+
+    // Builds archives, used by the asset packer.
+    class AssetArchiveWriter {
+      public:
+        // Compressed entries that do not shrink are stored uncompressed. Throws std::invalid_argument for duplicate names.
+        void add(const std::string &name, std::span<const std::byte> data, AssetCompression compression = AssetCompression::None);
+        void addFile(const std::string &name, const std::filesystem::path &path, AssetCompression compression = AssetCompression::None);
+
+        // Throws std::runtime_error when the file cannot be written.
+        void write(const std::filesystem::path &path) const;
+
+      private:
+        struct Entry {
+            std::string            name;
+            std::vector<std::byte> stored;
+            uint64_t               size;
+            AssetCompression       compression;
+        };
+
+        std::vector<Entry> m_Entries;
+    };
+
+} // namespace engine
@@ -0,0 +1,230 @@
+#include "asset_streamer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+namespace engine {
+    namespace {
+        constexpr vk::DeviceSize STAGING_ALIGNMENT = 16; // keeps every copy source suitably aligned for any format's texel block
+
+        // Moves the request to `to` unless it was cancelled in the meantime.
+        bool advance(StreamRequestState &state, const StreamStatus from, const StreamStatus to) {
+            auto expected = from;
+            return state.status.compare_exchange_strong(expected, to, std::memory_order_acq_rel);
+        }
+    } // namespace
+
+    bool StreamHandle::finished() const {
+        const auto status = this->status();
+        return status == StreamStatus::Done || status == StreamStatus::Cancelled || status == StreamStatus::Failed;
+    }
+
+    void StreamHandle::cancel() const {
+        auto status = m_State->status.load(std::memory_order_acquire);
+        while (status != StreamStatus::Done && status != StreamStatus::Failed && status != StreamStatus::Cancelled) {
+            if (m_State->status.compare_exchange_weak(status, StreamStatus::Cancelled, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+    }
+
+    AssetStreamer::AssetStreamer(const std::shared_ptr<RenderDevice> &render_device, const std::shared_ptr<ThreadPool> &thread_pool, const AssetStreamerOptions &options)
+        : m_RenderDevice(render_device), m_ThreadPool(thread_pool), m_Options(options) {
+        if (m_Options.uploadBudget == 0 || m_Options.maxReadsInFlight == 0) {
+            throw std::invalid_argument("AssetStreamer::AssetStreamer(): Upload budget and reads in flight must be non-zero");
+        }
+        m_Options.uploadBudget = (m_Options.uploadBudget + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+
+        auto [staging, info] = m_RenderDevice->createBuffer(
+            m_Options.uploadBudget * MAX_FRAMES_IN_FLIGHT, vk::BufferUsageFlagBits::eTransferSrc, MemoryUsage::AutoPreferHost,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        );
+        m_Staging = std::move(staging);
+        m_Mapped  = static_cast<std::byte *>(info.pMappedData);
+
+        m_Reader = std::make_unique<AsyncFileReader>(m_ThreadPool, m_Options.maxReadsInFlight);
+    }
+
+    AssetStreamer::~AssetStreamer() {
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_ShuttingDown = true;
+            for (const auto &state : m_Queued) {
+                StreamHandle(state).cancel();
+            }
+            m_Queued.clear();
+        }
+
+        // reads already submitted still complete, their completions see the shutdown and drop the data
+        m_ThreadPool->waitFor([this] {
+            std::scoped_lock lock(m_Mutex);
+            return m_ReadsInFlight == 0 && m_DecodesInFlight == 0;
+        });
+        m_Reader.reset();
+    }
+
+    StreamHandle AssetStreamer::request(const std::filesystem::path &path, const int32_t priority, StreamDecode decode, StreamUpload upload) {
+        if (!upload) {
+            throw std::invalid_argument("AssetStreamer::request(): Upload function is required");
+        }
+
+        auto state      = std::make_shared<StreamRequestState>();
+        state->path     = path;
+        state->decode   = std::move(decode);
+        state->upload   = std::move(upload);
+        state->priority = priority;
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_Queued.push_back(state);
+        }
+
+        startReads();
+        return StreamHandle(state);
+    }
+
+    void AssetStreamer::startReads() {
+        std::vector<std::shared_ptr<StreamRequestState>> starting;
+        {
+            std::scoped_lock lock(m_Mutex);
+            if (m_ShuttingDown) {
+                return;
+            }
+            std::erase_if(m_Queued, [](const auto &state) { return state->status.load(std::memory_order_relaxed) == StreamStatus::Cancelled; });
+
+            while (!m_Queued.empty() && m_ReadsInFlight < m_Options.maxReadsInFlight) {
+                // linear scan, the queue is bounded by what the game keeps requesting and priorities change while queued
+                const auto it = std::ranges::max_element(m_Queued, {}, [](const auto &state) { return state->priority.load(std::memory_order_relaxed); });
+                if (advance(**it, StreamStatus::Queued, StreamStatus::Reading)) {
+                    starting.push_back(std::move(*it));
+                    m_ReadsInFlight++;
+                }
+                *it = std::move(m_Queued.back());
+                m_Queued.pop_back();
+            }
+        }
+
+        for (auto &state : starting) {
+            m_Reader->read(state->path, [this, state](std::vector<std::byte> data, const bool ok) { onRead(state, std::move(data), ok); });
+        }
+    }
+
+    void AssetStreamer::onRead(const std::shared_ptr<StreamRequestState> &state, std::vector<std::byte> data, const bool ok) {
+        bool decode = false;
+        {
+            std::scoped_lock lock(m_Mutex);
+            if (m_ShuttingDown) {
+                StreamHandle(state).cancel();
+            } else if (!ok) {
+                if (advance(*state, StreamStatus::Reading, StreamStatus::Failed)) {
+                    std::cerr << "Failed to stream " << state->path.string() << std::endl;
+                }
+            } else if (advance(*state, StreamStatus::Reading, StreamStatus::Decoding)) {
+                decode = true;
+                m_DecodesInFlight++; // before the read is released, so the destructor never sees both at zero in between
+            }
+            m_ReadsInFlight--;
+        }
+
+        if (decode) {
+            m_ThreadPool->enqueue([this, state, data = std::move(data)]() mutable {
+                try {
+                    state->data = state->decode ? state->decode(std::move(data)) : std::move(data);
+                    if (advance(*state, StreamStatus::Decoding, StreamStatus::Ready)) {
+                        std::scoped_lock lock(m_Mutex);
+                        m_Decoded.push_back(state);
+                    }
+                } catch (std::exception &e) {
+                    if (advance(*state, StreamStatus::Decoding, StreamStatus::Failed)) {
+                        std::cerr << "Failed to decode " << state->path.string() << ": " << e.what() << std::endl;
+                    }
+                }
+
+                std::scoped_lock lock(m_Mutex);
+                m_DecodesInFlight--;
+            });
+        }
+
+        // a slot just freed up
+        startReads();
+    }
+
+    vk::DeviceSize AssetStreamer::update(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame) {
+        for (auto &oversized : m_Oversized) {
+            oversized.framesLeft--;
+        }
+        while (!m_Oversized.empty() && m_Oversized.front().framesLeft == 0) {
+            m_Oversized.pop_front();
+        }
+
+        {
+            std::scoped_lock lock(m_Mutex);
+            std::ranges::move(m_Decoded, std::back_inserter(m_Ready));
+            m_Decoded.clear();
+        }
+        std::erase_if(m_Ready, [](const auto &state) { return state->status.load(std::memory_order_relaxed) != StreamStatus::Ready; });
+        if (m_Ready.empty()) {
+            return 0;
+        }
+
+        // highest priority at the back, so finished uploads pop off the end
+        std::ranges::stable_sort(m_Ready, {}, [](const auto &state) { return state->priority.load(std::memory_order_relaxed); });
+
+        const vk::DeviceSize region = m_Options.uploadBudget * current_frame;
+        vk::DeviceSize       used   = 0;
+        vk::DeviceSize       total  = 0;
+        while (!m_Ready.empty()) {
+            StreamRequestState  &state = *m_Ready.back();
+            const vk::DeviceSize size  = state.data.size();
+
+            if (used + size > m_Options.uploadBudget) {
+                if (total > 0) {
+                    break; // next frame
+                }
+
+                // too large for any frame's budget, give it a buffer of its own and nothing else this frame
+                auto [staging, info] = m_RenderDevice->createBuffer(
+                    size, vk::BufferUsageFlagBits::eTransferSrc, MemoryUsage::AutoPreferHost, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+                );
+                std::memcpy(info.pMappedData, state.data.data(), size);
+                staging.allocation->flush(0, size);
+                if (advance(state, StreamStatus::Ready, StreamStatus::Done)) {
+                    state.upload(cmd, staging, 0, size);
+                }
+                m_Oversized.push_back({std::move(staging), MAX_FRAMES_IN_FLIGHT});
+                total = size;
+                state.data = {};
+                m_Ready.pop_back();
+                break;
+            }
+
+            if (advance(state, StreamStatus::Ready, StreamStatus::Done)) {
+                if (size > 0) {
+                    std::memcpy(m_Mapped + region + used, state.data.data(), size);
+                }
+                state.upload(cmd, m_Staging, region + used, size);
+                used = (used + size + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+                total += size;
+            }
+            state.data = {};
+            m_Ready.pop_back();
+        }
+
+        if (used > 0) {
+            m_Staging.allocation->flush(region, std::min(used, m_Options.uploadBudget));
+        }
+        if (total > 0) {
+            vk::DependencyInfo dependency{};
+
+            const vk::MemoryBarrier2 upload_barrier(
+                vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::PipelineStageFlagBits2::eAllCommands, vk::AccessFlagBits2::eMemoryRead
+            );
+            dependency.setMemoryBarriers(upload_barrier);
+            cmd.pipelineBarrier2(dependency);
+        }
+
+        return total;
+    }
+} // namespace engine
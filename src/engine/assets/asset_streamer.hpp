@@ -0,0 +1,120 @@
+#pragma once
+
+#include "engine/assets/async_file_reader.hpp"
+#include "engine/render/frame_renderer.hpp"
+#include "engine/render_device.hpp"
+#include "engine/thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace engine {
+
+    enum class StreamStatus {
+        Queued,    // waiting for a read slot
+        Reading,   // read submitted
+        Decoding,  // decode job on the thread pool
+        Ready,     // decoded, waiting for upload budget
+        Done,      // upload recorded
+        Cancelled,
+        Failed,    // the file could not be read or decoding threw
+    };
+
+    // Runs on a pool worker, turning the file's contents into the bytes to upload.
+    using StreamDecode = std::function<std::vector<std::byte>(std::vector<std::byte> file)>;
+    // Runs on the render thread inside `AssetStreamer::update`. Records the copies out of `staging` ([offset, offset + size) holds the decoded
+    // bytes) into the destination, plus any layout transitions. The streamer makes transfer writes visible to every later command.
+    using StreamUpload = std::function<void(const vk::raii::CommandBuffer &cmd, const RawBuffer &staging, vk::DeviceSize offset, vk::DeviceSize size)>;
+
+    struct StreamRequestState {
+        std::filesystem::path     path;
+        StreamDecode              decode;
+        StreamUpload              upload;
+        std::vector<std::byte>    data;
+        std::atomic<StreamStatus> status   = StreamStatus::Queued;
+        std::atomic<int32_t>      priority = 0;
+    };
+
+    // Shared view of one request. Dropping the handle does not cancel the request.
+    class StreamHandle {
+      public:
+        StreamHandle() = default;
+        explicit StreamHandle(std::shared_ptr<StreamRequestState> state) : m_State(std::move(state)) {}
+
+        [[nodiscard]] StreamStatus status() const { return m_State->status.load(std::memory_order_acquire); }
+        [[nodiscard]] bool         finished() const;
+
+        // Stops the request at its next stage. Has no effect once the upload has been recorded or the request failed.
+        void cancel() const;
+        // Higher priorities are read and uploaded first. Only affects stages the request has not reached yet.
+        void setPriority(int32_t priority) const { m_State->priority.store(priority, std::memory_order_relaxed); }
+
+        explicit operator bool() const { return m_State != nullptr; }
+
+      private:
+        std::shared_ptr<StreamRequestState> m_State;
+    };
+
+    struct AssetStreamerOptions {
+        // Bytes copied to the GPU per frame. A single upload larger than the budget gets a frame of its own.
+        vk::DeviceSize uploadBudget     = 8ull * 1024 * 1024;
+        uint32_t       maxReadsInFlight = 16;
+    };
+
+    // Loads assets in the background without ever blocking the frame loop: reads go through `AsyncFileReader` (batched io_uring where available),
+    // decoding runs on the thread pool and uploads are recorded by `update` on the frame's command buffer, limited to a byte budget per frame.
+    // Each stage picks the highest priority request first.
+    class AssetStreamer {
+      public:
+        AssetStreamer(const std::shared_ptr<RenderDevice> &render_device, const std::shared_ptr<ThreadPool> &thread_pool, const AssetStreamerOptions &options = {});
+        // Cancels outstanding requests and waits for running reads and decode jobs. The device must be idle.
+        ~AssetStreamer();
+
+        AssetStreamer(const AssetStreamer &)            = delete;
+        AssetStreamer &operator=(const AssetStreamer &) = delete;
+
+        // A null `decode` uploads the file as is.
+        StreamHandle request(const std::filesystem::path &path, int32_t priority, StreamDecode decode, StreamUpload upload);
+
+        // Call once per frame from the render thread, before rendering begins (`WindowRenderer::renderFrame`'s `prepare`).
+        // Stages decoded requests into the frame's part of the staging buffer and records their uploads. Returns the bytes uploaded.
+        vk::DeviceSize update(const vk::raii::CommandBuffer &cmd, uint32_t current_frame);
+
+        [[nodiscard]] bool usesIoUring() const { return m_Reader->usesIoUring(); }
+
+      private:
+        struct Oversized {
+            RawBuffer staging;
+            uint32_t  framesLeft;
+        };
+
+        void startReads();
+        void onRead(const std::shared_ptr<StreamRequestState> &state, std::vector<std::byte> data, bool ok);
+
+        std::shared_ptr<RenderDevice> m_RenderDevice;
+        std::shared_ptr<ThreadPool>   m_ThreadPool;
+        AssetStreamerOptions          m_Options;
+
+        RawBuffer  m_Staging{nullptr}; // uploadBudget per frame in flight, persistently mapped
+        std::byte *m_Mapped = nullptr;
+
+        std::mutex                                       m_Mutex;
+        std::vector<std::shared_ptr<StreamRequestState>> m_Queued;
+        std::vector<std::shared_ptr<StreamRequestState>> m_Decoded;
+        uint32_t                                         m_ReadsInFlight   = 0;
+        uint32_t                                         m_DecodesInFlight = 0;
+        bool                                             m_ShuttingDown    = false;
+
+        std::vector<std::shared_ptr<StreamRequestState>> m_Ready;     // render thread only
+        std::deque<Oversized>                            m_Oversized; // render thread only
+
+        std::unique_ptr<AsyncFileReader> m_Reader;
+    };
+
+} // namespace engine
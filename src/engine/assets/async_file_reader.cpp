@@ -0,0 +1,258 @@
+#include "async_file_reader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+    struct AsyncFileReader::Read {
+        std::filesystem::path  path;
+        Completion             completion;
+        int                    fd = -1;
+        std::vector<std::byte> data;
+        std::size_t            done = 0;
+    };
+
+#ifdef __linux__
+    // Minimal io_uring over the raw syscalls: one submission queue of reads, completions reaped by the owning thread.
+    struct AsyncFileReader::Ring {
+        int      fd = -1;
+        uint32_t entries{};
+
+        void       *sqRing = MAP_FAILED, *cqRing = MAP_FAILED, *sqeMemory = MAP_FAILED;
+        std::size_t sqRingSize{}, cqRingSize{}, sqeMemorySize{};
+
+        uint32_t     *sqTail{}, *sqMask{}, *sqArray{};
+        uint32_t     *cqHead{}, *cqTail{}, *cqMask{};
+        io_uring_sqe *sqes{};
+        io_uring_cqe *cqes{};
+
+        static std::unique_ptr<Ring> create(const uint32_t queue_depth) {
+            io_uring_params params{};
+            auto            ring = std::make_unique<Ring>();
+            ring->fd             = static_cast<int>(syscall(__NR_io_uring_setup, queue_depth, &params));
+            // IORING_OP_READ arrived in the same kernel as IORING_FEAT_RW_CUR_POS
+            if (ring->fd < 0 || !(params.features & IORING_FEAT_RW_CUR_POS)) {
+                return nullptr;
+            }
+
+            ring->entries    = params.sq_entries;
+            ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+            ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+            const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (single_mmap) {
+                ring->sqRingSize = ring->cqRingSize = std::max(ring->sqRingSize, ring->cqRingSize);
+            }
+
+            ring->sqRing = mmap(nullptr, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+            if (ring->sqRing == MAP_FAILED) {
+                return nullptr;
+            }
+            ring->cqRing = single_mmap ? ring->sqRing : mmap(nullptr, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+            if (ring->cqRing == MAP_FAILED) {
+                return nullptr;
+            }
+            ring->sqeMemorySize = params.sq_entries * sizeof(io_uring_sqe);
+            ring->sqeMemory     = mmap(nullptr, ring->sqeMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+            if (ring->sqeMemory == MAP_FAILED) {
+                return nullptr;
+            }
+
+            const auto sq = static_cast<std::byte *>(ring->sqRing);
+            const auto cq = static_cast<std::byte *>(ring->cqRing);
+            ring->sqTail  = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+            ring->sqMask  = reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+            ring->sqArray = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+            ring->cqHead  = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+            ring->cqTail  = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+            ring->cqMask  = reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+            ring->cqes    = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+            ring->sqes    = static_cast<io_uring_sqe *>(ring->sqeMemory);
+            return ring;
+        }
+
+        ~Ring() {
+            if (sqeMemory != MAP_FAILED) {
+                munmap(sqeMemory, sqeMemorySize);
+            }
+            if (cqRing != MAP_FAILED && cqRing != sqRing) {
+                munmap(cqRing, cqRingSize);
+            }
+            if (sqRing != MAP_FAILED) {
+                munmap(sqRing, sqRingSize);
+            }
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+
+        // Queues a read of the rest of the file. The caller keeps at most `entries` reads in flight, so the queue never overflows.
+        void prepareRead(Read *read) const {
+            const uint32_t tail  = std::atomic_ref(*sqTail).load(std::memory_order_relaxed);
+            const uint32_t index = tail & *sqMask;
+
+            io_uring_sqe &sqe = sqes[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode    = IORING_OP_READ;
+            sqe.fd        = read->fd;
+            sqe.addr      = reinterpret_cast<uint64_t>(read->data.data() + read->done);
+            sqe.len       = static_cast<uint32_t>(std::min<std::size_t>(read->data.size() - read->done, 1u << 30));
+            sqe.off       = read->done;
+            sqe.user_data = reinterpret_cast<uint64_t>(read);
+
+            sqArray[index] = index;
+            std::atomic_ref(*sqTail).store(tail + 1, std::memory_order_release);
+        }
+
+        void enter(const uint32_t to_submit, const uint32_t min_complete) const {
+            while (syscall(__NR_io_uring_enter, fd, to_submit, min_complete, min_complete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0) < 0 && errno == EINTR) {
+            }
+        }
+    };
+#else
+    struct AsyncFileReader::Ring {};
+#endif
+
+    AsyncFileReader::AsyncFileReader(const std::shared_ptr<ThreadPool> &thread_pool, [[maybe_unused]] const uint32_t queue_depth) : m_ThreadPool(thread_pool) {
+#ifdef __linux__
+        m_Ring = Ring::create(queue_depth);
+        if (m_Ring) {
+            m_Thread = std::jthread([this](const std::stop_token &stop_token) { ringLoop(stop_token); });
+        }
+#endif
+    }
+
+    AsyncFileReader::~AsyncFileReader() {
+        if (m_Thread.joinable()) {
+            m_Thread.request_stop();
+            m_Thread.join();
+        }
+        m_ThreadPool->waitFor([this] { return m_PoolReads.load() == 0; });
+    }
+
+    void AsyncFileReader::read(const std::filesystem::path &path, Completion completion) {
+        if (m_Ring) {
+            auto request        = std::make_unique<Read>();
+            request->path       = path;
+            request->completion = std::move(completion);
+            {
+                std::scoped_lock lock(m_Mutex);
+                m_Queue.push_back(std::move(request));
+            }
+            m_Submitted.notify_one();
+            return;
+        }
+
+        ++m_PoolReads;
+        m_ThreadPool->enqueue([this, path, completion = std::move(completion)] {
+            std::vector<std::byte> data;
+            bool                   ok = false;
+            if (std::ifstream file(path, std::ios::binary | std::ios::ate); file.is_open()) {
+                data.resize(static_cast<std::size_t>(file.tellg()));
+                file.seekg(0, std::ios::beg);
+                ok = static_cast<bool>(file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size())));
+            }
+            completion(std::move(data), ok);
+            --m_PoolReads;
+        });
+    }
+
+    void AsyncFileReader::ringLoop([[maybe_unused]] const std::stop_token &stop_token) {
+#ifdef __linux__
+        const auto finish = [](std::unique_ptr<Read> read, const bool ok) {
+            if (read->fd >= 0) {
+                close(read->fd);
+            }
+            read->completion(ok ? std::move(read->data) : std::vector<std::byte>{}, ok);
+        };
+
+        uint32_t                           in_flight = 0;
+        std::vector<std::unique_ptr<Read>> starting;
+        for (;;) {
+            {
+                std::unique_lock lock(m_Mutex);
+                if (in_flight == 0) {
+                    m_Submitted.wait(lock, stop_token, [this] { return !m_Queue.empty(); });
+                    if (m_Queue.empty()) {
+                        break; // stop requested with nothing left to do
+                    }
+                }
+                while (!m_Queue.empty() && in_flight + starting.size() < m_Ring->entries) {
+                    starting.push_back(std::move(m_Queue.front()));
+                    m_Queue.pop_front();
+                }
+            }
+
+            uint32_t to_submit = 0;
+            for (auto &read : starting) {
+                read->fd = open(read->path.c_str(), O_RDONLY | O_CLOEXEC);
+                struct stat st{};
+                if (read->fd < 0 || fstat(read->fd, &st) != 0) {
+                    finish(std::move(read), false);
+                    continue;
+                }
+                if (st.st_size == 0) {
+                    finish(std::move(read), true);
+                    continue;
+                }
+
+                read->data.resize(static_cast<std::size_t>(st.st_size));
+                m_Ring->prepareRead(read.release()); // owned by the ring until its completion is reaped
+                in_flight++;
+                to_submit++;
+            }
+            starting.clear();
+
+            if (in_flight == 0) {
+                continue;
+            }
+            m_Ring->enter(to_submit, 1);
+
+            uint32_t       head = std::atomic_ref(*m_Ring->cqHead).load(std::memory_order_relaxed);
+            const uint32_t tail = std::atomic_ref(*m_Ring->cqTail).load(std::memory_order_acquire);
+            to_submit           = 0;
+            for (; head != tail; head++) {
+                const io_uring_cqe &cqe = m_Ring->cqes[head & *m_Ring->cqMask];
+                std::unique_ptr<Read> read(reinterpret_cast<Read *>(cqe.user_data));
+
+                if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                    m_Ring->prepareRead(read.release());
+                    to_submit++;
+                    continue;
+                }
+                if (cqe.res <= 0) { // error, or the file shrank under us
+                    in_flight--;
+                    finish(std::move(read), false);
+                    continue;
+                }
+
+                read->done += static_cast<std::size_t>(cqe.res);
+                if (read->done < read->data.size()) { // short read, ask for the rest
+                    m_Ring->prepareRead(read.release());
+                    to_submit++;
+                    continue;
+                }
+
+                in_flight--;
+                finish(std::move(read), true);
+            }
+            std::atomic_ref(*m_Ring->cqHead).store(head, std::memory_order_release);
+
+            if (to_submit > 0) {
+                m_Ring->enter(to_submit, 0);
+            }
+        }
+#endif
+    }
+} // namespace engine
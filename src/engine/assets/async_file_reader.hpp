@@ -0,0 +1,55 @@
+#pragma once
+
+#include "engine/thread_pool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+    // Whole-file reads completed asynchronously. On Linux reads are batched through an io_uring driven by the reader's own thread;
+    // where io_uring is unavailable (other platforms, old kernels, seccomp) each read is a blocking job on the thread pool instead.
+    class AsyncFileReader {
+      public:
+        // Called with the file's contents, or with `ok == false` when it could not be read. Runs on the reader's thread or a pool worker,
+        // so it should only hand the data on.
+        using Completion = std::function<void(std::vector<std::byte> data, bool ok)>;
+
+        explicit AsyncFileReader(const std::shared_ptr<ThreadPool> &thread_pool, uint32_t queue_depth = 64);
+        // Waits for the reads already submitted; their completions still run.
+        ~AsyncFileReader();
+
+        AsyncFileReader(const AsyncFileReader &)            = delete;
+        AsyncFileReader &operator=(const AsyncFileReader &) = delete;
+
+        void read(const std::filesystem::path &path, Completion completion);
+
+        [[nodiscard]] bool usesIoUring() const { return m_Ring != nullptr; }
+
+      private:
+        struct Ring;
+        struct Read;
+
+        void ringLoop(const std::stop_token &stop_token);
+
+        std::shared_ptr<ThreadPool> m_ThreadPool;
+        std::unique_ptr<Ring>       m_Ring;
+
+        std::mutex                        m_Mutex;
+        std::condition_variable_any       m_Submitted;
+        std::deque<std::unique_ptr<Read>> m_Queue;
+
+        std::atomic<uint32_t> m_PoolReads = 0; // fallback reads still running
+
+        std::jthread m_Thread;
+    };
+
+} // namespace engine
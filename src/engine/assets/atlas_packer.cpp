@@ -0,0 +1,157 @@
+#include "atlas_packer.hpp"
+
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine {
+    namespace {
+        uint32_t roundUp(const uint32_t value, const uint32_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        AtlasRect merge(const AtlasRect &a, const AtlasRect &b) {
+            if (a.width == 0 || a.height == 0) {
+                return b;
+            }
+            const uint32_t x0 = std::min(a.x, b.x);
+            const uint32_t y0 = std::min(a.y, b.y);
+            const uint32_t x1 = std::max(a.x + a.width, b.x + b.width);
+            const uint32_t y1 = std::max(a.y + a.height, b.y + b.height);
+            return {x0, y0, x1 - x0, y1 - y0};
+        }
+    } // namespace
+
+    // Packing works in units of the alignment, which keeps every slot on the mip grid and the skyline short.
+    struct AtlasPacker::Page {
+        stbrp_context           context{};
+        std::vector<stbrp_node> nodes;
+        std::vector<std::byte>  pixels;
+        AtlasRect               dirty;
+    };
+
+    AtlasPacker::AtlasPacker(const AtlasPackerOptions &options) : m_Options(options) {
+        if (m_Options.mipLevels == 0 || m_Options.mipLevels > mipLevelCount(m_Options.pageSize, m_Options.pageSize)) {
+            throw std::invalid_argument("AtlasPacker::AtlasPacker(): Page has fewer mip levels than requested");
+        }
+        m_Alignment = 1u << (m_Options.mipLevels - 1);
+        if (m_Options.pageSize % m_Alignment != 0) {
+            throw std::invalid_argument("AtlasPacker::AtlasPacker(): Page size must be a multiple of the mip grid");
+        }
+        // level n averages 2^n texels, so 2^(mipLevels - 1) texels of padding keep the last level's edge texels inside the image's own border
+        m_Padding = roundUp(m_Options.mipLevels > 1 ? std::max(m_Options.padding, m_Alignment) : m_Options.padding, m_Alignment);
+    }
+
+    AtlasPacker::~AtlasPacker() = default;
+
+    AtlasPacker::AtlasPacker(AtlasPacker &&) noexcept            = default;
+    AtlasPacker &AtlasPacker::operator=(AtlasPacker &&) noexcept = default;
+
+    AtlasImageId AtlasPacker::insert(const TextureImage &image) {
+        return insert(std::span(&image, 1));
+    }
+
+    AtlasImageId AtlasPacker::insert(const std::span<const TextureImage> images) {
+        const auto first = static_cast<AtlasImageId>(m_Regions.size());
+
+        std::vector<stbrp_rect> pending(images.size());
+        for (std::size_t i = 0; i < images.size(); i++) {
+            const TextureImage &image = images[i];
+            if (image.width == 0 || image.height == 0 || image.pixels.size() != std::size_t{image.width} * image.height * 4) {
+                throw std::invalid_argument("AtlasPacker::insert(): Image must not be empty");
+            }
+            const uint32_t width  = roundUp(image.width + 2 * m_Padding, m_Alignment);
+            const uint32_t height = roundUp(image.height + 2 * m_Padding, m_Alignment);
+            if (width > m_Options.pageSize || height > m_Options.pageSize) {
+                throw std::invalid_argument("AtlasPacker::insert(): Image is larger than a page");
+            }
+            pending[i] = {static_cast<int>(i), static_cast<stbrp_coord>(width / m_Alignment), static_cast<stbrp_coord>(height / m_Alignment), 0, 0, 0};
+        }
+
+        m_Regions.resize(m_Regions.size() + images.size());
+        // older pages first so they fill up, then as many new pages as the rest needs; an empty page always takes at least one image
+        for (uint32_t page = 0; !pending.empty(); page++) {
+            Page &target = page < m_Pages.size() ? *m_Pages[page] : addPage();
+            stbrp_pack_rects(&target.context, pending.data(), static_cast<int>(pending.size()));
+
+            std::erase_if(pending, [&](const stbrp_rect &rect) {
+                if (!rect.was_packed) {
+                    return false;
+                }
+                const TextureImage &image = images[rect.id];
+                const AtlasRect     slot{
+                    static_cast<uint32_t>(rect.x) * m_Alignment,
+                    static_cast<uint32_t>(rect.y) * m_Alignment,
+                    static_cast<uint32_t>(rect.w) * m_Alignment,
+                    static_cast<uint32_t>(rect.h) * m_Alignment,
+                };
+                write(page, image, slot);
+
+                const auto      size = static_cast<float>(m_Options.pageSize);
+                const AtlasRect texels{slot.x + m_Padding, slot.y + m_Padding, image.width, image.height};
+                m_Regions[first + rect.id] = AtlasRegion{
+                    .page    = page,
+                    .texture = m_Options.firstTexture + page,
+                    .rect    = texels,
+                    .uvRect  = glm::vec4(texels.x, texels.y, texels.x + texels.width, texels.y + texels.height) / size,
+                };
+                return true;
+            });
+        }
+        return first;
+    }
+
+    uint32_t AtlasPacker::pageCount() const {
+        return static_cast<uint32_t>(m_Pages.size());
+    }
+
+    std::span<const std::byte> AtlasPacker::pagePixels(const uint32_t page) const {
+        return m_Pages.at(page)->pixels;
+    }
+
+    AtlasRect AtlasPacker::dirtyRect(const uint32_t page) const {
+        return m_Pages.at(page)->dirty;
+    }
+
+    void AtlasPacker::clearDirty(const uint32_t page) {
+        m_Pages.at(page)->dirty = {};
+    }
+
+    AtlasPacker::Page &AtlasPacker::addPage() {
+        const int units = static_cast<int>(m_Options.pageSize / m_Alignment);
+
+        auto page = std::make_unique<Page>();
+        // a node per unit of width lets the packer place rects without quantizing their widths
+        page->nodes.resize(units);
+        stbrp_init_target(&page->context, units, units, page->nodes.data(), units);
+        page->pixels.resize(std::size_t{m_Options.pageSize} * m_Options.pageSize * 4);
+
+        m_Pages.push_back(std::move(page));
+        return *m_Pages.back();
+    }
+
+    void AtlasPacker::write(const uint32_t page, const TextureImage &image, const AtlasRect slot) {
+        Page &target = *m_Pages[page];
+
+        // the whole slot is covered, texels outside the image repeat its nearest edge texel
+        for (uint32_t y = 0; y < slot.height; y++) {
+            const uint32_t source_y = static_cast<uint32_t>(std::clamp<int64_t>(int64_t{y} - m_Padding, 0, image.height - 1));
+            const auto    *source   = &image.pixels[std::size_t{source_y} * image.width * 4];
+            auto          *row      = &target.pixels[(std::size_t{slot.y + y} * m_Options.pageSize + slot.x) * 4];
+
+            const uint32_t left  = std::min(m_Padding, slot.width);
+            const uint32_t right = std::min(m_Padding + image.width, slot.width);
+            for (uint32_t x = 0; x < left; x++) {
+                std::memcpy(row + x * 4, source, 4);
+            }
+            std::memcpy(row + left * 4, source, std::size_t{right - left} * 4);
+            for (uint32_t x = right; x < slot.width; x++) {
+                std::memcpy(row + x * 4, source + std::size_t{image.width - 1} * 4, 4);
+            }
+        }
+        target.dirty = merge(target.dirty, slot);
+    }
+} // namespace engine
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "engine/assets/texture_image.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+    using AtlasImageId = uint32_t;
+
+    struct AtlasRect {
+        uint32_t x      = 0;
+        uint32_t y      = 0;
+        uint32_t width  = 0;
+        uint32_t height = 0;
+    };
+
+    // Where an image ended up, the UV remap table holds one per inserted image.
+    struct AtlasRegion {
+        uint32_t  page;
+        uint32_t  texture; // `firstTexture + page`, the texture id to draw with (e.g. SpriteBatcher::draw)
+        AtlasRect rect;    // texels of the image in the page, padding excluded
+        glm::vec4 uvRect;  // min uv, max uv, as Sprite::uvRect takes it
+    };
+
+    struct AtlasPackerOptions {
+        uint32_t pageSize = 2048; // width and height of every page
+        // Texels around each image repeating its edges, so bilinear filtering never reads a neighbour. Rounded up to cover the mips.
+        uint32_t padding      = 2;
+        uint32_t mipLevels    = 3; // levels kept free of bleeding: images are placed on a 2^(mipLevels - 1) texel grid
+        uint32_t firstTexture = 0;
+    };
+
+    // Packs images into RGBA8 pages with stb_rect_pack's skyline packer. Pages are filled incrementally: images can be inserted at any time,
+    // existing regions never move, and a new page is opened when none of the current ones has room. Written texels are tracked per page so
+    // only they need to be uploaded again.
+    class AtlasPacker {
+      public:
+        // Throws std::invalid_argument when the page can't hold the mip grid.
+        explicit AtlasPacker(const AtlasPackerOptions &options = {});
+        ~AtlasPacker();
+
+        AtlasPacker(AtlasPacker &&) noexcept;
+        AtlasPacker &operator=(AtlasPacker &&) noexcept;
+
+        // Throws std::invalid_argument for an empty image or one that doesn't fit a page with its padding.
+        AtlasImageId insert(const TextureImage &image);
+        // Packs the images together, which fills pages tighter than inserting them one by one. Ids are consecutive, the first is returned.
+        AtlasImageId insert(std::span<const TextureImage> images);
+
+        [[nodiscard]] const AtlasRegion           &region(const AtlasImageId id) const { return m_Regions.at(id); }
+        [[nodiscard]] std::span<const AtlasRegion> regions() const { return m_Regions; }
+
+        [[nodiscard]] uint32_t                   pageCount() const;
+        [[nodiscard]] std::span<const std::byte> pagePixels(uint32_t page) const;
+        // Bounds of the texels written since the last `clearDirty`, zero sized when there are none.
+        [[nodiscard]] AtlasRect dirtyRect(uint32_t page) const;
+        void                    clearDirty(uint32_t page);
+
+        [[nodiscard]] uint32_t pageSize() const { return m_Options.pageSize; }
+        [[nodiscard]] uint32_t mipLevels() const { return m_Options.mipLevels; }
+        [[nodiscard]] uint32_t padding() const { return m_Padding; }
+
+      private:
+        struct Page;
+
+        Page &addPage();
+        void  write(uint32_t page, const TextureImage &image, AtlasRect slot);
+
+        AtlasPackerOptions m_Options;
+        uint32_t           m_Alignment;
+        uint32_t           m_Padding;
+
+        std::vector<std::unique_ptr<Page>> m_Pages; // the packer keeps pointers into its page, they must not move
+        std::vector<AtlasRegion>           m_Regions;
+    };
+
+} // namespace engine
@@ -0,0 +1,463 @@
+#include "texture_compression.hpp"
+
+#include "engine/simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace engine {
+    namespace {
+        constexpr int TEXELS = 16;
+
+        // Block texels as floats, one array per channel so projections run across texels.
+        struct Block {
+            alignas(32) float c[4][TEXELS];
+        };
+
+        struct Endpoints {
+            float a[4]{};
+            float b[4]{};
+        };
+
+        // Interpolation weights of BC7's 4-bit indices, out of 64.
+        constexpr std::array<int, 16> BC7_WEIGHTS = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        // BC1 index of each step along c0 -> c1.
+        constexpr std::array<uint32_t, 4> BC1_INDEX = {0, 2, 3, 1};
+
+        struct BitWriter {
+            uint8_t *out;
+            uint32_t bit = 0;
+
+            void write(const uint32_t value, const uint32_t count) {
+                for (uint32_t i = 0; i < count; i++, bit++) {
+                    out[bit >> 3] |= static_cast<uint8_t>(((value >> i) & 1) << (bit & 7));
+                }
+            }
+        };
+
+        void projectScalar(const float *const *channels, const int count, const float *a, const float *d, const float scale, const int levels, uint8_t *out) {
+            const auto max_index = static_cast<float>(levels - 1);
+            for (int i = 0; i < TEXELS; i++) {
+                float t = 0.0f;
+                for (int c = 0; c < count; c++) {
+                    t += (channels[c][i] - a[c]) * d[c];
+                }
+                out[i] = static_cast<uint8_t>(std::nearbyint(std::clamp(t * scale, 0.0f, max_index)));
+            }
+        }
+
+#ifdef ENGINE_SIMD_X86
+        ENGINE_TARGET_AVX2 void projectAvx2(const float *const *channels, const int count, const float *a, const float *d, const float scale, const int levels, uint8_t *out) {
+            const __m256 zero      = _mm256_setzero_ps();
+            const __m256 max_index = _mm256_set1_ps(static_cast<float>(levels - 1));
+            for (int half = 0; half < TEXELS; half += 8) {
+                __m256 t = zero;
+                for (int c = 0; c < count; c++) {
+                    t = _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(channels[c] + half), _mm256_set1_ps(a[c])), _mm256_set1_ps(d[c]), t);
+                }
+                t = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(t, _mm256_set1_ps(scale)), zero), max_index);
+
+                alignas(32) int32_t lanes[8];
+                _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), _mm256_cvtps_epi32(t)); // rounds to nearest, like nearbyint
+                for (int i = 0; i < 8; i++) {
+                    out[half + i] = static_cast<uint8_t>(lanes[i]);
+                }
+            }
+        }
+#endif
+
+        // Quantizes each texel's position along a -> b to one of `levels` evenly spaced steps (0 at a).
+        void project(const float *const *channels, const int count, const float *a, const float *b, const int levels, uint8_t *out) {
+            float d[4]{};
+            float length2 = 0.0f;
+            for (int c = 0; c < count; c++) {
+                d[c] = b[c] - a[c];
+                length2 += d[c] * d[c];
+            }
+            if (length2 < 1e-6f) {
+                std::fill_n(out, TEXELS, 0);
+                return;
+            }
+
+            const float scale = static_cast<float>(levels - 1) / length2;
+#ifdef ENGINE_SIMD_X86
+            if (simd::hasAvx2()) {
+                projectAvx2(channels, count, a, d, scale, levels, out);
+                return;
+            }
+#endif
+            projectScalar(channels, count, a, d, scale, levels, out);
+        }
+
+        void project(const Block &block, const int count, const float *a, const float *b, const int levels, uint8_t *out) {
+            const float *channels[4] = {block.c[0], block.c[1], block.c[2], block.c[3]};
+            project(channels, count, a, b, levels, out);
+        }
+
+        // Endpoints spanning the texels along the principal axis of their covariance (power iteration).
+        Endpoints principalEndpoints(const Block &block, const int count) {
+            float mean[4]{}, low[4], high[4];
+            for (int c = 0; c < count; c++) {
+                low[c]  = 255.0f;
+                high[c] = 0.0f;
+                for (int i = 0; i < TEXELS; i++) {
+                    mean[c] += block.c[c][i];
+                    low[c]  = std::min(low[c], block.c[c][i]);
+                    high[c] = std::max(high[c], block.c[c][i]);
+                }
+                mean[c] /= TEXELS;
+            }
+
+            float covariance[4][4]{};
+            for (int i = 0; i < TEXELS; i++) {
+                for (int r = 0; r < count; r++) {
+                    for (int c = r; c < count; c++) {
+                        covariance[r][c] += (block.c[r][i] - mean[r]) * (block.c[c][i] - mean[c]);
+                    }
+                }
+            }
+            for (int r = 0; r < count; r++) {
+                for (int c = 0; c < r; c++) {
+                    covariance[r][c] = covariance[c][r];
+                }
+            }
+
+            // the bounding box diagonal is already close for most blocks, a few iterations settle the rest
+            float axis[4]{};
+            for (int c = 0; c < count; c++) {
+                axis[c] = high[c] - low[c];
+            }
+            for (int iteration = 0; iteration < 8; iteration++) {
+                float next[4]{};
+                float largest = 0.0f;
+                for (int r = 0; r < count; r++) {
+                    for (int c = 0; c < count; c++) {
+                        next[r] += covariance[r][c] * axis[c];
+                    }
+                    largest = std::max(largest, std::abs(next[r]));
+                }
+                if (largest < 1e-6f) {
+                    break;
+                }
+                for (int c = 0; c < count; c++) {
+                    axis[c] = next[c] / largest;
+                }
+            }
+
+            float length2 = 0.0f;
+            for (int c = 0; c < count; c++) {
+                length2 += axis[c] * axis[c];
+            }
+
+            Endpoints endpoints;
+            if (length2 < 1e-12f) { // flat block
+                std::copy_n(mean, count, endpoints.a);
+                std::copy_n(mean, count, endpoints.b);
+                return endpoints;
+            }
+
+            float t_min = 0.0f, t_max = 0.0f;
+            for (int i = 0; i < TEXELS; i++) {
+                float t = 0.0f;
+                for (int c = 0; c < count; c++) {
+                    t += (block.c[c][i] - mean[c]) * axis[c];
+                }
+                t_min = std::min(t_min, t);
+                t_max = std::max(t_max, t);
+            }
+            for (int c = 0; c < count; c++) {
+                endpoints.a[c] = std::clamp(mean[c] + axis[c] * t_min / length2, 0.0f, 255.0f);
+                endpoints.b[c] = std::clamp(mean[c] + axis[c] * t_max / length2, 0.0f, 255.0f);
+            }
+            return endpoints;
+        }
+
+        // Endpoints minimizing the squared error for fixed indices, `weights[k]` being how far step k lies towards b.
+        // Returns false when the indices don't pin down two endpoints (all texels on one step).
+        bool leastSquares(const Block &block, const int count, const uint8_t *steps, const float *weights, Endpoints &endpoints) {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ra[4]{}, rb[4]{};
+            for (int i = 0; i < TEXELS; i++) {
+                const float w = weights[steps[i]];
+                aa += (1.0f - w) * (1.0f - w);
+                ab += (1.0f - w) * w;
+                bb += w * w;
+                for (int c = 0; c < count; c++) {
+                    ra[c] += (1.0f - w) * block.c[c][i];
+                    rb[c] += w * block.c[c][i];
+                }
+            }
+
+            const float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f) {
+                return false;
+            }
+            for (int c = 0; c < count; c++) {
+                endpoints.a[c] = std::clamp((bb * ra[c] - ab * rb[c]) / determinant, 0.0f, 255.0f);
+                endpoints.b[c] = std::clamp((aa * rb[c] - ab * ra[c]) / determinant, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        // BC1 color -------------------------------------------------------------------------------------------------------------------------
+
+        uint16_t pack565(const float *color) {
+            const auto r = static_cast<uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+            const auto g = static_cast<uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+            const auto b = static_cast<uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+            return static_cast<uint16_t>(r << 11 | g << 5 | b);
+        }
+
+        void unpack565(const uint16_t packed, float *color) {
+            const uint32_t r = packed >> 11 & 31, g = packed >> 5 & 63, b = packed & 31;
+            color[0]         = static_cast<float>(r << 3 | r >> 2);
+            color[1]         = static_cast<float>(g << 2 | g >> 4);
+            color[2]         = static_cast<float>(b << 3 | b >> 2);
+        }
+
+        struct ColorFit {
+            float    error;
+            uint16_t c0, c1;
+            uint32_t indices;
+            uint8_t  steps[TEXELS]; // along a -> b of the endpoints that were fitted
+        };
+
+        ColorFit fitColor(const Block &block, const Endpoints &endpoints) {
+            ColorFit fit{};
+            fit.c0 = pack565(endpoints.a);
+            fit.c1 = pack565(endpoints.b);
+
+            float a[4]{}, b[4]{};
+            unpack565(fit.c0, a);
+            unpack565(fit.c1, b);
+            project(block, 3, a, b, 4, fit.steps);
+
+            for (int i = 0; i < TEXELS; i++) {
+                const float w = static_cast<float>(fit.steps[i]) / 3.0f;
+                for (int c = 0; c < 3; c++) {
+                    const float e = a[c] + (b[c] - a[c]) * w - block.c[c][i];
+                    fit.error += e * e;
+                }
+            }
+
+            // four color mode needs c0 > c1, the palette is symmetric so swapping just walks the steps backwards
+            const bool swap = fit.c0 < fit.c1;
+            if (swap) {
+                std::swap(fit.c0, fit.c1);
+            }
+            for (int i = 0; i < TEXELS; i++) {
+                const uint32_t step = fit.c0 == fit.c1 ? 0 : swap ? 3 - fit.steps[i] : fit.steps[i];
+                fit.indices |= BC1_INDEX[step] << (i * 2);
+            }
+            return fit;
+        }
+
+        void encodeColor(const Block &block, uint8_t *out) {
+            Endpoints endpoints = principalEndpoints(block, 3);
+            // pull the ends in a little, extremes are rarely worth a whole palette entry
+            for (int c = 0; c < 3; c++) {
+                const float inset = (endpoints.b[c] - endpoints.a[c]) / 16.0f;
+                endpoints.a[c] += inset;
+                endpoints.b[c] -= inset;
+            }
+
+            ColorFit best = fitColor(block, endpoints);
+
+            constexpr float weights[4] = {0.0f, 1.0f / 3.0f, 2.0f / 3.0f, 1.0f};
+            if (Endpoints refined; best.error > 0.0f && leastSquares(block, 3, best.steps, weights, refined)) {
+                if (const ColorFit fit = fitColor(block, refined); fit.error < best.error) {
+                    best = fit;
+                }
+            }
+
+            std::memcpy(out, &best.c0, 2);
+            std::memcpy(out + 2, &best.c1, 2);
+            std::memcpy(out + 4, &best.indices, 4);
+        }
+
+        // BC4 channel -----------------------------------------------------------------------------------------------------------------------
+
+        void encodeChannel(const Block &block, const int channel, uint8_t *out) {
+            const float *values = block.c[channel];
+            const auto [low, high] = std::minmax_element(values, values + TEXELS);
+
+            // eight step mode (a0 > a1), interpolated entries at indices 2..7
+            const float a0 = std::nearbyint(*high);
+            const float a1 = std::nearbyint(*low);
+            out[0]         = static_cast<uint8_t>(a0);
+            out[1]         = static_cast<uint8_t>(a1);
+            std::fill_n(out + 2, 6, 0);
+            if (a0 == a1) {
+                return;
+            }
+
+            uint8_t steps[TEXELS];
+            project(&values, 1, &a0, &a1, 8, steps);
+
+            BitWriter writer{out + 2};
+            for (const uint8_t step : steps) {
+                writer.write(step == 0 ? 0 : step == 7 ? 1 : step + 1, 3);
+            }
+        }
+
+        // BC7 mode 6 ------------------------------------------------------------------------------------------------------------------------
+
+        // 7 bits per channel plus a p-bit shared by the endpoint's channels, whichever p-bit lands closer.
+        void quantizeBc7(const float *endpoint, uint8_t *q, uint8_t &p_bit) {
+            float best = -1.0f;
+            for (uint8_t p = 0; p < 2; p++) {
+                uint8_t candidate[4];
+                float   error = 0.0f;
+                for (int c = 0; c < 4; c++) {
+                    candidate[c]  = static_cast<uint8_t>(std::clamp(std::lround((endpoint[c] - p) / 2.0f), 0l, 127l));
+                    const float e = static_cast<float>(candidate[c] * 2 + p) - endpoint[c];
+                    error += e * e;
+                }
+                if (best < 0.0f || error < best) {
+                    best  = error;
+                    p_bit = p;
+                    std::copy_n(candidate, 4, q);
+                }
+            }
+        }
+
+        struct Bc7Fit {
+            float   error;
+            uint8_t q0[4], q1[4];
+            uint8_t p0, p1;
+            uint8_t steps[TEXELS];
+        };
+
+        Bc7Fit fitBc7(const Block &block, const Endpoints &endpoints) {
+            Bc7Fit fit{};
+            quantizeBc7(endpoints.a, fit.q0, fit.p0);
+            quantizeBc7(endpoints.b, fit.q1, fit.p1);
+
+            float a[4], b[4];
+            int   ia[4], ib[4];
+            for (int c = 0; c < 4; c++) {
+                ia[c] = fit.q0[c] * 2 + fit.p0;
+                ib[c] = fit.q1[c] * 2 + fit.p1;
+                a[c]  = static_cast<float>(ia[c]);
+                b[c]  = static_cast<float>(ib[c]);
+            }
+            project(block, 4, a, b, 16, fit.steps);
+
+            for (int i = 0; i < TEXELS; i++) {
+                const int w = BC7_WEIGHTS[fit.steps[i]];
+                for (int c = 0; c < 4; c++) {
+                    const float e = static_cast<float>(((64 - w) * ia[c] + w * ib[c] + 32) >> 6) - block.c[c][i];
+                    fit.error += e * e;
+                }
+            }
+            return fit;
+        }
+
+        void encodeBc7(const Block &block, uint8_t *out) {
+            Bc7Fit best = fitBc7(block, principalEndpoints(block, 4));
+
+            float weights[16];
+            for (int k = 0; k < 16; k++) {
+                weights[k] = static_cast<float>(BC7_WEIGHTS[k]) / 64.0f;
+            }
+            if (Endpoints refined; best.error > 0.0f && leastSquares(block, 4, best.steps, weights, refined)) {
+                if (const Bc7Fit fit = fitBc7(block, refined); fit.error < best.error) {
+                    best = fit;
+                }
+            }
+
+            // the first texel's index drops its top bit, so it has to be in the lower half
+            if (best.steps[0] >= 8) {
+                std::swap(best.q0, best.q1);
+                std::swap(best.p0, best.p1);
+                for (auto &step : best.steps) {
+                    step = static_cast<uint8_t>(15 - step);
+                }
+            }
+
+            std::fill_n(out, 16, 0);
+            BitWriter writer{out};
+            writer.write(1 << 6, 7); // mode 6
+            for (int c = 0; c < 4; c++) {
+                writer.write(best.q0[c], 7);
+                writer.write(best.q1[c], 7);
+            }
+            writer.write(best.p0, 1);
+            writer.write(best.p1, 1);
+            writer.write(best.steps[0], 3);
+            for (int i = 1; i < TEXELS; i++) {
+                writer.write(best.steps[i], 4);
+            }
+        }
+    } // namespace
+
+    void encodeBlock(const BlockFormat format, const uint8_t *rgba, uint8_t *out) {
+        Block block;
+        for (int i = 0; i < TEXELS; i++) {
+            for (int c = 0; c < 4; c++) {
+                block.c[c][i] = rgba[i * 4 + c];
+            }
+        }
+
+        switch (format) {
+        case BlockFormat::BC1:
+            encodeColor(block, out);
+            break;
+        case BlockFormat::BC3:
+            encodeChannel(block, 3, out);
+            encodeColor(block, out + 8);
+            break;
+        case BlockFormat::BC4:
+            encodeChannel(block, 0, out);
+            break;
+        case BlockFormat::BC5:
+            encodeChannel(block, 0, out);
+            encodeChannel(block, 1, out + 8);
+            break;
+        case BlockFormat::BC7:
+            encodeBc7(block, out);
+            break;
+        default:
+            throw std::invalid_argument("encodeBlock(): Unknown block format");
+        }
+    }
+
+    std::vector<std::byte> compressImage(const BlockFormat format, const TextureImage &image, ThreadPool *thread_pool) {
+        if (image.width == 0 || image.height == 0 || image.pixels.size() != std::size_t{image.width} * image.height * 4) {
+            throw std::invalid_argument("compressImage(): Image is empty or its pixels don't match its size");
+        }
+
+        const uint32_t         blocks_x = (image.width + 3) / 4;
+        const uint32_t         blocks_y = (image.height + 3) / 4;
+        const uint32_t         bytes    = blockBytes(format);
+        std::vector<std::byte> compressed(blockCompressedSize(format, image.width, image.height));
+
+        const auto encode_rows = [&](const std::size_t begin, const std::size_t end) {
+            uint8_t texels[TEXELS * 4];
+            for (auto by = static_cast<uint32_t>(begin); by < end; by++) {
+                for (uint32_t bx = 0; bx < blocks_x; bx++) {
+                    for (uint32_t y = 0; y < 4; y++) {
+                        const uint32_t source_y = std::min(by * 4 + y, image.height - 1);
+                        for (uint32_t x = 0; x < 4; x++) {
+                            const uint32_t source_x = std::min(bx * 4 + x, image.width - 1);
+                            std::memcpy(&texels[(y * 4 + x) * 4], &image.pixels[(std::size_t{source_y} * image.width + source_x) * 4], 4);
+                        }
+                    }
+                    encodeBlock(format, texels, reinterpret_cast<uint8_t *>(&compressed[(std::size_t{by} * blocks_x + bx) * bytes]));
+                }
+            }
+        };
+
+        if (thread_pool) {
+            thread_pool->parallelFor(blocks_y, 1, encode_rows);
+        } else {
+            encode_rows(0, blocks_y);
+        }
+        return compressed;
+    }
+} // namespace engine
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "engine/assets/texture_file.hpp"
+#include "engine/assets/texture_image.hpp"
+#include "engine/thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+    // Encodes one 4x4 block of RGBA8 texels (row major, 64 bytes) into `blockBytes(format)` bytes.
+    // Endpoints come from the principal axis of the block's colors, refined once by least squares; indices are assigned by projection onto
+    // the endpoint segment (AVX2 when available). BC7 uses mode 6 only (one subset, RGBA endpoints with p-bits, 4-bit indices).
+    void encodeBlock(BlockFormat format, const uint8_t *rgba, uint8_t *out);
+
+    // Encodes a whole image, edge blocks are padded by clamping. Block rows are spread over the pool when one is given.
+    std::vector<std::byte> compressImage(BlockFormat format, const TextureImage &image, ThreadPool *thread_pool = nullptr);
+
+} // namespace engine
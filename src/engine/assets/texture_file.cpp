@@ -0,0 +1,98 @@
+#include "texture_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine {
+    namespace {
+        constexpr char     TEXTURE_MAGIC[4] = {'G', 'E', 'T', 'X'};
+        constexpr uint32_t TEXTURE_VERSION  = 1;
+
+        constexpr uint64_t alignUp(const uint64_t value) {
+            return (value + TEXTURE_FILE_ALIGNMENT - 1) & ~static_cast<uint64_t>(TEXTURE_FILE_ALIGNMENT - 1);
+        }
+
+        bool validFormat(const BlockFormat format) {
+            switch (format) {
+            case BlockFormat::BC1:
+            case BlockFormat::BC3:
+            case BlockFormat::BC4:
+            case BlockFormat::BC5:
+            case BlockFormat::BC7:
+                return true;
+            }
+            return false;
+        }
+    } // namespace
+
+    TextureFile::TextureFile(const std::span<const std::byte> data) : m_Data(data) {
+        if (!matches(data) || data.size() < sizeof(TextureFileHeader)) {
+            throw std::invalid_argument("TextureFile::TextureFile(): Not a texture file");
+        }
+        if (reinterpret_cast<uintptr_t>(data.data()) % alignof(TextureFileLevel) != 0) {
+            throw std::invalid_argument("TextureFile::TextureFile(): Texture data is misaligned");
+        }
+
+        m_Header = reinterpret_cast<const TextureFileHeader *>(data.data());
+        if (m_Header->version != TEXTURE_VERSION) {
+            throw std::invalid_argument("TextureFile::TextureFile(): Unsupported texture file version");
+        }
+        if (!validFormat(m_Header->format) || m_Header->width == 0 || m_Header->height == 0 || m_Header->mipLevels == 0 || m_Header->mipLevels > 32) {
+            throw std::invalid_argument("TextureFile::TextureFile(): Corrupt texture header");
+        }
+        if (data.size() < sizeof(TextureFileHeader) + sizeof(TextureFileLevel) * m_Header->mipLevels) {
+            throw std::invalid_argument("TextureFile::TextureFile(): Truncated level table");
+        }
+
+        m_Levels = {reinterpret_cast<const TextureFileLevel *>(data.data() + sizeof(TextureFileHeader)), m_Header->mipLevels};
+        for (uint32_t i = 0; i < m_Header->mipLevels; i++) {
+            const uint32_t width  = std::max(m_Header->width >> i, 1u);
+            const uint32_t height = std::max(m_Header->height >> i, 1u);
+            const auto    &level  = m_Levels[i];
+            if (level.size != blockCompressedSize(m_Header->format, width, height) || level.offset % TEXTURE_FILE_ALIGNMENT != 0 || level.offset > data.size() ||
+                level.size > data.size() - level.offset) {
+                throw std::invalid_argument("TextureFile::TextureFile(): Corrupt level table");
+            }
+        }
+    }
+
+    bool TextureFile::matches(const std::span<const std::byte> data) {
+        return data.size() >= sizeof(TEXTURE_MAGIC) && std::memcmp(data.data(), TEXTURE_MAGIC, sizeof(TEXTURE_MAGIC)) == 0;
+    }
+
+    std::vector<std::byte> TextureFile::serialize(
+        const BlockFormat format, const bool srgb, const uint32_t width, const uint32_t height, const std::vector<std::vector<std::byte>> &levels
+    ) {
+        if (levels.empty() || levels.size() > 32) {
+            throw std::invalid_argument("TextureFile::serialize(): Needs between 1 and 32 levels");
+        }
+
+        TextureFileHeader header{};
+        std::memcpy(header.magic, TEXTURE_MAGIC, sizeof(TEXTURE_MAGIC));
+        header.version   = TEXTURE_VERSION;
+        header.format    = format;
+        header.srgb      = srgb ? 1 : 0;
+        header.width     = width;
+        header.height    = height;
+        header.mipLevels = static_cast<uint32_t>(levels.size());
+
+        std::vector<TextureFileLevel> table(levels.size());
+        uint64_t                      offset = alignUp(sizeof(TextureFileHeader) + sizeof(TextureFileLevel) * levels.size());
+        for (uint32_t i = 0; i < levels.size(); i++) {
+            if (levels[i].size() != blockCompressedSize(format, std::max(width >> i, 1u), std::max(height >> i, 1u))) {
+                throw std::invalid_argument("TextureFile::serialize(): Level size does not match the format and dimensions");
+            }
+            table[i] = {offset, levels[i].size()};
+            offset   = alignUp(offset + levels[i].size());
+        }
+
+        std::vector<std::byte> file(offset);
+        std::memcpy(file.data(), &header, sizeof(header));
+        std::memcpy(file.data() + sizeof(header), table.data(), sizeof(TextureFileLevel) * table.size());
+        for (uint32_t i = 0; i < levels.size(); i++) {
+            std::ranges::copy(levels[i], file.begin() + static_cast<std::ptrdiff_t>(table[i].offset));
+        }
+        return file;
+    }
+} // namespace engine
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+    enum class BlockFormat : uint32_t {
+        BC1 = 1, // RGB, 4 bpp, alpha ignored
+        BC3 = 3, // RGBA, 8 bpp, BC1 color plus a BC4 alpha block
+        BC4 = 4, // R, 4 bpp (masks, roughness)
+        BC5 = 5, // RG, 8 bpp (tangent space normals)
+        BC7 = 7, // RGBA, 8 bpp, highest quality
+    };
+
+    // Bytes per 4x4 block.
+    constexpr uint32_t blockBytes(const BlockFormat format) {
+        return format == BlockFormat::BC1 || format == BlockFormat::BC4 ? 8 : 16;
+    }
+
+    // Size of a level, partial blocks at the edges count as whole blocks.
+    constexpr std::size_t blockCompressedSize(const BlockFormat format, const uint32_t width, const uint32_t height) {
+        return std::size_t{(width + 3) / 4} * ((height + 3) / 4) * blockBytes(format);
+    }
+
+    // Cooked texture layout (little endian):
+    //   TextureFileHeader | TextureFileLevel[mipLevels] | level data, largest first, each level starting on a TEXTURE_FILE_ALIGNMENT boundary
+    // Levels are uploaded straight from the file, the alignment covers every block size.
+    constexpr std::size_t TEXTURE_FILE_ALIGNMENT = 16;
+
+    struct TextureFileHeader {
+        char        magic[4];
+        uint32_t    version;
+        BlockFormat format;
+        uint32_t    srgb; // color channels are sRGB encoded, sampled through an sRGB view
+        uint32_t    width;
+        uint32_t    height;
+        uint32_t    mipLevels;
+        uint32_t    _padding;
+    };
+    static_assert(sizeof(TextureFileHeader) == 32);
+
+    struct TextureFileLevel {
+        uint64_t offset;
+        uint64_t size;
+    };
+    static_assert(sizeof(TextureFileLevel) == 16);
+
+    // View of a cooked texture. Levels point into the parsed bytes.
+    class TextureFile {
+      public:
+        // Throws std::invalid_argument when the data is not a valid texture file.
+        explicit TextureFile(std::span<const std::byte> data);
+
+        // Cheap check of the magic, for telling cooked textures from source images.
+        static bool matches(std::span<const std::byte> data);
+
+        // Builds a file from levels ordered largest first, used by the texture cooker. Throws std::invalid_argument for levels of the wrong size.
+        static std::vector<std::byte> serialize(BlockFormat format, bool srgb, uint32_t width, uint32_t height, const std::vector<std::vector<std::byte>> &levels);
+
+        [[nodiscard]] BlockFormat format() const { return m_Header->format; }
+        [[nodiscard]] bool        srgb() const { return m_Header->srgb != 0; }
+        [[nodiscard]] uint32_t    width() const { return m_Header->width; }
+        [[nodiscard]] uint32_t    height() const { return m_Header->height; }
+        [[nodiscard]] uint32_t    mipLevels() const { return m_Header->mipLevels; }
+
+        [[nodiscard]] const TextureFileLevel    &level(const uint32_t index) const { return m_Levels[index]; }
+        [[nodiscard]] std::span<const std::byte> levelData(const uint32_t index) const { return m_Data.subspan(m_Levels[index].offset, m_Levels[index].size); }
+        [[nodiscard]] std::span<const std::byte> data() const { return m_Data; }
+
+      private:
+        std::span<const std::byte>        m_Data;
+        const TextureFileHeader          *m_Header = nullptr;
+        std::span<const TextureFileLevel> m_Levels;
+    };
+
+} // namespace engine
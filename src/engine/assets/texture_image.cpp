@@ -0,0 +1,90 @@
+#include "texture_image.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace engine {
+    namespace {
+        const std::array<float, 256> &srgbToLinear() {
+            static const auto table = [] {
+                std::array<float, 256> values{};
+                for (int i = 0; i < 256; i++) {
+                    const float c = static_cast<float>(i) / 255.0f;
+                    values[i]     = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        std::byte linearToSrgb(const float c) {
+            const float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+            return static_cast<std::byte>(std::clamp(std::lround(s * 255.0f), 0l, 255l));
+        }
+    } // namespace
+
+    TextureImage TextureImage::decode(const std::span<const std::byte> file) {
+        int      width, height, channels;
+        stbi_uc *pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(file.data()), static_cast<int>(file.size()), &width, &height, &channels, STBI_rgb_alpha);
+        if (!pixels) {
+            throw std::runtime_error(std::string("TextureImage::decode(): ") + stbi_failure_reason());
+        }
+
+        TextureImage image;
+        image.width  = static_cast<uint32_t>(width);
+        image.height = static_cast<uint32_t>(height);
+        image.pixels.resize(std::size_t{image.width} * image.height * 4);
+        std::memcpy(image.pixels.data(), pixels, image.pixels.size());
+        stbi_image_free(pixels);
+        return image;
+    }
+
+    TextureImage TextureImage::downsampled(const bool srgb) const {
+        TextureImage next;
+        next.width  = std::max(width / 2, 1u);
+        next.height = std::max(height / 2, 1u);
+        next.pixels.resize(std::size_t{next.width} * next.height * 4);
+
+        const auto &to_linear = srgbToLinear();
+        for (uint32_t y = 0; y < next.height; y++) {
+            for (uint32_t x = 0; x < next.width; x++) {
+                // odd edges clamp, so the last row or column of a 1 texel wide image is averaged with itself
+                const uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+                const uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+                const std::array<const std::byte *, 4> sources = {
+                    &pixels[(std::size_t{y0} * width + x0) * 4], &pixels[(std::size_t{y0} * width + x1) * 4],
+                    &pixels[(std::size_t{y1} * width + x0) * 4], &pixels[(std::size_t{y1} * width + x1) * 4],
+                };
+
+                std::byte *out = &next.pixels[(std::size_t{y} * next.width + x) * 4];
+                for (int c = 0; c < 4; c++) {
+                    if (srgb && c < 3) {
+                        float sum = 0.0f;
+                        for (const auto *source : sources) {
+                            sum += to_linear[std::to_integer<uint8_t>(source[c])];
+                        }
+                        out[c] = linearToSrgb(sum * 0.25f);
+                    } else {
+                        uint32_t sum = 2;
+                        for (const auto *source : sources) {
+                            sum += std::to_integer<uint32_t>(source[c]);
+                        }
+                        out[c] = static_cast<std::byte>(sum / 4);
+                    }
+                }
+            }
+        }
+        return next;
+    }
+
+    uint32_t mipLevelCount(const uint32_t width, const uint32_t height) {
+        return std::bit_width(std::max({width, height, 1u}));
+    }
+} // namespace engine
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+    // Decoded image, tightly packed RGBA8 rows.
+    struct TextureImage {
+        uint32_t               width  = 0;
+        uint32_t               height = 0;
+        std::vector<std::byte> pixels;
+
+        // Decodes any format stb_image reads (PNG, JPEG, TGA, BMP...). Throws std::runtime_error for data it cannot decode.
+        static TextureImage decode(std::span<const std::byte> file);
+
+        // Next mip level, a 2x2 box filter. With `srgb` color channels are averaged in linear light so mips don't darken; alpha is always linear.
+        [[nodiscard]] TextureImage downsampled(bool srgb) const;
+    };
+
+    // Levels down to 1x1.
+    uint32_t mipLevelCount(uint32_t width, uint32_t height);
+
+} // namespace engine
@@ -0,0 +1,52 @@
+#include "virtual_file_system.hpp"
+
+#include <fstream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+namespace engine {
+    std::span<const std::byte> AssetData::bytes() const {
+        if (const auto *owned = std::get_if<std::vector<std::byte>>(&m_Data)) {
+            return *owned;
+        }
+        return std::get<std::span<const std::byte>>(m_Data);
+    }
+
+    void VirtualFileSystem::mountArchive(const std::filesystem::path &path) {
+        m_Mounts.push_back({std::make_unique<AssetArchive>(path), {}});
+    }
+
+    void VirtualFileSystem::mountDirectory(const std::filesystem::path &root) {
+        m_Mounts.push_back({nullptr, root});
+    }
+
+    bool VirtualFileSystem::exists(const std::string_view name) const {
+        for (const auto &[archive, root] : std::views::reverse(m_Mounts)) {
+            if (archive ? archive->contains(name) : std::filesystem::is_regular_file(root / name)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    AssetData VirtualFileSystem::load(const std::string_view name) const {
+        for (const auto &[archive, root] : std::views::reverse(m_Mounts)) {
+            if (archive) {
+                if (const ArchiveEntry *entry = archive->find(name)) {
+                    return entry->compression == AssetCompression::None ? AssetData(archive->view(*entry)) : AssetData(archive->read(*entry));
+                }
+                continue;
+            }
+
+            if (std::ifstream file(root / name, std::ios::binary | std::ios::ate); file.is_open()) {
+                std::vector<std::byte> data(static_cast<std::size_t>(file.tellg()));
+                file.seekg(0, std::ios::beg);
+                file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+                return AssetData(std::move(data));
+            }
+        }
+
+        throw std::out_of_range("VirtualFileSystem::load(): No asset named " + std::string(name));
+    }
+} // namespace engine
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "engine/assets/asset_archive.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace engine {
+
+    // Contents of a loaded asset. Uncompressed archive entries borrow the archive's mapping (no copy, no allocation),
+    // everything else owns its bytes. Borrowed data stays valid as long as the file system that loaded it.
+    class AssetData {
+      public:
+        AssetData() = default;
+        explicit AssetData(std::span<const std::byte> borrowed) : m_Data(borrowed) {}
+        explicit AssetData(std::vector<std::byte> owned) : m_Data(std::move(owned)) {}
+
+        [[nodiscard]] std::span<const std::byte> bytes() const;
+        [[nodiscard]] bool                       owned() const { return std::holds_alternative<std::vector<std::byte>>(m_Data); }
+
+        // Reinterprets the bytes, e.g. as SPIR-V words. Archive entries are ARCHIVE_ALIGNMENT aligned; trailing bytes that do not fill a T are dropped.
+        template <typename T>
+        [[nodiscard]] std::span<const T> as() const {
+            const auto data = bytes();
+            return {reinterpret_cast<const T *>(data.data()), data.size() / sizeof(T)};
+        }
+
+      private:
+        std::variant<std::span<const std::byte>, std::vector<std::byte>> m_Data;
+    };
+
+    // Resolves asset names ("assets/shaders/main.vert.spv") against mounted archives and directories. Later mounts take precedence,
+    // so a directory mounted after the cooked archive overrides it during development.
+    class VirtualFileSystem {
+      public:
+        // Throws like AssetArchive::AssetArchive.
+        void mountArchive(const std::filesystem::path &path);
+        void mountDirectory(const std::filesystem::path &root);
+
+        [[nodiscard]] bool exists(std::string_view name) const;
+
+        // Throws std::out_of_range when no mount has the asset.
+        [[nodiscard]] AssetData load(std::string_view name) const;
+
+      private:
+        struct Mount {
+            std::unique_ptr<AssetArchive> archive; // null for directories
+            std::filesystem::path         root;
+        };
+
+        std::vector<Mount> m_Mounts;
+    };
+
+} // namespace engine
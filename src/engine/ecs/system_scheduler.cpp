@@ -0,0 +1,94 @@
+#include "system_scheduler.hpp"
+
+namespace engine {
+    SystemScheduler::SystemScheduler(const std::shared_ptr<ThreadPool> &thread_pool) : m_ThreadPool(thread_pool) {}
+
+    void SystemScheduler::clear() {
+        m_Organizer.clear();
+        m_Functions.clear();
+        m_Graph.clear();
+        m_Remaining.reset();
+        m_GraphDirty = false;
+    }
+
+    void SystemScheduler::run(entt::registry &registry) {
+        if (m_GraphDirty) {
+            rebuildGraph();
+        }
+
+        if (m_Graph.empty()) {
+            return;
+        }
+
+        // storage has to exist before systems run concurrently, creating pools from several threads at once is a race.
+        for (const auto &vertex : m_Graph) {
+            vertex.prepare(registry);
+        }
+
+        for (std::size_t i = 0; i < m_Graph.size(); i++) {
+            m_Remaining[i].store(static_cast<uint32_t>(m_Graph[i].in_edges().size()), std::memory_order_relaxed);
+        }
+        m_Completed.store(0, std::memory_order_relaxed);
+        m_Error = nullptr;
+
+        for (std::size_t i = 0; i < m_Graph.size(); i++) {
+            if (m_Graph[i].in_edges().empty()) {
+                m_ThreadPool->enqueue([this, i, &registry] { execute(i, registry); });
+            }
+        }
+
+        m_ThreadPool->waitFor([this] { return m_Completed.load(std::memory_order_acquire) == m_Graph.size(); });
+
+        if (m_Error) {
+            std::rethrow_exception(m_Error);
+        }
+    }
+
+    const std::vector<entt::organizer::vertex> &SystemScheduler::graph() {
+        if (m_GraphDirty) {
+            rebuildGraph();
+        }
+        return m_Graph;
+    }
+
+    void SystemScheduler::invokeFunction(const void *payload, entt::registry &registry) {
+        (*static_cast<const SystemFunction *>(payload))(registry);
+    }
+
+    void SystemScheduler::rebuildGraph() {
+        m_Graph      = m_Organizer.graph();
+        m_Remaining  = std::make_unique<std::atomic<uint32_t>[]>(m_Graph.size());
+        m_GraphDirty = false;
+    }
+
+    void SystemScheduler::execute(std::size_t index, entt::registry &registry) {
+        constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+        // keep one newly ready successor for this thread and hand the rest to the pool, chains of dependent systems then run without a queue round trip.
+        while (index != none) {
+            const auto &vertex = m_Graph[index];
+            try {
+                vertex.callback()(vertex.data(), registry);
+            } catch (...) {
+                std::lock_guard lock(m_ErrorMutex);
+                if (!m_Error) {
+                    m_Error = std::current_exception();
+                }
+            }
+
+            std::size_t next = none;
+            for (const std::size_t child : vertex.out_edges()) {
+                if (m_Remaining[child].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    if (next == none) {
+                        next = child;
+                    } else {
+                        m_ThreadPool->enqueue([this, child, &registry] { execute(child, registry); });
+                    }
+                }
+            }
+
+            m_Completed.fetch_add(1, std::memory_order_acq_rel);
+            index = next;
+        }
+    }
+} // namespace engine
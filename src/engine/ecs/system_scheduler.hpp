@@ -0,0 +1,74 @@
+#pragma once
+
+#include "engine/thread_pool.hpp"
+
+#include <entt/entity/registry.hpp>
+#include <entt/graph/organizer.hpp>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace engine {
+
+    using SystemFunction = std::function<void(entt::registry &registry)>;
+
+    // Runs registry systems as a dependency graph on a thread pool.
+    // Systems declare the components they read and write, two systems are only ordered when one writes something the other touches (registration order breaks ties).
+    // Everything else runs concurrently. System names are stored by pointer and must outlive the scheduler (string literals are the intended use).
+    class SystemScheduler {
+      public:
+        explicit SystemScheduler(const std::shared_ptr<ThreadPool> &thread_pool);
+
+        // Access is deduced from the parameters of `Candidate`: `entt::view<entt::get_t<const A, B>>` reads A and writes B, a non-const `entt::registry &` runs exclusively.
+        // `Req` adds extra access on top of that, `const T` for reads and `T` for writes.
+        template <auto Candidate, typename... Req>
+        void add(const char *name) {
+            m_Organizer.emplace<Candidate, Req...>(name);
+            m_GraphDirty = true;
+        }
+
+        template <auto Candidate, typename... Req, typename Type>
+        void add(Type &instance, const char *name) {
+            m_Organizer.emplace<Candidate, Req...>(instance, name);
+            m_GraphDirty = true;
+        }
+
+        // Type-erased systems can't have their access deduced, so `Req` is the complete list of what the system touches.
+        template <typename... Req>
+        void add(const char *name, SystemFunction system) {
+            const auto &stored = m_Functions.emplace_back(std::make_unique<SystemFunction>(std::move(system)));
+            m_Organizer.emplace<Req...>(&SystemScheduler::invokeFunction, stored.get(), name);
+            m_GraphDirty = true;
+        }
+
+        void clear();
+
+        // Runs every system once, returning when all of them have finished. The calling thread executes systems while it waits.
+        // The first exception thrown by a system is rethrown here after the remaining systems complete.
+        void run(entt::registry &registry);
+
+        [[nodiscard]] const std::vector<entt::organizer::vertex> &graph();
+
+      private:
+        static void invokeFunction(const void *payload, entt::registry &registry);
+
+        void rebuildGraph();
+        void execute(std::size_t index, entt::registry &registry);
+
+        std::shared_ptr<ThreadPool>                  m_ThreadPool;
+        entt::organizer                              m_Organizer;
+        std::vector<std::unique_ptr<SystemFunction>> m_Functions;
+
+        std::vector<entt::organizer::vertex>     m_Graph;
+        std::unique_ptr<std::atomic<uint32_t>[]> m_Remaining;
+        std::atomic<std::size_t>                 m_Completed{0};
+        std::exception_ptr                       m_Error;
+        std::mutex                               m_ErrorMutex;
+        bool                                     m_GraphDirty = false;
+    };
+
+} // namespace engine
@@ -0,0 +1,53 @@
+#include "mesh_lod.hpp"
+
+#include "engine/geometry/mesh_simplifier.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+    namespace {
+        float meshExtent(const std::span<const uint32_t> indices, const float *positions, const std::size_t position_stride) {
+            float lo[3] = {INFINITY, INFINITY, INFINITY}, hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+            for (const uint32_t index : indices) {
+                const auto *p = reinterpret_cast<const float *>(reinterpret_cast<const std::byte *>(positions) + index * position_stride);
+                for (int c = 0; c < 3; c++) {
+                    lo[c] = std::min(lo[c], p[c]);
+                    hi[c] = std::max(hi[c], p[c]);
+                }
+            }
+            return indices.empty() ? 0.0f : std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+        }
+    } // namespace
+
+    MeshLodChain generateLodChain(
+        std::vector<uint32_t> &indices, const float *positions, const std::size_t vertex_count, const std::size_t position_stride, const MeshLodOptions &options
+    ) {
+        MeshLodChain chain;
+        chain.lods.push_back({0, static_cast<uint32_t>(indices.size()), 0.0f});
+
+        const float max_error = options.maxError * meshExtent(indices, positions, position_stride);
+        const auto  max_lods  = std::min(options.maxLods, MAX_MESH_LODS);
+
+        while (chain.lods.size() < max_lods) {
+            const MeshLod                   &previous = chain.lods.back();
+            const std::span<const uint32_t> source{indices.data() + previous.firstIndex, previous.indexCount};
+
+            const auto target = static_cast<std::size_t>(static_cast<float>(source.size() / 3) * options.reduction) * 3;
+            float      error  = 0.0f;
+            auto       lod    = simplifyMesh(source, positions, vertex_count, position_stride, target, max_error, &error);
+
+            if (lod.empty() || static_cast<float>(lod.size()) > static_cast<float>(source.size()) * options.minReduction) {
+                break;
+            }
+
+            optimizeVertexCache(lod, vertex_count);
+
+            const MeshLod next{static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(lod.size()), previous.error + error};
+            indices.insert(indices.end(), lod.begin(), lod.end());
+            chain.lods.push_back(next);
+        }
+
+        return chain;
+    }
+} // namespace engine
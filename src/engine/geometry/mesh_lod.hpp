@@ -0,0 +1,47 @@
+#pragma once
+
+#include "engine/geometry/mesh_optimizer.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+    inline constexpr uint32_t MAX_MESH_LODS = 8;
+
+    struct MeshLod {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        float    error; // object space deviation from the full detail mesh
+    };
+
+    // Levels of detail as index ranges into one index list over one shared vertex list, LOD 0 is the full detail mesh.
+    // The ranges map directly onto `GpuMesh` entries or `IndexBuffer::drawRange` calls.
+    struct MeshLodChain {
+        std::vector<MeshLod> lods;
+    };
+
+    struct MeshLodOptions {
+        uint32_t maxLods      = 4;
+        float    reduction    = 0.5f;  // triangle count of each level relative to the previous one
+        float    maxError     = 0.05f; // per level, relative to the mesh extent
+        float    minReduction = 0.85f; // stop once a level keeps more than this fraction of the previous triangles
+    };
+
+    // Simplifies each level from the previous one, cache optimises it and appends it to `indices` after the existing LOD 0 indices.
+    // Errors accumulate along the chain so they are conservative bounds against LOD 0.
+    MeshLodChain generateLodChain(std::vector<uint32_t> &indices, const float *positions, std::size_t vertex_count, std::size_t position_stride, const MeshLodOptions &options = {});
+
+    // Import time variant taking a mesh from `optimizeMesh`, `position` names the vec3 member holding the vertex position.
+    template <typename Vertex>
+    MeshLodChain generateLodChain(IndexedMesh<Vertex> &mesh, glm::vec3 Vertex::*position, const MeshLodOptions &options = {}) {
+        if (mesh.vertices.empty()) {
+            return {};
+        }
+        return generateLodChain(mesh.indices, &(mesh.vertices.front().*position)[0], mesh.vertices.size(), sizeof(Vertex), options);
+    }
+
+} // namespace engine
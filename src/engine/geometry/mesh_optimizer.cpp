@@ -0,0 +1,267 @@
+#include "mesh_optimizer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine {
+    namespace {
+        uint64_t hashBytes(const std::byte *data, const std::size_t size) {
+            // FNV-1a
+            uint64_t hash = 14695981039346656037ull;
+            for (std::size_t i = 0; i < size; i++) {
+                hash ^= static_cast<uint64_t>(data[i]);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        constexpr uint32_t FORSYTH_CACHE_SIZE          = 32;
+        constexpr float    FORSYTH_CACHE_DECAY_POWER   = 1.5f;
+        constexpr float    FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+        constexpr float    FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+        constexpr float    FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+        constexpr uint32_t FORSYTH_VALENCE_TABLE_SIZE = 64;
+
+        // std::pow dominates the optimiser without these.
+        struct ForsythScoreTables {
+            float cache[FORSYTH_CACHE_SIZE];
+            float valence[FORSYTH_VALENCE_TABLE_SIZE];
+
+            ForsythScoreTables() {
+                for (uint32_t i = 0; i < FORSYTH_CACHE_SIZE; i++) {
+                    if (i < 3) {
+                        // the last triangle's vertices get a fixed score so the next triangle doesn't just repeat the same edge.
+                        cache[i] = FORSYTH_LAST_TRIANGLE_SCORE;
+                    } else {
+                        const float scaler = 1.0f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+                        cache[i]           = std::pow(1.0f - static_cast<float>(i - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+                    }
+                }
+                for (uint32_t i = 0; i < FORSYTH_VALENCE_TABLE_SIZE; i++) {
+                    valence[i] = valenceBoost(i);
+                }
+            }
+
+            // prefer vertices with few triangles left so they get finished and stop occupying the cache.
+            static float valenceBoost(const uint32_t remaining_triangles) {
+                return remaining_triangles == 0 ? 0.0f : FORSYTH_VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining_triangles), -FORSYTH_VALENCE_BOOST_POWER);
+            }
+        };
+
+        float forsythVertexScore(const int32_t cache_position, const uint32_t remaining_triangles) {
+            static const ForsythScoreTables tables;
+
+            if (remaining_triangles == 0) {
+                return -1.0f;
+            }
+
+            const float cache_score   = cache_position >= 0 ? tables.cache[cache_position] : 0.0f;
+            const float valence_score = remaining_triangles < FORSYTH_VALENCE_TABLE_SIZE ? tables.valence[remaining_triangles]
+                                                                                         : ForsythScoreTables::valenceBoost(remaining_triangles);
+            return cache_score + valence_score;
+        }
+    } // namespace
+
+    std::size_t generateVertexRemap(
+        const std::span<uint32_t> remap, const void *vertices, const std::size_t vertex_count, const std::size_t vertex_size, const std::span<const uint32_t> indices
+    ) {
+        if (remap.size() < vertex_count) {
+            throw std::invalid_argument("generateVertexRemap(): Remap table is smaller than the vertex count");
+        }
+
+        const auto *bytes = static_cast<const std::byte *>(vertices);
+        std::ranges::fill(remap.first(vertex_count), UINT32_MAX);
+
+        // open addressing table of original vertex indices, at most half full.
+        const std::size_t     table_size = std::bit_ceil(std::max<std::size_t>(vertex_count * 2, 16));
+        std::vector<uint32_t> table(table_size, UINT32_MAX);
+
+        std::size_t unique = 0;
+        const auto  visit  = [&](const uint32_t vertex) {
+            if (remap[vertex] != UINT32_MAX) {
+                return;
+            }
+
+            const std::byte *data = bytes + vertex * vertex_size;
+            for (std::size_t slot = hashBytes(data, vertex_size) & (table_size - 1);; slot = (slot + 1) & (table_size - 1)) {
+                const uint32_t existing = table[slot];
+                if (existing == UINT32_MAX) {
+                    table[slot]   = vertex;
+                    remap[vertex] = static_cast<uint32_t>(unique++);
+                    return;
+                }
+                if (std::memcmp(bytes + existing * vertex_size, data, vertex_size) == 0) {
+                    remap[vertex] = remap[existing];
+                    return;
+                }
+            }
+        };
+
+        if (indices.empty()) {
+            for (uint32_t i = 0; i < vertex_count; i++) {
+                visit(i);
+            }
+        } else {
+            for (const uint32_t index : indices) {
+                visit(index);
+            }
+        }
+
+        return unique;
+    }
+
+    void optimizeVertexCache(const std::span<uint32_t> indices, const std::size_t vertex_count) {
+        const std::size_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0) {
+            return;
+        }
+
+        // vertex -> triangle adjacency, live triangles of vertex v are adjacency[offsets[v], offsets[v] + remaining[v]).
+        std::vector<uint32_t> remaining(vertex_count, 0);
+        for (std::size_t i = 0; i < triangle_count * 3; i++) {
+            remaining[indices[i]]++;
+        }
+
+        std::vector<uint32_t> offsets(vertex_count + 1, 0);
+        for (std::size_t v = 0; v < vertex_count; v++) {
+            offsets[v + 1] = offsets[v] + remaining[v];
+        }
+
+        std::vector<uint32_t> adjacency(triangle_count * 3);
+        {
+            std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < triangle_count * 3; i++) {
+                adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        std::vector<int32_t> cache_position(vertex_count, -1);
+        std::vector<float>   vertex_score(vertex_count);
+        for (std::size_t v = 0; v < vertex_count; v++) {
+            vertex_score[v] = forsythVertexScore(-1, remaining[v]);
+        }
+
+        const auto triangle_vertex = [&](const uint32_t triangle, const int corner) { return indices[triangle * 3 + corner]; };
+
+        std::vector<float>   triangle_score(triangle_count);
+        std::vector<uint8_t> emitted(triangle_count, 0);
+        uint32_t             best       = 0;
+        float                best_score = -1.0f;
+        for (uint32_t t = 0; t < triangle_count; t++) {
+            triangle_score[t] = vertex_score[triangle_vertex(t, 0)] + vertex_score[triangle_vertex(t, 1)] + vertex_score[triangle_vertex(t, 2)];
+            if (triangle_score[t] > best_score) {
+                best       = t;
+                best_score = triangle_score[t];
+            }
+        }
+
+        std::vector<uint32_t> output;
+        output.reserve(triangle_count * 3);
+        std::vector<uint32_t> cache, next_cache;
+        cache.reserve(FORSYTH_CACHE_SIZE + 3);
+        next_cache.reserve(FORSYTH_CACHE_SIZE + 3);
+        std::size_t fallback_cursor = 0;
+
+        // marks vertices already placed in next_cache during step n (stamp n + 1), avoids a linear search per insert.
+        std::vector<uint32_t> cache_stamp(vertex_count, 0);
+
+        for (std::size_t n = 0; n < triangle_count; n++) {
+            if (best == UINT32_MAX) {
+                // nothing in the cache touches a live triangle, continue with the next unemitted one in input order.
+                while (emitted[fallback_cursor]) {
+                    fallback_cursor++;
+                }
+                best = static_cast<uint32_t>(fallback_cursor);
+            }
+
+            emitted[best] = 1;
+            const uint32_t corners[3] = {triangle_vertex(best, 0), triangle_vertex(best, 1), triangle_vertex(best, 2)};
+
+            next_cache.clear();
+            const auto stamp = static_cast<uint32_t>(n + 1);
+            for (const uint32_t v : corners) {
+                output.push_back(v);
+
+                // drop this triangle from the vertex's live list
+                const auto begin = adjacency.begin() + offsets[v];
+                const auto end   = begin + remaining[v];
+                const auto it    = std::find(begin, end, best);
+                std::iter_swap(it, end - 1);
+                remaining[v]--;
+
+                if (cache_stamp[v] != stamp) {
+                    cache_stamp[v] = stamp;
+                    next_cache.push_back(v);
+                }
+            }
+            for (const uint32_t v : cache) {
+                if (cache_stamp[v] != stamp) {
+                    cache_stamp[v] = stamp;
+                    next_cache.push_back(v);
+                }
+            }
+
+            // rescore everything that is (or just dropped out of) the cache, then pick the best triangle touching it.
+            for (std::size_t i = 0; i < next_cache.size(); i++) {
+                const uint32_t v  = next_cache[i];
+                cache_position[v] = i < FORSYTH_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+                vertex_score[v]   = forsythVertexScore(cache_position[v], remaining[v]);
+            }
+
+            best       = UINT32_MAX;
+            best_score = -1.0f;
+            for (const uint32_t v : next_cache) {
+                for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; a++) {
+                    const uint32_t t  = adjacency[a];
+                    triangle_score[t] = vertex_score[triangle_vertex(t, 0)] + vertex_score[triangle_vertex(t, 1)] + vertex_score[triangle_vertex(t, 2)];
+                    if (triangle_score[t] > best_score) {
+                        best       = t;
+                        best_score = triangle_score[t];
+                    }
+                }
+            }
+
+            if (next_cache.size() > FORSYTH_CACHE_SIZE) {
+                next_cache.resize(FORSYTH_CACHE_SIZE);
+            }
+            std::swap(cache, next_cache);
+        }
+
+        std::ranges::copy(output, indices.begin());
+    }
+
+    std::size_t generateFetchRemap(const std::span<uint32_t> remap, const std::span<uint32_t> indices) {
+        std::ranges::fill(remap, UINT32_MAX);
+
+        uint32_t next = 0;
+        for (uint32_t &index : indices) {
+            if (remap[index] == UINT32_MAX) {
+                remap[index] = next++;
+            }
+            index = remap[index];
+        }
+        return next;
+    }
+
+    float averageCacheMissRatio(const std::span<const uint32_t> indices, const std::size_t vertex_count, const uint32_t cache_size) {
+        const std::size_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0) {
+            return 0.0f;
+        }
+
+        // FIFO cache: a vertex is a hit while fewer than `cache_size` misses happened since it was inserted.
+        std::vector<std::size_t> inserted_at(vertex_count, 0);
+        std::size_t              misses = 0;
+        for (const uint32_t index : indices) {
+            if (inserted_at[index] == 0 || misses - inserted_at[index] >= cache_size) {
+                misses++;
+                inserted_at[index] = misses;
+            }
+        }
+        return static_cast<float>(misses) / static_cast<float>(triangle_count);
+    }
+} // namespace engine
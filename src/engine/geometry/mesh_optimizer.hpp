@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace engine {
+
+    template <typename Vertex>
+    struct IndexedMesh {
+        std::vector<Vertex>   vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    // Fills `remap` (one entry per vertex) with the index each vertex gets after merging bitwise identical vertices, UINT32_MAX for vertices no index references.
+    // Empty `indices` means the vertices form an unindexed triangle list. Returns the number of unique vertices.
+    // Vertices are compared byte for byte, so padding inside the vertex type has to be zeroed for duplicates to be found.
+    std::size_t generateVertexRemap(std::span<uint32_t> remap, const void *vertices, std::size_t vertex_count, std::size_t vertex_size, std::span<const uint32_t> indices);
+
+    // Reorders triangles in place so consecutive triangles reuse recently transformed vertices (Forsyth's linear-speed vertex cache optimisation).
+    void optimizeVertexCache(std::span<uint32_t> indices, std::size_t vertex_count);
+
+    // Renumbers vertices in order of first use so vertex fetch walks memory linearly. Rewrites `indices` and fills `remap` (old -> new, UINT32_MAX when unused).
+    // Returns the number of referenced vertices.
+    std::size_t generateFetchRemap(std::span<uint32_t> remap, std::span<uint32_t> indices);
+
+    // Average number of vertex shader invocations per triangle for a FIFO post-transform cache of `cache_size` entries (0.5 is ideal for regular grids, 3 is no reuse).
+    float averageCacheMissRatio(std::span<const uint32_t> indices, std::size_t vertex_count, uint32_t cache_size = 16);
+
+    template <typename Vertex>
+    IndexedMesh<Vertex> deduplicateVertices(std::span<const Vertex> vertices, std::span<const uint32_t> indices = {}) {
+        static_assert(std::is_trivially_copyable_v<Vertex> && "Vertices are compared bytewise and must be trivially copyable");
+
+        std::vector<uint32_t> remap(vertices.size());
+        const std::size_t     unique = generateVertexRemap(remap, vertices.data(), vertices.size(), sizeof(Vertex), indices);
+
+        IndexedMesh<Vertex> mesh;
+        mesh.vertices.resize(unique);
+        for (std::size_t i = 0; i < vertices.size(); i++) {
+            if (remap[i] != UINT32_MAX) {
+                mesh.vertices[remap[i]] = vertices[i];
+            }
+        }
+
+        if (indices.empty()) {
+            mesh.indices.assign(remap.begin(), remap.end());
+        } else {
+            mesh.indices.reserve(indices.size());
+            for (const uint32_t index : indices) {
+                mesh.indices.push_back(remap[index]);
+            }
+        }
+        return mesh;
+    }
+
+    template <typename Vertex>
+    void optimizeVertexFetch(IndexedMesh<Vertex> &mesh) {
+        std::vector<uint32_t> remap(mesh.vertices.size());
+        const std::size_t     used = generateFetchRemap(remap, mesh.indices);
+
+        std::vector<Vertex> vertices(used);
+        for (std::size_t i = 0; i < mesh.vertices.size(); i++) {
+            if (remap[i] != UINT32_MAX) {
+                vertices[remap[i]] = mesh.vertices[i];
+            }
+        }
+        mesh.vertices = std::move(vertices);
+    }
+
+    // Load time pipeline: merge duplicate vertices, reorder triangles for the post-transform cache, then reorder vertices for fetch locality.
+    template <typename Vertex>
+    IndexedMesh<Vertex> optimizeMesh(std::span<const Vertex> vertices, std::span<const uint32_t> indices = {}) {
+        IndexedMesh<Vertex> mesh = deduplicateVertices(vertices, indices);
+        optimizeVertexCache(mesh.indices, mesh.vertices.size());
+        optimizeVertexFetch(mesh);
+        return mesh;
+    }
+
+} // namespace engine
@@ -0,0 +1,230 @@
+#include "mesh_simplifier.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+    namespace {
+        struct Vec3 {
+            double x, y, z;
+
+            Vec3 operator-(const Vec3 &o) const { return {x - o.x, y - o.y, z - o.z}; }
+        };
+
+        double dot(const Vec3 &a, const Vec3 &b) {
+            return a.x * b.x + a.y * b.y + a.z * b.z;
+        }
+
+        Vec3 cross(const Vec3 &a, const Vec3 &b) {
+            return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+        }
+
+        // symmetric 4x4 error matrix, sum of squared distances to a set of planes
+        struct Quadric {
+            double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+
+            static Quadric fromPlane(const Vec3 &n, const double d) {
+                return {n.x * n.x, n.x * n.y, n.x * n.z, n.x * d, n.y * n.y, n.y * n.z, n.y * d, n.z * n.z, n.z * d, d * d};
+            }
+
+            Quadric &operator+=(const Quadric &o) {
+                a2 += o.a2, ab += o.ab, ac += o.ac, ad += o.ad, b2 += o.b2, bc += o.bc, bd += o.bd, c2 += o.c2, cd += o.cd, d2 += o.d2;
+                return *this;
+            }
+
+            [[nodiscard]] double evaluate(const Vec3 &p) const {
+                const double e = a2 * p.x * p.x + b2 * p.y * p.y + c2 * p.z * p.z + 2.0 * (ab * p.x * p.y + ac * p.x * p.z + bc * p.y * p.z) +
+                                 2.0 * (ad * p.x + bd * p.y + cd * p.z) + d2;
+                return std::max(e, 0.0);
+            }
+        };
+
+        struct Collapse {
+            uint32_t from;
+            uint32_t to;
+            double   cost;
+        };
+    } // namespace
+
+    std::vector<uint32_t> simplifyMesh(
+        const std::span<const uint32_t> indices, const float *positions, const std::size_t vertex_count, const std::size_t position_stride,
+        const std::size_t target_index_count, const float max_error, float *result_error
+    ) {
+        std::vector<uint32_t> result(indices.begin(), indices.end());
+        result.resize(result.size() / 3 * 3);
+
+        const auto position = [&](const uint32_t v) {
+            const auto *p = reinterpret_cast<const float *>(reinterpret_cast<const std::byte *>(positions) + v * position_stride);
+            return Vec3{p[0], p[1], p[2]};
+        };
+
+        std::vector<Quadric> quadrics(vertex_count);
+        for (std::size_t i = 0; i < result.size(); i += 3) {
+            const Vec3   p0 = position(result[i]), p1 = position(result[i + 1]), p2 = position(result[i + 2]);
+            Vec3         n  = cross(p1 - p0, p2 - p0);
+            const double l  = std::sqrt(dot(n, n));
+            if (l <= 0.0) {
+                continue;
+            }
+            n                = {n.x / l, n.y / l, n.z / l};
+            const Quadric q  = Quadric::fromPlane(n, -dot(n, p0));
+            quadrics[result[i]] += q;
+            quadrics[result[i + 1]] += q;
+            quadrics[result[i + 2]] += q;
+        }
+
+        // edges used by exactly two triangles are interior, anything else (open borders, seams, non-manifold fans) locks both endpoints.
+        std::vector<uint8_t>  locked(vertex_count, 0);
+        std::vector<uint64_t> edges;
+        {
+            edges.reserve(result.size());
+            for (std::size_t i = 0; i < result.size(); i += 3) {
+                for (int e = 0; e < 3; e++) {
+                    const uint32_t a = result[i + e], b = result[i + (e + 1) % 3];
+                    edges.push_back(static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b));
+                }
+            }
+            std::ranges::sort(edges);
+
+            std::size_t unique = 0;
+            for (std::size_t i = 0; i < edges.size();) {
+                std::size_t j = i;
+                while (j < edges.size() && edges[j] == edges[i]) {
+                    j++;
+                }
+                if (j - i != 2) {
+                    locked[edges[i] >> 32]        = 1;
+                    locked[edges[i] & 0xFFFFFFFF] = 1;
+                }
+                edges[unique++] = edges[i];
+                i               = j;
+            }
+            edges.resize(unique);
+        }
+
+        const double max_cost      = static_cast<double>(max_error) * max_error;
+        double       achieved_cost = 0.0;
+
+        std::vector<uint32_t> offsets(vertex_count + 1), adjacency, remap(vertex_count);
+        std::vector<uint8_t>  touched(vertex_count);
+        std::vector<Collapse> collapses;
+
+        while (result.size() > target_index_count) {
+            // vertex -> triangle adjacency of the current index list
+            std::ranges::fill(offsets, 0);
+            for (const uint32_t v : result) {
+                offsets[v + 1]++;
+            }
+            for (std::size_t v = 0; v < vertex_count; v++) {
+                offsets[v + 1] += offsets[v];
+            }
+            adjacency.resize(result.size());
+            {
+                std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+                for (std::size_t i = 0; i < result.size(); i++) {
+                    adjacency[cursor[result[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+
+            // cheapest direction for every live edge
+            collapses.clear();
+            for (const uint64_t edge : edges) {
+                const auto a = static_cast<uint32_t>(edge >> 32), b = static_cast<uint32_t>(edge & 0xFFFFFFFF);
+                if (locked[a] && locked[b]) {
+                    continue;
+                }
+
+                Quadric q = quadrics[a];
+                q += quadrics[b];
+                const double cost_ab = locked[a] ? INFINITY : q.evaluate(position(b));
+                const double cost_ba = locked[b] ? INFINITY : q.evaluate(position(a));
+                collapses.push_back(cost_ab <= cost_ba ? Collapse{a, b, cost_ab} : Collapse{b, a, cost_ba});
+            }
+            std::ranges::sort(collapses, {}, &Collapse::cost);
+
+            for (uint32_t v = 0; v < vertex_count; v++) {
+                remap[v] = v;
+            }
+            std::ranges::fill(touched, 0);
+
+            const std::size_t triangles_to_remove = (result.size() - target_index_count) / 3;
+            std::size_t       triangles_removed   = 0;
+
+            for (const auto &[from, to, cost] : collapses) {
+                if (cost > max_cost || triangles_removed >= std::max<std::size_t>(triangles_to_remove, 1)) {
+                    break;
+                }
+                if (touched[from] || touched[to]) {
+                    continue;
+                }
+
+                // reject collapses that flip a remaining triangle around `from`
+                bool        flips   = false;
+                std::size_t removes = 0;
+                for (uint32_t a = offsets[from]; a < offsets[from + 1] && !flips; a++) {
+                    const uint32_t *tri = &result[adjacency[a] * 3];
+                    if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                        removes++;
+                        continue;
+                    }
+
+                    Vec3 p[3], q[3];
+                    for (int c = 0; c < 3; c++) {
+                        p[c] = position(tri[c]);
+                        q[c] = tri[c] == from ? position(to) : p[c];
+                    }
+                    const Vec3 n0 = cross(p[1] - p[0], p[2] - p[0]);
+                    const Vec3 n1 = cross(q[1] - q[0], q[2] - q[0]);
+                    flips         = dot(n0, n1) <= 0.0;
+                }
+                if (flips) {
+                    continue;
+                }
+
+                remap[from] = to;
+                quadrics[to] += quadrics[from];
+                achieved_cost = std::max(achieved_cost, cost);
+                triangles_removed += removes;
+
+                // neighbours of `from` saw its old position in their flip checks, keep them out of this pass.
+                for (uint32_t a = offsets[from]; a < offsets[from + 1]; a++) {
+                    const uint32_t *tri = &result[adjacency[a] * 3];
+                    touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+                }
+            }
+
+            if (triangles_removed == 0) {
+                break;
+            }
+
+            // apply the collapses and drop degenerate triangles
+            std::size_t write = 0;
+            for (std::size_t i = 0; i < result.size(); i += 3) {
+                const uint32_t a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+                if (a != b && b != c && a != c) {
+                    result[write++] = a;
+                    result[write++] = b;
+                    result[write++] = c;
+                }
+            }
+            result.resize(write);
+
+            // remap the edge list as well, collapsed edges become self loops and duplicates merge
+            std::size_t unique = 0;
+            for (const uint64_t edge : edges) {
+                const uint32_t a = remap[edge >> 32], b = remap[edge & 0xFFFFFFFF];
+                if (a != b) {
+                    edges[unique++] = static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b);
+                }
+            }
+            edges.resize(unique);
+            std::ranges::sort(edges);
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        }
+
+        if (result_error) {
+            *result_error = static_cast<float>(std::sqrt(achieved_cost));
+        }
+        return result;
+    }
+} // namespace engine
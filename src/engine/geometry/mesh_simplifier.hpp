@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+    // Quadric error edge collapse simplification. Produces a new index list over the same vertices (vertices only collapse onto existing ones),
+    // so every level of detail can share the original vertex buffer.
+    // Vertices on open edges are locked, which includes attribute seams since those are split vertices in an indexed mesh; borders and seams never crack.
+    // Stops at `target_index_count` or when the next collapse would exceed `max_error` (object space distance). The achieved error is written to `result_error`.
+    std::vector<uint32_t> simplifyMesh(
+        std::span<const uint32_t> indices, const float *positions, std::size_t vertex_count, std::size_t position_stride, std::size_t target_index_count, float max_error,
+        float *result_error = nullptr
+    );
+
+} // namespace engine
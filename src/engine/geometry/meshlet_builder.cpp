@@ -0,0 +1,177 @@
+#include "meshlet_builder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace engine {
+    namespace {
+        // below this the normals of a cluster spread too far for the cone to ever reject it
+        constexpr float MIN_CONE_DOT = 0.1f;
+
+        template <typename Position>
+        Meshlet computeBounds(const std::span<const uint32_t> indices, const Position &position) {
+            glm::vec3 lo(INFINITY), hi(-INFINITY);
+            for (const uint32_t index : indices) {
+                lo = glm::min(lo, position(index));
+                hi = glm::max(hi, position(index));
+            }
+
+            const glm::vec3 center = (lo + hi) * 0.5f;
+            float           radius = 0.0f;
+            for (const uint32_t index : indices) {
+                radius = std::max(radius, glm::length(position(index) - center));
+            }
+
+            std::vector<glm::vec3> normals;
+            normals.reserve(indices.size() / 3);
+            glm::vec3 axis(0.0f);
+            for (std::size_t i = 0; i < indices.size(); i += 3) {
+                const glm::vec3 p0 = position(indices[i]), p1 = position(indices[i + 1]), p2 = position(indices[i + 2]);
+                const glm::vec3 n  = glm::cross(p1 - p0, p2 - p0);
+                const float     l  = glm::length(n);
+                if (l > 0.0f) {
+                    normals.push_back(n / l);
+                    axis += n / l;
+                }
+            }
+
+            glm::vec4 cone(0.0f, 0.0f, 0.0f, 1.0f);
+            if (const float l = glm::length(axis); l > 0.0f) {
+                axis /= l;
+
+                float min_dot = 1.0f;
+                for (const auto &n : normals) {
+                    min_dot = std::min(min_dot, glm::dot(n, axis));
+                }
+                if (min_dot >= MIN_CONE_DOT) {
+                    cone = glm::vec4(axis, std::sqrt(1.0f - min_dot * min_dot));
+                }
+            }
+
+            return Meshlet{
+                .boundingSphere = glm::vec4(center, radius),
+                .cone           = cone,
+                .firstIndex     = 0,
+                .indexCount     = static_cast<uint32_t>(indices.size()),
+                .vertexOffset   = 0,
+                ._padding       = 0,
+            };
+        }
+    } // namespace
+
+    std::vector<Meshlet> buildMeshlets(
+        const std::span<uint32_t> indices, const float *positions, const std::size_t vertex_count, const std::size_t position_stride, const uint32_t max_vertices,
+        const uint32_t max_triangles
+    ) {
+        if (max_vertices < 3 || max_triangles < 1) {
+            throw std::invalid_argument("buildMeshlets(): A meshlet needs room for at least one triangle");
+        }
+
+        const auto position = [&](const uint32_t v) {
+            const auto *p = reinterpret_cast<const float *>(reinterpret_cast<const std::byte *>(positions) + v * position_stride);
+            return glm::vec3(p[0], p[1], p[2]);
+        };
+
+        const std::size_t triangle_count = indices.size() / 3;
+
+        // vertex -> triangle adjacency
+        std::vector<uint32_t> offsets(vertex_count + 1, 0), adjacency(triangle_count * 3);
+        for (std::size_t i = 0; i < triangle_count * 3; i++) {
+            offsets[indices[i] + 1]++;
+        }
+        for (std::size_t v = 0; v < vertex_count; v++) {
+            offsets[v + 1] += offsets[v];
+        }
+        {
+            std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < triangle_count * 3; i++) {
+                adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        std::vector<glm::vec3> centroids(triangle_count);
+        for (std::size_t t = 0; t < triangle_count; t++) {
+            centroids[t] = (position(indices[t * 3]) + position(indices[t * 3 + 1]) + position(indices[t * 3 + 2])) / 3.0f;
+        }
+
+        std::vector<uint8_t>  emitted(triangle_count, 0);
+        std::vector<uint32_t> vertex_stamp(vertex_count, UINT32_MAX); // meshlet the vertex was last added to
+        std::vector<uint32_t> meshlet_vertices, ordered;
+        ordered.reserve(triangle_count * 3);
+
+        std::vector<Meshlet> meshlets;
+        std::size_t          seed = 0;
+
+        while (true) {
+            while (seed < triangle_count && emitted[seed]) {
+                seed++;
+            }
+            if (seed == triangle_count) {
+                break;
+            }
+
+            const auto  stamp       = static_cast<uint32_t>(meshlets.size());
+            const auto  first_index = static_cast<uint32_t>(ordered.size());
+            uint32_t    triangles   = 0;
+            glm::vec3   centroid_sum(0.0f);
+            std::size_t next = seed;
+            meshlet_vertices.clear();
+
+            while (next != SIZE_MAX) {
+                emitted[next] = 1;
+                triangles++;
+                centroid_sum += centroids[next];
+                for (int c = 0; c < 3; c++) {
+                    const uint32_t v = indices[next * 3 + c];
+                    ordered.push_back(v);
+                    if (vertex_stamp[v] != stamp) {
+                        vertex_stamp[v] = stamp;
+                        meshlet_vertices.push_back(v);
+                    }
+                }
+
+                if (triangles == max_triangles) {
+                    break;
+                }
+
+                // grow across shared vertices: fewest new vertices first, then closest to the cluster centroid
+                const glm::vec3 centroid = centroid_sum / static_cast<float>(triangles);
+                next                     = SIZE_MAX;
+                uint32_t best_new        = UINT32_MAX;
+                float    best_distance   = INFINITY;
+                for (const uint32_t v : meshlet_vertices) {
+                    for (uint32_t a = offsets[v]; a < offsets[v + 1]; a++) {
+                        const uint32_t t = adjacency[a];
+                        if (emitted[t]) {
+                            continue;
+                        }
+
+                        uint32_t new_vertices = 0;
+                        for (int c = 0; c < 3; c++) {
+                            new_vertices += vertex_stamp[indices[t * 3 + c]] != stamp;
+                        }
+                        if (meshlet_vertices.size() + new_vertices > max_vertices || new_vertices > best_new) {
+                            continue;
+                        }
+
+                        const glm::vec3 d        = centroids[t] - centroid;
+                        const float     distance = glm::dot(d, d);
+                        if (new_vertices < best_new || distance < best_distance) {
+                            next          = t;
+                            best_new      = new_vertices;
+                            best_distance = distance;
+                        }
+                    }
+                }
+            }
+
+            Meshlet meshlet    = computeBounds({ordered.data() + first_index, ordered.size() - first_index}, position);
+            meshlet.firstIndex = first_index;
+            meshlets.push_back(meshlet);
+        }
+
+        std::ranges::copy(ordered, indices.begin());
+        return meshlets;
+    }
+} // namespace engine
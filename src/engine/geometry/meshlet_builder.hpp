@@ -0,0 +1,44 @@
+#pragma once
+
+#include "engine/geometry/mesh_optimizer.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+    inline constexpr uint32_t MESHLET_MAX_VERTICES  = 64;
+    inline constexpr uint32_t MESHLET_MAX_TRIANGLES = 124;
+
+    // A cluster of triangles stored as a contiguous index range. Layout mirrors the std430 struct in `assets/shaders/cluster_cull.comp`.
+    struct Meshlet {
+        glm::vec4 boundingSphere; // object space center + radius
+        glm::vec4 cone;           // normal cone axis + cutoff, the cluster faces away from any viewer with dot(center - eye, axis) >= cutoff * |center - eye| + radius
+        uint32_t  firstIndex;
+        uint32_t  indexCount;
+        int32_t   vertexOffset;
+        uint32_t  _padding;
+    };
+    static_assert(sizeof(Meshlet) == 48);
+
+    // Splits an indexed triangle list into clusters of at most `max_vertices` unique vertices and `max_triangles` triangles.
+    // Triangles are grown greedily across shared vertices so clusters stay spatially compact, and `indices` is reordered in place
+    // so that every meshlet is one contiguous range (`firstIndex` is relative to the start of `indices`).
+    // Front faces are counter-clockwise in object space, the cone of a cluster whose normals spread past 90 degrees never culls.
+    std::vector<Meshlet> buildMeshlets(
+        std::span<uint32_t> indices, const float *positions, std::size_t vertex_count, std::size_t position_stride, uint32_t max_vertices = MESHLET_MAX_VERTICES,
+        uint32_t max_triangles = MESHLET_MAX_TRIANGLES
+    );
+
+    template <typename Vertex>
+    std::vector<Meshlet> buildMeshlets(IndexedMesh<Vertex> &mesh, glm::vec3 Vertex::*position) {
+        if (mesh.vertices.empty()) {
+            return {};
+        }
+        return buildMeshlets(mesh.indices, &(mesh.vertices.front().*position)[0], mesh.vertices.size(), sizeof(Vertex));
+    }
+
+} // namespace engine
@@ -0,0 +1,194 @@
+#include "vertex_packing.hpp"
+
+#include "engine/simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace engine {
+    namespace {
+        void checkSizes(const std::size_t in, const std::size_t out, const char *function) {
+            if (in != out) {
+                throw std::invalid_argument(std::string(function) + ": Output must hold as many elements as the input");
+            }
+        }
+
+#if defined(ENGINE_SIMD_X86)
+        ENGINE_TARGET_AVX2 std::size_t packHalfF16c(const float *in, uint16_t *out, const std::size_t count) {
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), h);
+            }
+            return i;
+        }
+
+        std::size_t packSnorm16Sse(const float *in, int16_t *out, const std::size_t count) {
+            const __m128 lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(1.0f), scale = _mm_set1_ps(32767.0f);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                // cvtps rounds to nearest even under the default MXCSR rounding mode, same as std::nearbyint in the scalar path
+                const __m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), lo), hi), scale));
+                const __m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4), lo), hi), scale));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packs_epi32(a, b));
+            }
+            return i;
+        }
+
+        std::size_t packUnorm8Sse(const float *in, uint8_t *out, const std::size_t count) {
+            const __m128 lo = _mm_setzero_ps(), hi = _mm_set1_ps(1.0f), scale = _mm_set1_ps(255.0f);
+            const auto   convert = [&](const float *p) { return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(p), lo), hi), scale)); };
+
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const __m128i ab = _mm_packs_epi32(convert(in + i), convert(in + i + 4));
+                const __m128i cd = _mm_packs_epi32(convert(in + i + 8), convert(in + i + 12));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(ab, cd));
+            }
+            return i;
+        }
+#endif
+    } // namespace
+
+    uint16_t packHalf(const float value) {
+        constexpr uint32_t f32_infinity = 255u << 23;
+        constexpr uint32_t f16_max      = (127u + 16u) << 23;
+        constexpr uint32_t denorm_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+        uint32_t       f    = std::bit_cast<uint32_t>(value);
+        const uint32_t sign = f & 0x80000000u;
+        f ^= sign;
+
+        uint32_t h;
+        if (f >= f16_max) {
+            h = f > f32_infinity ? 0x7E00 : 0x7C00;
+        } else if (f < 113u << 23) {
+            // denormal result: let the float adder do the rounding by aligning the mantissa against a magic constant
+            h = std::bit_cast<uint32_t>(std::bit_cast<float>(f) + std::bit_cast<float>(denorm_magic)) - denorm_magic;
+        } else {
+            const uint32_t mantissa_odd = f >> 13 & 1;
+            f += ((15u - 127u) << 23) + 0xFFF;
+            f += mantissa_odd;
+            h = f >> 13;
+        }
+        return static_cast<uint16_t>(h | sign >> 16);
+    }
+
+    float unpackHalf(const uint16_t value) {
+        constexpr uint32_t shifted_exponent = 0x7C00u << 13;
+
+        uint32_t       f        = (value & 0x7FFFu) << 13;
+        const uint32_t exponent = f & shifted_exponent;
+        f += (127u - 15u) << 23;
+
+        if (exponent == shifted_exponent) {
+            f += (128u - 16u) << 23; // infinity / NaN
+        } else if (exponent == 0) {
+            f += 1u << 23; // denormal, renormalise
+            f = std::bit_cast<uint32_t>(std::bit_cast<float>(f) - std::bit_cast<float>(113u << 23));
+        }
+        return std::bit_cast<float>(f | (value & 0x8000u) << 16);
+    }
+
+    int16_t packSnorm16(const float value) {
+        return static_cast<int16_t>(std::nearbyint(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    uint8_t packUnorm8(const float value) {
+        return static_cast<uint8_t>(std::nearbyint(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    }
+
+    Half2 packHalf2(const glm::vec2 &value) {
+        return {packHalf(value.x), packHalf(value.y)};
+    }
+
+    Half4 packHalf4(const glm::vec4 &value) {
+        return {packHalf(value.x), packHalf(value.y), packHalf(value.z), packHalf(value.w)};
+    }
+
+    Snorm16x4 packSnorm16x4(const glm::vec4 &value) {
+        return {packSnorm16(value.x), packSnorm16(value.y), packSnorm16(value.z), packSnorm16(value.w)};
+    }
+
+    Unorm8x4 packUnorm8x4(const glm::vec4 &value) {
+        return {packUnorm8(value.x), packUnorm8(value.y), packUnorm8(value.z), packUnorm8(value.w)};
+    }
+
+    Octahedral16 packOctahedral(const glm::vec3 &normal) {
+        // project onto the octahedron |x| + |y| + |z| = 1, then fold the lower hemisphere over the diagonals
+        const float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        if (l1 == 0.0f) {
+            return {0, 0};
+        }
+
+        float x = normal.x / l1, y = normal.y / l1;
+        if (normal.z < 0.0f) {
+            const float fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            const float fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+            x              = fx;
+            y              = fy;
+        }
+        return {packSnorm16(x), packSnorm16(y)};
+    }
+
+    glm::vec3 unpackOctahedral(const Octahedral16 &value) {
+        const float x = std::max(static_cast<float>(value.x) / 32767.0f, -1.0f);
+        const float y = std::max(static_cast<float>(value.y) / 32767.0f, -1.0f);
+
+        glm::vec3   n(x, y, 1.0f - std::abs(x) - std::abs(y));
+        const float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    void packHalf(const std::span<const float> in, const std::span<uint16_t> out) {
+        checkSizes(in.size(), out.size(), "packHalf()");
+
+        std::size_t i = 0;
+#if defined(ENGINE_SIMD_X86)
+        if (simd::hasAvx2()) {
+            i = packHalfF16c(in.data(), out.data(), in.size());
+        }
+#endif
+        for (; i < in.size(); i++) {
+            out[i] = packHalf(in[i]);
+        }
+    }
+
+    void packSnorm16(const std::span<const float> in, const std::span<int16_t> out) {
+        checkSizes(in.size(), out.size(), "packSnorm16()");
+
+        std::size_t i = 0;
+#if defined(ENGINE_SIMD_X86)
+        i = packSnorm16Sse(in.data(), out.data(), in.size());
+#endif
+        for (; i < in.size(); i++) {
+            out[i] = packSnorm16(in[i]);
+        }
+    }
+
+    void packUnorm8(const std::span<const float> in, const std::span<uint8_t> out) {
+        checkSizes(in.size(), out.size(), "packUnorm8()");
+
+        std::size_t i = 0;
+#if defined(ENGINE_SIMD_X86)
+        i = packUnorm8Sse(in.data(), out.data(), in.size());
+#endif
+        for (; i < in.size(); i++) {
+            out[i] = packUnorm8(in[i]);
+        }
+    }
+
+    void packOctahedral(const std::span<const glm::vec3> in, const std::span<Octahedral16> out) {
+        checkSizes(in.size(), out.size(), "packOctahedral()");
+
+        for (std::size_t i = 0; i < in.size(); i++) {
+            out[i] = packOctahedral(in[i]);
+        }
+    }
+} // namespace engine
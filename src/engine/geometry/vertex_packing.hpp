@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+
+namespace engine {
+
+    // Packed vertex attribute types. Shaders read all of them as float vectors, the vertex format does the conversion (see `VertexFormat`).
+
+    struct Half2 {
+        uint16_t x, y;
+    };
+
+    struct Half4 {
+        uint16_t x, y, z, w;
+    };
+
+    // Signed normalized, e.g. normals and tangents with the bitangent sign in w.
+    struct Snorm16x4 {
+        int16_t x, y, z, w;
+    };
+
+    // Unit vector in octahedral encoding as two signed normalized components, decode with `unpackOctahedral` in the shader.
+    struct Octahedral16 {
+        int16_t x, y;
+    };
+
+    struct Unorm8x4 {
+        uint8_t x, y, z, w;
+    };
+
+    static_assert(sizeof(Half2) == 4 && sizeof(Half4) == 8 && sizeof(Snorm16x4) == 8 && sizeof(Octahedral16) == 4 && sizeof(Unorm8x4) == 4);
+
+    // IEEE 754 binary16 with round to nearest even, overflow goes to infinity and NaN stays NaN (matches F16C).
+    uint16_t packHalf(float value);
+    float    unpackHalf(uint16_t value);
+    int16_t  packSnorm16(float value);
+    uint8_t  packUnorm8(float value);
+
+    Half2        packHalf2(const glm::vec2 &value);
+    Half4        packHalf4(const glm::vec4 &value);
+    Snorm16x4    packSnorm16x4(const glm::vec4 &value);
+    Unorm8x4     packUnorm8x4(const glm::vec4 &value);
+    Octahedral16 packOctahedral(const glm::vec3 &normal);
+    glm::vec3    unpackOctahedral(const Octahedral16 &value);
+
+    // Bulk conversions for import time. `out` must hold as many elements as `in`. Vectorised with SSE2 (F16C for halves) when available.
+    void packHalf(std::span<const float> in, std::span<uint16_t> out);
+    void packSnorm16(std::span<const float> in, std::span<int16_t> out);
+    void packUnorm8(std::span<const float> in, std::span<uint8_t> out);
+    void packOctahedral(std::span<const glm::vec3> in, std::span<Octahedral16> out);
+
+} // namespace engine
@@ -0,0 +1,119 @@
+#include "radix_sort.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace engine {
+    namespace {
+        constexpr int         RADIX_PASSES   = 8;
+        constexpr std::size_t MIN_CHUNK_SIZE = 1 << 14;
+
+        inline uint32_t digit(const uint64_t key, const int pass) {
+            return static_cast<uint32_t>(key >> pass * 8) & 0xFF;
+        }
+    } // namespace
+
+    void radixSort(const std::span<uint64_t> keys, const std::span<uint32_t> values, RadixSortScratch &scratch, ThreadPool *pool) {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("radixSort(): Key and value counts differ");
+        }
+
+        const std::size_t count = keys.size();
+        if (count < 2) {
+            return;
+        }
+
+        scratch.keys.resize(count);
+        scratch.values.resize(count);
+
+        const bool        parallel = pool && pool->threadCount() > 0 && count >= RADIX_SORT_PARALLEL_THRESHOLD;
+        const std::size_t chunks   = parallel ? std::min<std::size_t>(pool->threadCount() + 1, count / MIN_CHUNK_SIZE) : 1;
+        const std::size_t chunk    = (count + chunks - 1) / chunks;
+
+        const auto for_each_chunk = [&](const std::function<void(std::size_t c, std::size_t begin, std::size_t end)> &f) {
+            if (chunks == 1) {
+                f(0, 0, count);
+                return;
+            }
+            pool->parallelFor(chunks, 1, [&](const std::size_t begin, const std::size_t end) {
+                for (std::size_t c = begin; c < end; c++) {
+                    f(c, c * chunk, std::min(count, (c + 1) * chunk));
+                }
+            });
+        };
+
+        // histograms of every pass from one read of the keys, per chunk: [chunk * RADIX_PASSES + pass]
+        auto &histograms = scratch.histograms;
+        histograms.assign(chunks * RADIX_PASSES, {});
+        for_each_chunk([&](const std::size_t c, const std::size_t begin, const std::size_t end) {
+            auto *h = &histograms[c * RADIX_PASSES];
+            for (std::size_t i = begin; i < end; i++) {
+                const uint64_t key = keys[i];
+                for (int pass = 0; pass < RADIX_PASSES; pass++) {
+                    h[pass][digit(key, pass)]++;
+                }
+            }
+        });
+
+        uint64_t *src_keys   = keys.data();
+        uint32_t *src_values = values.data();
+        uint64_t *dst_keys   = scratch.keys.data();
+        uint32_t *dst_values = scratch.values.data();
+        bool      moved      = false;
+
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            // skip when one bucket holds every key
+            std::array<uint32_t, 256> totals{};
+            for (std::size_t c = 0; c < chunks; c++) {
+                for (int d = 0; d < 256; d++) {
+                    totals[d] += histograms[c * RADIX_PASSES + pass][d];
+                }
+            }
+            if (totals[digit(src_keys[0], pass)] == count) {
+                continue;
+            }
+
+            // whole-array counts do not depend on the order, but per chunk counts do once a pass has moved keys between chunks
+            if (chunks > 1 && moved) {
+                for_each_chunk([&](const std::size_t c, const std::size_t begin, const std::size_t end) {
+                    auto &h = histograms[c * RADIX_PASSES + pass];
+                    h.fill(0);
+                    for (std::size_t i = begin; i < end; i++) {
+                        h[digit(src_keys[i], pass)]++;
+                    }
+                });
+            }
+
+            // exclusive offsets, digit major then chunk, which keeps the scatter stable
+            uint32_t offset = 0;
+            for (int d = 0; d < 256; d++) {
+                for (std::size_t c = 0; c < chunks; c++) {
+                    auto          &h = histograms[c * RADIX_PASSES + pass];
+                    const uint32_t n = h[d];
+                    h[d]             = offset;
+                    offset += n;
+                }
+            }
+
+            for_each_chunk([&](const std::size_t c, const std::size_t begin, const std::size_t end) {
+                auto &h = histograms[c * RADIX_PASSES + pass];
+                for (std::size_t i = begin; i < end; i++) {
+                    const uint32_t slot = h[digit(src_keys[i], pass)]++;
+                    dst_keys[slot]      = src_keys[i];
+                    dst_values[slot]    = src_values[i];
+                }
+            });
+
+            std::swap(src_keys, dst_keys);
+            std::swap(src_values, dst_values);
+            moved = true;
+        }
+
+        if (src_keys != keys.data()) {
+            std::memcpy(keys.data(), src_keys, count * sizeof(uint64_t));
+            std::memcpy(values.data(), src_values, count * sizeof(uint32_t));
+        }
+    }
+} // namespace engine
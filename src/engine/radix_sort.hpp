@@ -0,0 +1,26 @@
+#pragma once
+
+#include "engine/thread_pool.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+    inline constexpr std::size_t RADIX_SORT_PARALLEL_THRESHOLD = 1 << 16;
+
+    // Buffers reused between sorts so steady state sorting does not allocate.
+    struct RadixSortScratch {
+        std::vector<uint64_t>                  keys;
+        std::vector<uint32_t>                  values;
+        std::vector<std::array<uint32_t, 256>> histograms;
+    };
+
+    // Stable LSD radix sort of 64-bit keys carrying 32-bit values (usually indices), one byte per pass.
+    // Passes where every key has the same byte are skipped, which is most of them for packed sort keys with few distinct fields.
+    // With a pool and at least `RADIX_SORT_PARALLEL_THRESHOLD` keys, histograms and scatters run per chunk on the workers.
+    void radixSort(std::span<uint64_t> keys, std::span<uint32_t> values, RadixSortScratch &scratch, ThreadPool *pool = nullptr);
+
+} // namespace engine
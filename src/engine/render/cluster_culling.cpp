@@ -0,0 +1,83 @@
+#include "cluster_culling.hpp"
+
+#include <algorithm>
+
+namespace engine {
+    ClusterCulling::ClusterCulling(
+        const std::shared_ptr<RenderDevice> &render_device, const uint32_t max_instances, const uint32_t max_draws, const std::filesystem::path &cull_shader
+    )
+        : m_RenderDevice(render_device), m_Buffers(render_device, max_instances, max_draws) {
+        m_CullShader = std::make_unique<ComputeShader>(
+            m_RenderDevice, cull_shader, "main",
+            ShaderInputLayout{.push_constant_ranges = {vk::PushConstantRange(vk::ShaderStageFlagBits::eCompute, 0, sizeof(CullPushConstants))}}
+        );
+
+        for (auto &params : m_Params) {
+            auto [buffer, info] = m_RenderDevice->createBuffer(
+                sizeof(CullParams), vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress, MemoryUsage::AutoPreferDevice,
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+            );
+            params.buffer  = std::move(buffer);
+            params.mapped  = static_cast<CullParams *>(info.pMappedData);
+            params.address = m_RenderDevice->bufferAddress(params.buffer);
+        }
+    }
+
+    void ClusterCulling::setGeometry(const std::span<const Meshlet> meshlets, const std::span<const GpuClusterMesh> meshes) {
+        if (meshlets.empty() || meshes.empty()) {
+            throw std::invalid_argument("ClusterCulling::setGeometry(): Meshlet and mesh tables must not be empty");
+        }
+        for (const auto &mesh : meshes) {
+            if (static_cast<std::size_t>(mesh.firstMeshlet) + mesh.meshletCount > meshlets.size()) {
+                throw std::out_of_range("ClusterCulling::setGeometry(): Mesh references meshlets past the end of the meshlet table");
+            }
+        }
+
+        // the previous tables may still be read by frames in flight.
+        if (*m_Meshlets.buffer) {
+            m_RenderDevice->waitDeviceIdle();
+        }
+
+        m_Meshlets       = m_Buffers.createTable(meshlets.data(), meshlets.size_bytes());
+        m_MeshletAddress = m_RenderDevice->bufferAddress(m_Meshlets);
+        m_Meshes         = m_Buffers.createTable(meshes.data(), meshes.size_bytes());
+        m_MeshAddress    = m_RenderDevice->bufferAddress(m_Meshes);
+
+        m_MaxMeshletsPerMesh = std::ranges::max(meshes, {}, &GpuClusterMesh::meshletCount).meshletCount;
+    }
+
+    void ClusterCulling::cull(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame, const Frustum &frustum, const glm::vec3 &camera_position) {
+        m_Buffers.beginCull(cmd, current_frame);
+
+        const uint32_t instance_count = m_Buffers.instanceCount();
+        if (instance_count > 0 && *m_Meshlets.buffer) {
+            const uint32_t groups_per_instance = ComputeShader::groupCount(m_MaxMeshletsPerMesh, WORKGROUP_SIZE);
+            const uint64_t total_groups        = static_cast<uint64_t>(groups_per_instance) * instance_count;
+            const auto     group_count_x       = static_cast<uint32_t>(std::min<uint64_t>(total_groups, MAX_GROUP_COUNT_X));
+            const auto     group_count_y       = static_cast<uint32_t>((total_groups + group_count_x - 1) / group_count_x);
+
+            auto &params   = m_Params[current_frame];
+            *params.mapped = CullParams{
+                .planes            = frustum.planes,
+                .cameraPosition    = glm::vec4(camera_position, 1.0f),
+                .instanceCount     = instance_count,
+                .maxDraws          = m_Buffers.maxDraws(),
+                .groupsPerInstance = groups_per_instance,
+                .groupCountX       = group_count_x,
+            };
+            params.buffer.allocation->flush(0, sizeof(CullParams));
+
+            const CullPushConstants push_constants{
+                .params    = params.address,
+                .instances = m_Buffers.instanceAddress(current_frame),
+                .meshes    = m_MeshAddress,
+                .meshlets  = m_MeshletAddress,
+                .draws     = m_Buffers.drawAddress(current_frame),
+            };
+            m_CullShader->pushConstants(cmd, push_constants);
+            m_CullShader->dispatch(cmd, group_count_x, group_count_y);
+        }
+
+        m_Buffers.endCull(cmd);
+    }
+} // namespace engine
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "engine/geometry/meshlet_builder.hpp"
+#include "engine/render/compute_shader.hpp"
+#include "engine/render/indirect_draw_buffers.hpp"
+#include "engine/render_device.hpp"
+#include "engine/scene/frustum_culling.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <span>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Range of the meshlet table making up one mesh, mirrors `ClusterMesh` in `assets/shaders/cluster_cull.comp`.
+    struct GpuClusterMesh {
+        uint32_t firstMeshlet;
+        uint32_t meshletCount;
+    };
+    static_assert(sizeof(GpuClusterMesh) == 8);
+
+    // Cluster granularity variant of GpuCulling: a compute pass tests every meshlet of every instance against the frustum and its backface cone
+    // and appends one VkDrawIndexedIndirectCommand per surviving meshlet, consumed with drawIndexedIndirectCount. No mesh shader support is needed.
+    // Instances use the GpuInstance layout with `meshIndex` indexing the GpuClusterMesh table, and every command's firstInstance is the instance index,
+    // so `indirect.vert` works unchanged and the device must support drawIndirectFirstInstance (the constructor throws otherwise).
+    class ClusterCulling {
+      public:
+        ClusterCulling(
+            const std::shared_ptr<RenderDevice> &render_device, uint32_t max_instances, uint32_t max_draws,
+            const std::filesystem::path &cull_shader = "assets/shaders/cluster_cull.comp.spv"
+        );
+
+        // Replaces the meshlet and mesh tables (device local, uploaded through staging buffers). Meshlet index ranges refer to whatever index buffer is bound when drawing.
+        void setGeometry(std::span<const Meshlet> meshlets, std::span<const GpuClusterMesh> meshes);
+
+        void setInstanceCount(const uint32_t count) { m_Buffers.setInstanceCount(count); }
+        void setInstance(const uint32_t index, const GpuInstance &instance) { m_Buffers.setInstance(index, instance); }
+        void setInstances(const uint32_t first, const std::span<const GpuInstance> instances) { m_Buffers.setInstances(first, instances); }
+
+        [[nodiscard]] inline uint32_t instanceCount() const { return m_Buffers.instanceCount(); }
+        [[nodiscard]] inline uint32_t maxInstances() const { return m_Buffers.maxInstances(); }
+        [[nodiscard]] inline uint32_t maxDraws() const { return m_Buffers.maxDraws(); }
+
+        // Must be recorded outside of a render pass (see WindowRenderer::renderFrame's prepare callback).
+        // `camera_position` is the world space eye used by the cone test. Meshlets past `maxDraws` in a frame are dropped.
+        void cull(const vk::raii::CommandBuffer &cmd, uint32_t current_frame, const Frustum &frustum, const glm::vec3 &camera_position);
+
+        // Records the indirect draw. Shaders, vertex input state, vertex and index buffers are the caller's responsibility.
+        void draw(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame) const { m_Buffers.draw(cmd, current_frame); }
+
+        [[nodiscard]] vk::DeviceAddress instanceBufferAddress(const uint32_t current_frame) const { return m_Buffers.instanceAddress(current_frame); }
+
+      private:
+        struct CullParams {
+            std::array<glm::vec4, 6> planes;
+            glm::vec4                cameraPosition;
+            uint32_t                 instanceCount;
+            uint32_t                 maxDraws;
+            uint32_t                 groupsPerInstance;
+            uint32_t                 groupCountX;
+        };
+
+        struct FrameParams {
+            RawBuffer         buffer{nullptr};
+            CullParams       *mapped = nullptr;
+            vk::DeviceAddress address{};
+        };
+
+        // frame data lives in a mapped buffer, 6 planes plus five addresses would not fit the guaranteed 128 bytes of push constants
+        struct CullPushConstants {
+            vk::DeviceAddress params;
+            vk::DeviceAddress instances;
+            vk::DeviceAddress meshes;
+            vk::DeviceAddress meshlets;
+            vk::DeviceAddress draws;
+        };
+
+        constexpr static uint32_t WORKGROUP_SIZE    = 64;
+        constexpr static uint32_t MAX_GROUP_COUNT_X = 65535;
+
+        std::shared_ptr<RenderDevice>  m_RenderDevice;
+        std::unique_ptr<ComputeShader> m_CullShader;
+        IndirectDrawBuffers            m_Buffers;
+
+        RawBuffer         m_Meshlets{nullptr};
+        vk::DeviceAddress m_MeshletAddress{};
+        RawBuffer         m_Meshes{nullptr};
+        vk::DeviceAddress m_MeshAddress{};
+        uint32_t          m_MaxMeshletsPerMesh = 0;
+
+        std::array<FrameParams, MAX_FRAMES_IN_FLIGHT> m_Params;
+    };
+
+} // namespace engine
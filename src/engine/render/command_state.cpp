@@ -0,0 +1,270 @@
+#include "command_state.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace engine {
+    namespace {
+        uint32_t shaderStageSlot(const vk::ShaderStageFlagBits stage) {
+            switch (stage) {
+                case vk::ShaderStageFlagBits::eVertex: return 0;
+                case vk::ShaderStageFlagBits::eTessellationControl: return 1;
+                case vk::ShaderStageFlagBits::eTessellationEvaluation: return 2;
+                case vk::ShaderStageFlagBits::eGeometry: return 3;
+                case vk::ShaderStageFlagBits::eFragment: return 4;
+                case vk::ShaderStageFlagBits::eCompute: return 5;
+                case vk::ShaderStageFlagBits::eTaskEXT: return 6;
+                case vk::ShaderStageFlagBits::eMeshEXT: return 7;
+                default: throw std::invalid_argument("CommandState::bindShadersEXT(): Unsupported shader stage " + vk::to_string(stage));
+            }
+        }
+
+        template <typename T>
+        bool sameContents(const std::optional<std::vector<T>> &shadow, const vk::ArrayProxy<const T> &values) {
+            return shadow && std::ranges::equal(*shadow, values);
+        }
+
+        // per attachment state: true if every attachment in the range already holds the value
+        template <typename T, std::size_t N>
+        bool updateAttachments(std::array<std::optional<T>, N> &shadow, const uint32_t first, const vk::ArrayProxy<const T> &values) {
+            if (first + values.size() > N) {
+                // not tracked, always recorded. The tracked attachments it covers are unknown from here on
+                for (uint32_t i = first; i < N; i++) {
+                    shadow[i] = std::nullopt;
+                }
+                return false;
+            }
+
+            bool same = true;
+            for (uint32_t i = 0; i < values.size(); i++) {
+                same &= shadow[first + i] == values.data()[i];
+                shadow[first + i] = values.data()[i];
+            }
+            return same;
+        }
+    } // namespace
+
+    template <typename T>
+    bool CommandState::update(std::optional<T> &shadow, const T &value) {
+        if (shadow == value) {
+            m_Skipped++;
+            return false;
+        }
+        shadow = value;
+        m_Recorded++;
+        return true;
+    }
+
+    void CommandState::reset() {
+        m_State = {};
+    }
+
+    void CommandState::bindShadersEXT(const vk::ArrayProxy<const vk::ShaderStageFlagBits> stages, const vk::ArrayProxy<const vk::ShaderEXT> shaders) {
+        if (stages.size() != shaders.size()) {
+            throw std::invalid_argument("CommandState::bindShadersEXT(): Stage and shader counts differ");
+        }
+
+        std::array<vk::ShaderStageFlagBits, SHADER_STAGE_COUNT> changed_stages{};
+        std::array<vk::ShaderEXT, SHADER_STAGE_COUNT>           changed_shaders{};
+        uint32_t                                                changed = 0;
+        for (uint32_t i = 0; i < stages.size(); i++) {
+            auto &shadow = m_State.shaders[shaderStageSlot(stages.data()[i])];
+            if (shadow != shaders.data()[i]) {
+                shadow                   = shaders.data()[i];
+                changed_stages[changed]  = stages.data()[i];
+                changed_shaders[changed] = shaders.data()[i];
+                changed++;
+            }
+        }
+
+        if (changed == 0) {
+            m_Skipped++;
+            return;
+        }
+        m_Recorded++;
+        m_Cmd.bindShadersEXT(vk::ArrayProxy<const vk::ShaderStageFlagBits>(changed, changed_stages.data()), vk::ArrayProxy<const vk::ShaderEXT>(changed, changed_shaders.data()));
+    }
+
+    void CommandState::setVertexInputEXT(
+        const vk::ArrayProxy<const vk::VertexInputBindingDescription2EXT> bindings, const vk::ArrayProxy<const vk::VertexInputAttributeDescription2EXT> attributes
+    ) {
+        if (sameContents(m_State.vertexBindings, bindings) && sameContents(m_State.vertexAttributes, attributes)) {
+            m_Skipped++;
+            return;
+        }
+        m_State.vertexBindings.emplace(bindings.begin(), bindings.end());
+        m_State.vertexAttributes.emplace(attributes.begin(), attributes.end());
+        m_Recorded++;
+        m_Cmd.setVertexInputEXT(bindings, attributes);
+    }
+
+    void CommandState::setViewportWithCount(const vk::ArrayProxy<const vk::Viewport> viewports) {
+        if (sameContents(m_State.viewports, viewports)) {
+            m_Skipped++;
+            return;
+        }
+        m_State.viewports.emplace(viewports.begin(), viewports.end());
+        m_Recorded++;
+        m_Cmd.setViewportWithCount(viewports);
+    }
+
+    void CommandState::setScissorWithCount(const vk::ArrayProxy<const vk::Rect2D> scissors) {
+        if (sameContents(m_State.scissors, scissors)) {
+            m_Skipped++;
+            return;
+        }
+        m_State.scissors.emplace(scissors.begin(), scissors.end());
+        m_Recorded++;
+        m_Cmd.setScissorWithCount(scissors);
+    }
+
+    void CommandState::setRasterizerDiscardEnable(const vk::Bool32 enable) {
+        if (update(m_State.rasterizerDiscard, enable)) {
+            m_Cmd.setRasterizerDiscardEnable(enable);
+        }
+    }
+
+    void CommandState::setPrimitiveTopology(const vk::PrimitiveTopology topology) {
+        if (update(m_State.primitiveTopology, topology)) {
+            m_Cmd.setPrimitiveTopology(topology);
+        }
+    }
+
+    void CommandState::setPrimitiveRestartEnable(const vk::Bool32 enable) {
+        if (update(m_State.primitiveRestart, enable)) {
+            m_Cmd.setPrimitiveRestartEnable(enable);
+        }
+    }
+
+    void CommandState::setRasterizationSamplesEXT(const vk::SampleCountFlagBits samples) {
+        if (update(m_State.rasterizationSamples, samples)) {
+            m_Cmd.setRasterizationSamplesEXT(samples);
+        }
+    }
+
+    void CommandState::setSampleMaskEXT(const vk::SampleCountFlagBits samples, const vk::ArrayProxy<const vk::SampleMask> mask) {
+        SampleMask value{samples, {}};
+        std::copy_n(mask.begin(), std::min<std::size_t>(mask.size(), value.mask.size()), value.mask.begin());
+        if (update(m_State.sampleMask, value)) {
+            m_Cmd.setSampleMaskEXT(samples, mask);
+        }
+    }
+
+    void CommandState::setAlphaToCoverageEnableEXT(const vk::Bool32 enable) {
+        if (update(m_State.alphaToCoverage, enable)) {
+            m_Cmd.setAlphaToCoverageEnableEXT(enable);
+        }
+    }
+
+    void CommandState::setAlphaToOneEnableEXT(const vk::Bool32 enable) {
+        if (update(m_State.alphaToOne, enable)) {
+            m_Cmd.setAlphaToOneEnableEXT(enable);
+        }
+    }
+
+    void CommandState::setPolygonModeEXT(const vk::PolygonMode mode) {
+        if (update(m_State.polygonMode, mode)) {
+            m_Cmd.setPolygonModeEXT(mode);
+        }
+    }
+
+    void CommandState::setLineWidth(const float width) {
+        if (update(m_State.lineWidth, width)) {
+            m_Cmd.setLineWidth(width);
+        }
+    }
+
+    void CommandState::setCullMode(const vk::CullModeFlags mode) {
+        if (update(m_State.cullMode, mode)) {
+            m_Cmd.setCullMode(mode);
+        }
+    }
+
+    void CommandState::setFrontFace(const vk::FrontFace front_face) {
+        if (update(m_State.frontFace, front_face)) {
+            m_Cmd.setFrontFace(front_face);
+        }
+    }
+
+    void CommandState::setDepthWriteEnable(const vk::Bool32 enable) {
+        if (update(m_State.depthWrite, enable)) {
+            m_Cmd.setDepthWriteEnable(enable);
+        }
+    }
+
+    void CommandState::setDepthTestEnable(const vk::Bool32 enable) {
+        if (update(m_State.depthTest, enable)) {
+            m_Cmd.setDepthTestEnable(enable);
+        }
+    }
+
+    void CommandState::setDepthCompareOp(const vk::CompareOp op) {
+        if (update(m_State.depthCompareOp, op)) {
+            m_Cmd.setDepthCompareOp(op);
+        }
+    }
+
+    void CommandState::setDepthBoundsTestEnable(const vk::Bool32 enable) {
+        if (update(m_State.depthBoundsTest, enable)) {
+            m_Cmd.setDepthBoundsTestEnable(enable);
+        }
+    }
+
+    void CommandState::setDepthBiasEnable(const vk::Bool32 enable) {
+        if (update(m_State.depthBias, enable)) {
+            m_Cmd.setDepthBiasEnable(enable);
+        }
+    }
+
+    void CommandState::setDepthClampEnableEXT(const vk::Bool32 enable) {
+        if (update(m_State.depthClamp, enable)) {
+            m_Cmd.setDepthClampEnableEXT(enable);
+        }
+    }
+
+    void CommandState::setStencilTestEnable(const vk::Bool32 enable) {
+        if (update(m_State.stencilTest, enable)) {
+            m_Cmd.setStencilTestEnable(enable);
+        }
+    }
+
+    void CommandState::setLogicOpEnableEXT(const vk::Bool32 enable) {
+        if (update(m_State.logicOp, enable)) {
+            m_Cmd.setLogicOpEnableEXT(enable);
+        }
+    }
+
+    void CommandState::setColorBlendEnableEXT(const uint32_t first_attachment, const vk::ArrayProxy<const vk::Bool32> enables) {
+        if (updateAttachments(m_State.colorBlendEnable, first_attachment, enables)) {
+            m_Skipped++;
+            return;
+        }
+        m_Recorded++;
+        m_Cmd.setColorBlendEnableEXT(first_attachment, enables);
+    }
+
+    void CommandState::setColorWriteMaskEXT(const uint32_t first_attachment, const vk::ArrayProxy<const vk::ColorComponentFlags> masks) {
+        if (updateAttachments(m_State.colorWriteMask, first_attachment, masks)) {
+            m_Skipped++;
+            return;
+        }
+        m_Recorded++;
+        m_Cmd.setColorWriteMaskEXT(first_attachment, masks);
+    }
+
+    void CommandState::setColorBlendEquationEXT(const uint32_t first_attachment, const vk::ArrayProxy<const vk::ColorBlendEquationEXT> equations) {
+        if (updateAttachments(m_State.colorBlendEquation, first_attachment, equations)) {
+            m_Skipped++;
+            return;
+        }
+        m_Recorded++;
+        m_Cmd.setColorBlendEquationEXT(first_attachment, equations);
+    }
+
+    void CommandState::setBlendConstants(const float blend_constants[4]) {
+        if (update(m_State.blendConstants, {blend_constants[0], blend_constants[1], blend_constants[2], blend_constants[3]})) {
+            m_Cmd.setBlendConstants(blend_constants);
+        }
+    }
+} // namespace engine
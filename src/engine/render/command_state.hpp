@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Shadows the dynamic state and shader bindings of a command buffer and only records commands for values that actually change.
+    // Setters mirror the vk::raii::CommandBuffer names and signatures, so code written against either works with both (see Shader::setGenericState).
+    // Nothing is known about a fresh command buffer, so a tracker starts out invalid; use one tracker per recording and call `reset` whenever state
+    // may have been changed behind its back (commands recorded on `commandBuffer()` directly, secondary command buffers, a new rendering scope).
+    class CommandState {
+      public:
+        constexpr static uint32_t MAX_COLOR_ATTACHMENTS = 8;
+
+        explicit CommandState(const vk::raii::CommandBuffer &cmd) : m_Cmd(cmd) {}
+
+        [[nodiscard]] inline const vk::raii::CommandBuffer &commandBuffer() const { return m_Cmd; }
+
+        void reset();
+
+        // Binds only the stages whose shader differs from the one bound. Null handles unbind a stage.
+        void bindShadersEXT(vk::ArrayProxy<const vk::ShaderStageFlagBits> stages, vk::ArrayProxy<const vk::ShaderEXT> shaders);
+
+        void setVertexInputEXT(
+            vk::ArrayProxy<const vk::VertexInputBindingDescription2EXT> bindings, vk::ArrayProxy<const vk::VertexInputAttributeDescription2EXT> attributes
+        );
+        void setViewportWithCount(vk::ArrayProxy<const vk::Viewport> viewports);
+        void setScissorWithCount(vk::ArrayProxy<const vk::Rect2D> scissors);
+
+        void setRasterizerDiscardEnable(vk::Bool32 enable);
+        void setPrimitiveTopology(vk::PrimitiveTopology topology);
+        void setPrimitiveRestartEnable(vk::Bool32 enable);
+        void setRasterizationSamplesEXT(vk::SampleCountFlagBits samples);
+        void setSampleMaskEXT(vk::SampleCountFlagBits samples, vk::ArrayProxy<const vk::SampleMask> mask);
+        void setAlphaToCoverageEnableEXT(vk::Bool32 enable);
+        void setAlphaToOneEnableEXT(vk::Bool32 enable);
+        void setPolygonModeEXT(vk::PolygonMode mode);
+        void setLineWidth(float width);
+        void setCullMode(vk::CullModeFlags mode);
+        void setFrontFace(vk::FrontFace front_face);
+        void setDepthWriteEnable(vk::Bool32 enable);
+        void setDepthTestEnable(vk::Bool32 enable);
+        void setDepthCompareOp(vk::CompareOp op);
+        void setDepthBoundsTestEnable(vk::Bool32 enable);
+        void setDepthBiasEnable(vk::Bool32 enable);
+        void setDepthClampEnableEXT(vk::Bool32 enable);
+        void setStencilTestEnable(vk::Bool32 enable);
+        void setLogicOpEnableEXT(vk::Bool32 enable);
+        void setColorBlendEnableEXT(uint32_t first_attachment, vk::ArrayProxy<const vk::Bool32> enables);
+        void setColorWriteMaskEXT(uint32_t first_attachment, vk::ArrayProxy<const vk::ColorComponentFlags> masks);
+        void setColorBlendEquationEXT(uint32_t first_attachment, vk::ArrayProxy<const vk::ColorBlendEquationEXT> equations);
+        void setBlendConstants(const float blend_constants[4]);
+
+        // Commands recorded vs skipped as redundant since construction.
+        [[nodiscard]] inline uint32_t recordedCount() const { return m_Recorded; }
+        [[nodiscard]] inline uint32_t skippedCount() const { return m_Skipped; }
+
+      private:
+        constexpr static uint32_t SHADER_STAGE_COUNT = 8;
+
+        template <typename T>
+        bool update(std::optional<T> &shadow, const T &value);
+
+        struct SampleMask {
+            vk::SampleCountFlagBits       samples;
+            std::array<vk::SampleMask, 2> mask; // up to 64 samples
+
+            bool operator==(const SampleMask &) const = default;
+        };
+
+        struct State {
+            std::array<std::optional<vk::ShaderEXT>, SHADER_STAGE_COUNT> shaders;
+
+            std::optional<std::vector<vk::VertexInputBindingDescription2EXT>>   vertexBindings;
+            std::optional<std::vector<vk::VertexInputAttributeDescription2EXT>> vertexAttributes;
+            std::optional<std::vector<vk::Viewport>>                            viewports;
+            std::optional<std::vector<vk::Rect2D>>                              scissors;
+
+            std::optional<vk::Bool32>              rasterizerDiscard;
+            std::optional<vk::PrimitiveTopology>   primitiveTopology;
+            std::optional<vk::Bool32>              primitiveRestart;
+            std::optional<vk::SampleCountFlagBits> rasterizationSamples;
+            std::optional<SampleMask>              sampleMask;
+            std::optional<vk::Bool32>              alphaToCoverage;
+            std::optional<vk::Bool32>              alphaToOne;
+            std::optional<vk::PolygonMode>         polygonMode;
+            std::optional<float>                   lineWidth;
+            std::optional<vk::CullModeFlags>       cullMode;
+            std::optional<vk::FrontFace>           frontFace;
+            std::optional<vk::Bool32>              depthWrite;
+            std::optional<vk::Bool32>              depthTest;
+            std::optional<vk::CompareOp>           depthCompareOp;
+            std::optional<vk::Bool32>              depthBoundsTest;
+            std::optional<vk::Bool32>              depthBias;
+            std::optional<vk::Bool32>              depthClamp;
+            std::optional<vk::Bool32>              stencilTest;
+            std::optional<vk::Bool32>              logicOp;
+            std::optional<std::array<float, 4>>    blendConstants;
+
+            std::array<std::optional<vk::Bool32>, MAX_COLOR_ATTACHMENTS>                 colorBlendEnable;
+            std::array<std::optional<vk::ColorComponentFlags>, MAX_COLOR_ATTACHMENTS>    colorWriteMask;
+            std::array<std::optional<vk::ColorBlendEquationEXT>, MAX_COLOR_ATTACHMENTS> colorBlendEquation;
+        };
+
+        const vk::raii::CommandBuffer &m_Cmd;
+        State                          m_State;
+        uint32_t                       m_Recorded = 0;
+        uint32_t                       m_Skipped  = 0;
+    };
+
+} // namespace engine
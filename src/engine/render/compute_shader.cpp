@@ -0,0 +1,42 @@
+#include "compute_shader.hpp"
+
+#include "engine/render/layout_cache.hpp"
+
+namespace engine {
+    ComputeShader::ComputeShader(
+        const std::shared_ptr<RenderDevice> &render_device, const std::span<const uint32_t> code, const std::string &entry_point, const ShaderInputLayout &sil
+    )
+        : m_RenderDevice(render_device), m_InputLayout(sil.empty() ? m_RenderDevice->layoutCache().inputLayout(ShaderReflection::reflect(code)) : sil),
+          m_Shader(
+              m_RenderDevice->device(), vk::ShaderCreateInfoEXT(
+                                            {}, vk::ShaderStageFlagBits::eCompute, {}, vk::ShaderCodeTypeEXT::eSpirv, vk::ArrayProxyNoTemporaries<const uint32_t>(code),
+                                            entry_point.c_str(), m_InputLayout.descriptor_set_layouts, m_InputLayout.push_constant_ranges
+                                        )
+          ),
+          m_Layout(m_RenderDevice->layoutCache().pipelineLayout(m_InputLayout)) {}
+
+    ComputeShader::ComputeShader(
+        const std::shared_ptr<RenderDevice> &render_device, const std::filesystem::path &path, const std::string &entry_point, const ShaderInputLayout &sil
+    )
+        : ComputeShader(render_device, Shader::load_code(path), entry_point, sil) {}
+
+    void ComputeShader::bindTo(const vk::raii::CommandBuffer &cmd) const {
+        cmd.bindShadersEXT(vk::ShaderStageFlagBits::eCompute, *m_Shader);
+    }
+
+    void ComputeShader::bindDescriptorSets(
+        const vk::raii::CommandBuffer &cmd, const uint32_t first_set, vk::ArrayProxy<const vk::DescriptorSet> const &sets, vk::ArrayProxy<const uint32_t> const &dynamic_offsets
+    ) const {
+        cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_Layout, first_set, sets, dynamic_offsets);
+    }
+
+    void ComputeShader::dispatch(const vk::raii::CommandBuffer &cmd, const uint32_t group_count_x, const uint32_t group_count_y, const uint32_t group_count_z) const {
+        bindTo(cmd);
+        cmd.dispatch(group_count_x, group_count_y, group_count_z);
+    }
+
+    void ComputeShader::dispatchIndirect(const vk::raii::CommandBuffer &cmd, const RawBuffer &buffer, const vk::DeviceSize offset) const {
+        bindTo(cmd);
+        cmd.dispatchIndirect(*buffer.buffer, offset);
+    }
+} // namespace engine
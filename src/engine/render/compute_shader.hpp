@@ -0,0 +1,58 @@
+#pragma once
+
+#include "engine/render/shader_object.hpp"
+#include "engine/render_device.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace engine {
+
+    // Compute stage shader object. Holds a pipeline layout matching its input layout, which push constants and descriptor binds need even with shader objects.
+    // An empty input layout is reflected from the code; either way the pipeline layout comes from the device's `LayoutCache`.
+    class ComputeShader {
+      public:
+        ComputeShader(const std::shared_ptr<RenderDevice> &render_device, std::span<const uint32_t> code, const std::string &entry_point, const ShaderInputLayout &sil = {});
+        ComputeShader(const std::shared_ptr<RenderDevice> &render_device, const std::filesystem::path &path, const std::string &entry_point, const ShaderInputLayout &sil = {});
+
+        inline static std::shared_ptr<ComputeShader>
+        create_shared(const std::shared_ptr<RenderDevice> &render_device, const std::filesystem::path &path, const std::string &entry_point, const ShaderInputLayout &sil = {}) {
+            return std::make_shared<ComputeShader>(render_device, path, entry_point, sil);
+        }
+
+        [[nodiscard]] inline const vk::raii::ShaderEXT &handle() const { return m_Shader; }
+        [[nodiscard]] inline const ShaderInputLayout   &inputLayout() const { return m_InputLayout; }
+        [[nodiscard]] inline vk::PipelineLayout         layout() const { return m_Layout; }
+
+        void bindTo(const vk::raii::CommandBuffer &cmd) const;
+
+        template <typename T>
+        void pushConstants(const vk::raii::CommandBuffer &cmd, const T &data, const uint32_t offset = 0) const {
+            static_assert(std::is_standard_layout_v<T> && "Push constant data must be a standard layout type");
+            cmd.pushConstants<T>(m_Layout, vk::ShaderStageFlagBits::eCompute, offset, data);
+        }
+
+        void bindDescriptorSets(
+            const vk::raii::CommandBuffer &cmd, uint32_t first_set, vk::ArrayProxy<const vk::DescriptorSet> const &sets, vk::ArrayProxy<const uint32_t> const &dynamic_offsets = {}
+        ) const;
+
+        // Binds the shader and dispatches. Counts are in workgroups, not invocations.
+        void dispatch(const vk::raii::CommandBuffer &cmd, uint32_t group_count_x, uint32_t group_count_y = 1, uint32_t group_count_z = 1) const;
+
+        // Binds the shader and dispatches with the group counts read from a VkDispatchIndirectCommand in `buffer` (needs eIndirectBuffer usage).
+        void dispatchIndirect(const vk::raii::CommandBuffer &cmd, const RawBuffer &buffer, vk::DeviceSize offset = 0) const;
+
+        // Number of workgroups of `local_size` invocations needed to cover `invocations`.
+        static constexpr uint32_t groupCount(const uint32_t invocations, const uint32_t local_size) { return (invocations + local_size - 1) / local_size; }
+
+      private:
+        std::shared_ptr<RenderDevice> m_RenderDevice;
+        ShaderInputLayout             m_InputLayout;
+        vk::raii::ShaderEXT           m_Shader{nullptr};
+        vk::PipelineLayout            m_Layout;
+    };
+
+} // namespace engine
@@ -0,0 +1,188 @@
+#include "descriptor_allocator.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace engine {
+    namespace {
+        template <typename Handle>
+        uint64_t handleBits(const Handle handle) {
+            return std::bit_cast<uint64_t>(static_cast<typename Handle::CType>(handle));
+        }
+
+        bool isBufferDescriptor(const vk::DescriptorType type) {
+            return type == vk::DescriptorType::eUniformBuffer || type == vk::DescriptorType::eUniformBufferDynamic || type == vk::DescriptorType::eStorageBuffer ||
+                   type == vk::DescriptorType::eStorageBufferDynamic;
+        }
+    } // namespace
+
+    DescriptorWriter &DescriptorWriter::buffer(const uint32_t binding, const vk::DescriptorType type, const vk::DescriptorBufferInfo &info, const uint32_t array_element) {
+        if (!isBufferDescriptor(type)) {
+            throw std::invalid_argument("DescriptorWriter::buffer(): Descriptor type is not a buffer");
+        }
+        m_Writes.push_back(Write{binding, array_element, type, info, {}});
+        return *this;
+    }
+
+    DescriptorWriter &DescriptorWriter::image(const uint32_t binding, const vk::DescriptorType type, const vk::DescriptorImageInfo &info, const uint32_t array_element) {
+        if (isBufferDescriptor(type)) {
+            throw std::invalid_argument("DescriptorWriter::image(): Descriptor type is a buffer");
+        }
+        m_Writes.push_back(Write{binding, array_element, type, {}, info});
+        return *this;
+    }
+
+    void DescriptorWriter::write(const vk::raii::Device &device, const vk::DescriptorSet set) const {
+        std::vector<vk::WriteDescriptorSet> writes;
+        writes.reserve(m_Writes.size());
+        for (const auto &write : m_Writes) {
+            vk::WriteDescriptorSet wds{};
+            wds.dstSet          = set;
+            wds.dstBinding      = write.binding;
+            wds.dstArrayElement = write.arrayElement;
+            wds.descriptorCount = 1;
+            wds.descriptorType  = write.type;
+            if (isBufferDescriptor(write.type)) {
+                wds.pBufferInfo = &write.buffer;
+            } else {
+                wds.pImageInfo = &write.image;
+            }
+            writes.push_back(wds);
+        }
+        device.updateDescriptorSets(writes, {});
+    }
+
+    std::vector<uint64_t> DescriptorWriter::key() const {
+        std::vector<uint64_t> key;
+        key.reserve(m_Writes.size() * 4);
+        for (const auto &write : m_Writes) {
+            key.push_back(static_cast<uint64_t>(write.binding) << 32 | write.arrayElement);
+            key.push_back(static_cast<uint64_t>(write.type));
+            if (isBufferDescriptor(write.type)) {
+                key.push_back(handleBits(write.buffer.buffer));
+                key.push_back(write.buffer.offset);
+                key.push_back(write.buffer.range);
+            } else {
+                key.push_back(handleBits(write.image.sampler));
+                key.push_back(handleBits(write.image.imageView));
+                key.push_back(static_cast<uint64_t>(write.image.imageLayout));
+            }
+        }
+        return key;
+    }
+
+    std::size_t DescriptorAllocator::KeyHash::operator()(const std::vector<uint64_t> &key) const {
+        uint64_t hash = 0xcbf29ce484222325;
+        for (const uint64_t word : key) {
+            hash ^= word + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+
+    DescriptorAllocator::DescriptorAllocator(const std::shared_ptr<RenderDevice> &render_device, const DescriptorAllocatorOptions &options)
+        : m_RenderDevice(render_device), m_Options(options) {
+        if (m_Options.setsPerPool == 0 || m_Options.maxSetsPerPool < m_Options.setsPerPool || m_Options.ratios.empty()) {
+            throw std::invalid_argument("DescriptorAllocator::DescriptorAllocator(): Pools need a size and descriptor ratios");
+        }
+        for (auto &frame : m_Frames) {
+            frame.setsPerPool = m_Options.setsPerPool;
+        }
+        m_Immutable.setsPerPool = m_Options.setsPerPool;
+    }
+
+    void DescriptorAllocator::beginFrame(const uint32_t current_frame) {
+        std::scoped_lock lock(m_Mutex);
+        m_CurrentFrame = current_frame;
+
+        // resetting a pool returns all of its sets in one call, after which every pool of the chain has room again
+        PoolChain &chain = m_Frames[current_frame];
+        for (auto &pool : chain.full) {
+            chain.ready.push_back(std::move(pool));
+        }
+        chain.full.clear();
+        for (const auto &pool : chain.ready) {
+            pool.reset();
+        }
+    }
+
+    vk::DescriptorSet DescriptorAllocator::allocate(const vk::DescriptorSetLayout layout, const DescriptorWriter &writer) {
+        vk::DescriptorSet set;
+        {
+            std::scoped_lock lock(m_Mutex);
+            set = allocateFrom(m_Frames[m_CurrentFrame], layout);
+        }
+        if (!writer.empty()) {
+            writer.write(m_RenderDevice->device(), set);
+        }
+        return set;
+    }
+
+    vk::DescriptorSet DescriptorAllocator::cached(const vk::DescriptorSetLayout layout, const DescriptorWriter &writer) {
+        auto key = writer.key();
+        key.push_back(handleBits(layout));
+
+        // held while writing as well, so a set is never handed out before its contents are in place
+        std::scoped_lock lock(m_Mutex);
+        auto             it = m_Cache.find(key);
+        if (it == m_Cache.end()) {
+            const vk::DescriptorSet set = allocateFrom(m_Immutable, layout);
+            writer.write(m_RenderDevice->device(), set);
+            it = m_Cache.emplace(std::move(key), set).first;
+        }
+        return it->second;
+    }
+
+    std::size_t DescriptorAllocator::cachedSetCount() const {
+        std::scoped_lock lock(m_Mutex);
+        return m_Cache.size();
+    }
+
+    std::size_t DescriptorAllocator::poolCount() const {
+        std::scoped_lock lock(m_Mutex);
+        std::size_t count = m_Immutable.ready.size() + m_Immutable.full.size();
+        for (const auto &frame : m_Frames) {
+            count += frame.ready.size() + frame.full.size();
+        }
+        return count;
+    }
+
+    vk::DescriptorSet DescriptorAllocator::allocateFrom(PoolChain &chain, const vk::DescriptorSetLayout layout) {
+        const vk::Device device = *m_RenderDevice->device();
+
+        // pools with room first, newest to oldest, then a fresh one; a layout a fresh pool can't hold never fits
+        while (true) {
+            const bool fresh = chain.ready.empty();
+            if (fresh) {
+                addPool(chain);
+            }
+
+            const vk::DescriptorSetAllocateInfo info(*chain.ready.back(), 1, &layout);
+            vk::DescriptorSet                   set;
+            const vk::Result                    result = device.allocateDescriptorSets(&info, &set);
+            if (result == vk::Result::eSuccess) {
+                return set;
+            }
+            if (result != vk::Result::eErrorOutOfPoolMemory && result != vk::Result::eErrorFragmentedPool) {
+                throw std::runtime_error("DescriptorAllocator::allocate(): " + vk::to_string(result));
+            }
+            if (fresh) {
+                throw std::runtime_error("DescriptorAllocator::allocate(): Layout needs more descriptors than a pool holds");
+            }
+            chain.full.push_back(std::move(chain.ready.back()));
+            chain.ready.pop_back();
+        }
+    }
+
+    void DescriptorAllocator::addPool(PoolChain &chain) const {
+        std::vector<vk::DescriptorPoolSize> sizes;
+        sizes.reserve(m_Options.ratios.size());
+        for (const auto &[type, per_set] : m_Options.ratios) {
+            sizes.emplace_back(type, std::max(1u, static_cast<uint32_t>(per_set * static_cast<float>(chain.setsPerPool))));
+        }
+
+        chain.ready.emplace_back(m_RenderDevice->device(), vk::DescriptorPoolCreateInfo({}, chain.setsPerPool, sizes));
+        chain.setsPerPool = std::min(chain.setsPerPool + chain.setsPerPool / 2, m_Options.maxSetsPerPool);
+    }
+} // namespace engine
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "engine/render/frame_renderer.hpp"
+#include "engine/render_device.hpp"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Collects the contents of a descriptor set. Infos are copied, the writer can be reused for any number of sets.
+    class DescriptorWriter {
+      public:
+        DescriptorWriter &buffer(uint32_t binding, vk::DescriptorType type, const vk::DescriptorBufferInfo &info, uint32_t array_element = 0);
+        DescriptorWriter &image(uint32_t binding, vk::DescriptorType type, const vk::DescriptorImageInfo &info, uint32_t array_element = 0);
+
+        void write(const vk::raii::Device &device, vk::DescriptorSet set) const;
+
+        // Every handle, offset and layout written, in order. Equal keys write equal contents.
+        [[nodiscard]] std::vector<uint64_t> key() const;
+        [[nodiscard]] bool                  empty() const { return m_Writes.empty(); }
+
+      private:
+        struct Write {
+            uint32_t                 binding;
+            uint32_t                 arrayElement;
+            vk::DescriptorType       type;
+            vk::DescriptorBufferInfo buffer;
+            vk::DescriptorImageInfo  image;
+        };
+
+        std::vector<Write> m_Writes;
+    };
+
+    struct DescriptorPoolRatio {
+        vk::DescriptorType type;
+        float              perSet; // descriptors of the type per set in the pool
+    };
+
+    struct DescriptorAllocatorOptions {
+        uint32_t                         setsPerPool    = 64; // of the first pool, each pool after it holds 1.5 times as many up to the maximum
+        uint32_t                         maxSetsPerPool = 4096;
+        std::vector<DescriptorPoolRatio> ratios         = {
+            {vk::DescriptorType::eCombinedImageSampler, 2.0f},
+            {vk::DescriptorType::eSampledImage, 1.0f},
+            {vk::DescriptorType::eSampler, 0.5f},
+            {vk::DescriptorType::eUniformBuffer, 1.0f},
+            {vk::DescriptorType::eUniformBufferDynamic, 0.5f},
+            {vk::DescriptorType::eStorageBuffer, 1.0f},
+            {vk::DescriptorType::eStorageImage, 0.5f},
+        };
+    };
+
+    // Descriptor sets for the paths that don't go bindless. Sets are never freed one by one, which is slow in every driver: they come out of
+    // chains of pools that grow on demand (a new, larger pool whenever the current one runs out) and are returned a whole chain at a time.
+    //  - `allocate` hands out sets for the current frame, returned in bulk by `beginFrame` once the frame has retired.
+    //  - `cached` hands out immutable sets keyed by layout and contents, so identical material bindings share one set for the allocator's lifetime.
+    // Thread safe.
+    class DescriptorAllocator {
+      public:
+        explicit DescriptorAllocator(const std::shared_ptr<RenderDevice> &render_device, const DescriptorAllocatorOptions &options = {});
+
+        DescriptorAllocator(const DescriptorAllocator &)            = delete;
+        DescriptorAllocator &operator=(const DescriptorAllocator &) = delete;
+
+        // Call once per frame after the frame's fence has been waited on (`WindowRenderer::renderFrame`'s `prepare`), before allocating for it.
+        // Returns every set allocated the last time this frame index was current.
+        void beginFrame(uint32_t current_frame);
+
+        // Valid until the current frame index comes around again. Throws std::runtime_error when even a fresh pool can't hold the layout.
+        vk::DescriptorSet allocate(vk::DescriptorSetLayout layout, const DescriptorWriter &writer = {});
+
+        // The set written with exactly these contents for this layout, allocated and written on first use. The set must not be updated and the
+        // resources it references must outlive the allocator. Throws like `allocate`.
+        vk::DescriptorSet cached(vk::DescriptorSetLayout layout, const DescriptorWriter &writer);
+
+        [[nodiscard]] std::size_t cachedSetCount() const;
+        [[nodiscard]] std::size_t poolCount() const;
+
+      private:
+        // Pools sharing a lifetime, `ready` ones still have room, the last is allocated from.
+        struct PoolChain {
+            std::vector<vk::raii::DescriptorPool> ready;
+            std::vector<vk::raii::DescriptorPool> full;
+            uint32_t                              setsPerPool = 0;
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const std::vector<uint64_t> &key) const;
+        };
+
+        vk::DescriptorSet allocateFrom(PoolChain &chain, vk::DescriptorSetLayout layout);
+        void              addPool(PoolChain &chain) const;
+
+        std::shared_ptr<RenderDevice> m_RenderDevice;
+        DescriptorAllocatorOptions    m_Options;
+
+        mutable std::mutex                                                    m_Mutex;
+        std::array<PoolChain, MAX_FRAMES_IN_FLIGHT>                           m_Frames;
+        uint32_t                                                              m_CurrentFrame = 0;
+        PoolChain                                                             m_Immutable;
+        std::unordered_map<std::vector<uint64_t>, vk::DescriptorSet, KeyHash> m_Cache;
+    };
+
+} // namespace engine
@@ -0,0 +1,129 @@
+#include "draw_list.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace engine {
+    namespace {
+        constexpr uint64_t field(const uint32_t value, const uint32_t bits, const uint32_t shift) {
+            return (static_cast<uint64_t>(value) & ((uint64_t{1} << bits) - 1)) << shift;
+        }
+    } // namespace
+
+    uint64_t DrawSortKey::pack(const DrawSortOrder order) const {
+        // fields from least significant upwards
+        uint32_t shift = 0;
+        uint64_t key   = 0;
+        const auto push = [&](const uint32_t value, const uint32_t bits) {
+            key |= field(value, bits, shift);
+            shift += bits;
+        };
+
+        if (order == DrawSortOrder::StateFirst) {
+            push(depth, DEPTH_BITS);
+            push(vertexLayout, VERTEX_LAYOUT_BITS);
+            push(material, MATERIAL_BITS);
+            push(shader, SHADER_BITS);
+        } else {
+            push(vertexLayout, VERTEX_LAYOUT_BITS);
+            push(material, MATERIAL_BITS);
+            push(shader, SHADER_BITS);
+            push(depth, DEPTH_BITS);
+        }
+        push(layer, LAYER_BITS);
+        push(pass, PASS_BITS);
+        return key;
+    }
+
+    uint32_t DrawSortKey::quantizeDepth(const float view_depth, const float near, const float far, const bool back_to_front) {
+        constexpr auto max_depth = static_cast<float>((1u << DEPTH_BITS) - 1);
+
+        const float t = std::clamp((view_depth - near) / (far - near), 0.0f, 1.0f);
+        const auto  q = static_cast<uint32_t>(t * max_depth);
+        return back_to_front ? (1u << DEPTH_BITS) - 1 - q : q;
+    }
+
+    void DrawList::clear() {
+        m_Entries.clear();
+        m_PushConstants.clear();
+        m_Keys.clear();
+        m_Order.clear();
+    }
+
+    void DrawList::reserve(const std::size_t draws) {
+        m_Entries.reserve(draws);
+        m_Keys.reserve(draws);
+        m_Order.reserve(draws);
+    }
+
+    void DrawList::add(const uint64_t key, const DrawItem &item) {
+        add(key, item, nullptr, 0);
+    }
+
+    void DrawList::add(const uint64_t key, const DrawItem &item, const void *push_constants, const uint32_t size) {
+        if (!item.shader) {
+            throw std::invalid_argument("DrawList::add(): Draw has no shader");
+        }
+        if (size > 0 && !item.pushConstantLayout) {
+            throw std::invalid_argument("DrawList::add(): Draw has push constants but no push constant layout");
+        }
+
+        const auto offset = static_cast<uint32_t>(m_PushConstants.size());
+        if (size > 0) {
+            const auto *bytes = static_cast<const std::byte *>(push_constants);
+            m_PushConstants.insert(m_PushConstants.end(), bytes, bytes + size);
+        }
+
+        m_Order.push_back(static_cast<uint32_t>(m_Entries.size()));
+        m_Entries.push_back({item, offset, size});
+        m_Keys.push_back(key);
+    }
+
+    void DrawList::sort() {
+        radixSort(m_Keys, m_Order, m_SortScratch, m_Pool.get());
+    }
+
+    void DrawList::record(CommandState &state, const uint32_t current_frame) const {
+        const auto &cmd = state.commandBuffer();
+
+        const MaterialShader *bound_shader        = nullptr;
+        const VertexBuffer   *bound_vertex_buffer = nullptr;
+        const IndexBuffer    *bound_index_buffer  = nullptr;
+        bool                  vertex_input_set    = false;
+
+        for (const uint32_t index : m_Order) {
+            const auto &[item, push_offset, push_size] = m_Entries[index];
+
+            if (item.shader != bound_shader) {
+                item.shader->bindTo(state);
+                bound_shader = item.shader;
+            }
+
+            if (!vertex_input_set || item.vertexBuffer != bound_vertex_buffer) {
+                if (item.vertexBuffer) {
+                    item.vertexBuffer->bindAndSetState(state, current_frame);
+                } else {
+                    state.setVertexInputEXT({}, {});
+                }
+                bound_vertex_buffer = item.vertexBuffer;
+                vertex_input_set    = true;
+            }
+
+            if (item.indexBuffer && item.indexBuffer != bound_index_buffer) {
+                item.indexBuffer->bind(cmd);
+                bound_index_buffer = item.indexBuffer;
+            }
+
+            if (push_size > 0) {
+                cmd.pushConstants(item.pushConstantLayout, item.pushConstantStages, 0, vk::ArrayProxy<const std::byte>(push_size, m_PushConstants.data() + push_offset));
+            }
+
+            if (item.indexBuffer) {
+                IndexBuffer::drawRange(cmd, item.count, item.first, item.vertexOffset, item.instanceCount, item.firstInstance);
+            } else {
+                cmd.draw(item.count, item.instanceCount, item.first, item.firstInstance);
+            }
+        }
+    }
+} // namespace engine
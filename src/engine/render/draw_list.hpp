@@ -0,0 +1,106 @@
+#pragma once
+
+#include "engine/radix_sort.hpp"
+#include "engine/render/command_state.hpp"
+#include "engine/render/index_buffer.hpp"
+#include "engine/render/material.hpp"
+#include "engine/render/vertex_buffer.hpp"
+#include "engine/thread_pool.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    enum class DrawSortOrder {
+        StateFirst, // pass, layer, shader, material, vertex layout, depth: fewest state changes, front to back within equal state (opaque)
+        DepthFirst  // pass, layer, depth, shader, material, vertex layout: strict depth order (translucent, use back to front depth)
+    };
+
+    // Fields of a 64-bit draw sort key. Ids are small integers the caller assigns (e.g. per shader or material), values wider than their field are masked.
+    struct DrawSortKey {
+        constexpr static uint32_t PASS_BITS          = 4;
+        constexpr static uint32_t LAYER_BITS         = 8;
+        constexpr static uint32_t SHADER_BITS        = 12;
+        constexpr static uint32_t MATERIAL_BITS      = 12;
+        constexpr static uint32_t VERTEX_LAYOUT_BITS = 8;
+        constexpr static uint32_t DEPTH_BITS         = 20;
+
+        uint32_t pass         = 0;
+        uint32_t layer        = 0;
+        uint32_t shader       = 0;
+        uint32_t material     = 0;
+        uint32_t vertexLayout = 0;
+        uint32_t depth        = 0; // see `quantizeDepth`
+
+        [[nodiscard]] uint64_t pack(DrawSortOrder order = DrawSortOrder::StateFirst) const;
+
+        // Maps a view space distance in [near, far] onto DEPTH_BITS, increasing with distance or, for `back_to_front`, decreasing.
+        static uint32_t quantizeDepth(float view_depth, float near, float far, bool back_to_front = false);
+    };
+    static_assert(DrawSortKey::PASS_BITS + DrawSortKey::LAYER_BITS + DrawSortKey::SHADER_BITS + DrawSortKey::MATERIAL_BITS + DrawSortKey::VERTEX_LAYOUT_BITS + DrawSortKey::DEPTH_BITS == 64);
+
+    // Everything needed to record one draw. Referenced objects must outlive `record`.
+    struct DrawItem {
+        const MaterialShader *shader       = nullptr;
+        const VertexBuffer   *vertexBuffer = nullptr; // null for shaders pulling their own vertices, vertex input is then set empty
+        const IndexBuffer    *indexBuffer  = nullptr; // null records a non-indexed draw
+
+        uint32_t count         = 0; // vertices or indices
+        uint32_t first         = 0; // first vertex or index
+        int32_t  vertexOffset  = 0; // indexed only
+        uint32_t instanceCount = 1;
+        uint32_t firstInstance = 0;
+
+        // layout and stages for the draw's push constants, if it has any
+        vk::PipelineLayout   pushConstantLayout = nullptr;
+        vk::ShaderStageFlags pushConstantStages = {};
+    };
+
+    // Collects draws with sort keys, radix sorts them and records them in key order, so draws sharing shader and buffers end up adjacent
+    // and only the binds that actually change are recorded. Lists at or above RADIX_SORT_PARALLEL_THRESHOLD sort on the thread pool when one is given.
+    class DrawList {
+      public:
+        explicit DrawList(std::shared_ptr<ThreadPool> pool = nullptr) : m_Pool(std::move(pool)) {}
+
+        void clear();
+        void reserve(std::size_t draws);
+
+        void add(uint64_t key, const DrawItem &item);
+
+        // Adds a draw with push constants, copied into the list and pushed at offset 0 before the draw.
+        template <typename T>
+        void add(const uint64_t key, const DrawItem &item, const T &push_constants) {
+            static_assert(std::is_trivially_copyable_v<T> && "Push constants are copied bytewise and must be trivially copyable");
+            add(key, item, &push_constants, sizeof(T));
+        }
+
+        void sort();
+
+        // Records every draw in sorted order (call `sort` first). Must be recorded inside rendering, with viewport, scissor and the remaining dynamic state set.
+        void record(CommandState &state, uint32_t current_frame) const;
+
+        [[nodiscard]] inline std::size_t size() const { return m_Entries.size(); }
+
+      private:
+        struct Entry {
+            DrawItem item;
+            uint32_t pushConstantOffset;
+            uint32_t pushConstantSize;
+        };
+
+        void add(uint64_t key, const DrawItem &item, const void *push_constants, uint32_t size);
+
+        std::shared_ptr<ThreadPool> m_Pool;
+
+        std::vector<Entry>     m_Entries;
+        std::vector<std::byte> m_PushConstants;
+        std::vector<uint64_t>  m_Keys;
+        std::vector<uint32_t>  m_Order;
+        RadixSortScratch       m_SortScratch;
+    };
+
+} // namespace engine
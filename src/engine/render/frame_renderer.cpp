@@ -0,0 +1,45 @@
+#include "frame_renderer.hpp"
+
+#include "engine/render_device.hpp"
+
+namespace engine {
+    void FrameRenderer::recordFrame(
+        const vk::raii::CommandBuffer &cmd, const SwapchainFrameInfo &frame_info, const vk::ImageView view, const uint32_t current_frame, const ImageState &final_state,
+        const FrameFunction &prepare, const FrameFunction &func
+    ) {
+        cmd.reset();
+        cmd.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+
+        if (prepare) {
+            prepare(cmd, frame_info, current_frame);
+        }
+
+        imageTransition(cmd, frame_info.image, vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1),
+                        {vk::ImageLayout::eUndefined, vk::PipelineStageFlagBits2::eTopOfPipe, vk::AccessFlagBits2::eNone, 0},
+                        {vk::ImageLayout::eColorAttachmentOptimal, vk::PipelineStageFlagBits2::eColorAttachmentOutput, vk::AccessFlagBits2::eColorAttachmentWrite, 0});
+
+        vk::RenderingAttachmentInfo color_attachment = {view,
+                                                        vk::ImageLayout::eColorAttachmentOptimal,
+                                                        vk::ResolveModeFlagBits::eNone,
+                                                        nullptr,
+                                                        vk::ImageLayout::eUndefined,
+                                                        vk::AttachmentLoadOp::eClear,
+                                                        vk::AttachmentStoreOp::eStore,
+                                                        vk::ClearColorValue{1.0f, 0.0f, 0.0f, 1.0f}};
+
+        vk::RenderingInfo rendering_info{};
+        rendering_info.setRenderArea({{0, 0}, frame_info.extent});
+        rendering_info.setLayerCount(1);
+        rendering_info.setColorAttachments(color_attachment);
+
+        cmd.beginRendering(rendering_info);
+        func(cmd, frame_info, current_frame);
+        cmd.endRendering();
+
+        imageTransition(cmd, frame_info.image, vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1),
+                        {vk::ImageLayout::eColorAttachmentOptimal, vk::PipelineStageFlagBits2::eColorAttachmentOutput, vk::AccessFlagBits2::eColorAttachmentWrite, 0},
+                        final_state);
+
+        cmd.end();
+    }
+} // namespace engine
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "engine/swapchain.hpp"
+
+#include <functional>
+#include <tuple>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
+
+    using FrameFunction = std::function<void(const vk::raii::CommandBuffer &cmd, const SwapchainFrameInfo &frameInfo, uint32_t currentFrame)>;
+
+    // Records and submits frames into some color target: the swapchain (WindowRenderer) or offscreen images (HeadlessRenderer).
+    class FrameRenderer {
+      public:
+        virtual ~FrameRenderer() = default;
+
+        void renderFrame(const FrameFunction &func) { renderFrame({}, func); }
+
+        // `prepare` is recorded before rendering begins, for work that can't happen inside a render pass (compute, copies, clears).
+        virtual void renderFrame(const FrameFunction &prepare, const FrameFunction &func) = 0;
+
+        // Frames actually submitted, skipped frames (e.g. a minimized window) don't count. Anything the first `n` frames used is
+        // no longer in use once `frameCount()` reaches `n + MAX_FRAMES_IN_FLIGHT`, since submitting a frame waits on the fence of the frame
+        // MAX_FRAMES_IN_FLIGHT before it.
+        [[nodiscard]] uint64_t frameCount() const { return m_FrameCount; }
+
+      protected:
+        using ImageState = std::tuple<vk::ImageLayout, vk::PipelineStageFlagBits2, vk::AccessFlags2, uint32_t>;
+
+        // Records a whole frame into `frame_info.image` (rendered through `view`) between resetting/beginning and ending `cmd`: `prepare`,
+        // the transition to a color attachment, a cleared rendering scope around `func`, and the transition to `final_state` for whatever
+        // consumes the image next. Acquiring, submitting and presenting stay with the renderer.
+        static void recordFrame(
+            const vk::raii::CommandBuffer &cmd, const SwapchainFrameInfo &frame_info, vk::ImageView view, uint32_t current_frame, const ImageState &final_state,
+            const FrameFunction &prepare, const FrameFunction &func
+        );
+
+        uint64_t m_FrameCount = 0;
+    };
+
+} // namespace engine
@@ -0,0 +1,43 @@
+#include "gpu_culling.hpp"
+
+namespace engine {
+    GpuCulling::GpuCulling(const std::shared_ptr<RenderDevice> &render_device, const uint32_t max_instances, const std::filesystem::path &cull_shader)
+        : m_RenderDevice(render_device), m_Buffers(render_device, max_instances, max_instances) {
+        m_CullShader = std::make_unique<ComputeShader>(
+            m_RenderDevice, cull_shader, "main",
+            ShaderInputLayout{.push_constant_ranges = {vk::PushConstantRange(vk::ShaderStageFlagBits::eCompute, 0, sizeof(CullPushConstants))}}
+        );
+    }
+
+    void GpuCulling::setMeshes(const std::span<const GpuMesh> meshes) {
+        if (meshes.empty()) {
+            throw std::invalid_argument("GpuCulling::setMeshes(): Mesh table must not be empty");
+        }
+
+        // the previous table may still be read by frames in flight.
+        if (*m_Meshes.buffer) {
+            m_RenderDevice->waitDeviceIdle();
+        }
+
+        m_Meshes      = m_Buffers.createTable(meshes.data(), meshes.size_bytes());
+        m_MeshAddress = m_RenderDevice->bufferAddress(m_Meshes);
+    }
+
+    void GpuCulling::cull(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame, const Frustum &frustum) {
+        m_Buffers.beginCull(cmd, current_frame);
+
+        if (m_Buffers.instanceCount() > 0 && *m_Meshes.buffer) {
+            const CullPushConstants push_constants{
+                .planes        = frustum.planes,
+                .instances     = m_Buffers.instanceAddress(current_frame),
+                .meshes        = m_MeshAddress,
+                .draws         = m_Buffers.drawAddress(current_frame),
+                .instanceCount = m_Buffers.instanceCount(),
+            };
+            m_CullShader->pushConstants(cmd, push_constants);
+            m_CullShader->dispatch(cmd, ComputeShader::groupCount(m_Buffers.instanceCount(), WORKGROUP_SIZE));
+        }
+
+        m_Buffers.endCull(cmd);
+    }
+} // namespace engine
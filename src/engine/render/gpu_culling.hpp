@@ -0,0 +1,79 @@
+#pragma once
+
+#include "engine/render/compute_shader.hpp"
+#include "engine/render/indirect_draw_buffers.hpp"
+#include "engine/render_device.hpp"
+#include "engine/scene/frustum_culling.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <span>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Layouts below mirror the std430 structs in `assets/shaders/cull.comp` and `assets/shaders/indirect.vert`.
+
+    struct GpuMesh {
+        uint32_t  indexCount;
+        uint32_t  firstIndex;
+        int32_t   vertexOffset;
+        uint32_t  _padding;
+        glm::vec4 boundingSphere; // local space center + radius
+    };
+    static_assert(sizeof(GpuMesh) == 32);
+
+    // Push constants expected by `indirect.vert`, the instance buffer is indexed with gl_InstanceIndex.
+    struct GpuDrawPushConstants {
+        glm::mat4         viewProjection;
+        vk::DeviceAddress instances;
+    };
+
+    // GPU-driven visibility: instances live in storage buffers, a compute pass frustum culls them and appends one
+    // VkDrawIndexedIndirectCommand per visible instance, and the draw pass consumes those with drawIndexedIndirectCount.
+    // The CPU cost per frame is the upload of instances changed since the frame slot was last used, independent of how many are drawn.
+    // Buffers are accessed through buffer device addresses in push constants, so no descriptor sets are involved.
+    // Every command's firstInstance is the instance index, so the device must support drawIndirectFirstInstance (the constructor throws otherwise).
+    class GpuCulling {
+      public:
+        GpuCulling(const std::shared_ptr<RenderDevice> &render_device, uint32_t max_instances, const std::filesystem::path &cull_shader = "assets/shaders/cull.comp.spv");
+
+        // Replaces the mesh table (device local, uploaded through a staging buffer). Index ranges refer to whatever index buffer is bound when drawing.
+        void setMeshes(std::span<const GpuMesh> meshes);
+
+        void setInstanceCount(const uint32_t count) { m_Buffers.setInstanceCount(count); }
+        void setInstance(const uint32_t index, const GpuInstance &instance) { m_Buffers.setInstance(index, instance); }
+        void setInstances(const uint32_t first, const std::span<const GpuInstance> instances) { m_Buffers.setInstances(first, instances); }
+
+        [[nodiscard]] inline uint32_t instanceCount() const { return m_Buffers.instanceCount(); }
+        [[nodiscard]] inline uint32_t maxInstances() const { return m_Buffers.maxInstances(); }
+
+        // Must be recorded outside of a render pass (see WindowRenderer::renderFrame's prepare callback).
+        void cull(const vk::raii::CommandBuffer &cmd, uint32_t current_frame, const Frustum &frustum);
+
+        // Records the indirect draw. Shaders, vertex input state, vertex and index buffers are the caller's responsibility.
+        void draw(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame) const { m_Buffers.draw(cmd, current_frame); }
+
+        [[nodiscard]] vk::DeviceAddress instanceBufferAddress(const uint32_t current_frame) const { return m_Buffers.instanceAddress(current_frame); }
+
+      private:
+        struct CullPushConstants {
+            std::array<glm::vec4, 6> planes;
+            vk::DeviceAddress        instances;
+            vk::DeviceAddress        meshes;
+            vk::DeviceAddress        draws;
+            uint32_t                 instanceCount;
+        };
+
+        constexpr static uint32_t WORKGROUP_SIZE = 64;
+
+        std::shared_ptr<RenderDevice>  m_RenderDevice;
+        std::unique_ptr<ComputeShader> m_CullShader;
+        IndirectDrawBuffers            m_Buffers; // one command per instance at most
+
+        RawBuffer         m_Meshes{nullptr};
+        vk::DeviceAddress m_MeshAddress{};
+    };
+
+} // namespace engine
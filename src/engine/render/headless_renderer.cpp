@@ -0,0 +1,91 @@
+#include "headless_renderer.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace engine {
+    HeadlessRenderer::HeadlessRenderer(const std::shared_ptr<RenderDevice> &render_device, const vk::Extent2D extent, const vk::Format format)
+        : m_RenderDevice(render_device), m_Extent(extent), m_Format(format), m_CommandBuffers(m_RenderDevice->allocateCommandBuffers<QueueType::GRAPHICS>(MAX_FRAMES_IN_FLIGHT)) {
+        if (extent.width == 0 || extent.height == 0) {
+            throw std::invalid_argument("HeadlessRenderer::HeadlessRenderer(): Extent must not be empty");
+        }
+
+        for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            auto [image, _] = m_RenderDevice->createImage(
+                vk::Extent3D(extent.width, extent.height, 1), format, vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc, false, false,
+                MemoryUsage::AutoPreferDevice, VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT
+            );
+            m_TargetViews.emplace_back(
+                m_RenderDevice->device(),
+                vk::ImageViewCreateInfo({}, *image.image, vk::ImageViewType::e2D, format, {}, vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1))
+            );
+            m_Targets.push_back(std::move(image));
+            m_InFlightFences.emplace_back(m_RenderDevice->createFence(true));
+        }
+    }
+
+    HeadlessRenderer::~HeadlessRenderer() {}
+
+    void HeadlessRenderer::renderFrame(const FrameFunction &prepare, const FrameFunction &func) {
+        const auto &fence = m_InFlightFences[m_CurrentFrame];
+        m_RenderDevice->waitFence(fence);
+        m_RenderDevice->resetFence(fence);
+
+        const vk::Image          image = *m_Targets[m_CurrentFrame].image;
+        const SwapchainFrameInfo frame_info{image, m_CurrentFrame, vk::SurfaceFormatKHR(m_Format, vk::ColorSpaceKHR::eSrgbNonlinear), m_Extent};
+
+        // left ready to be read back, where the window renderer would present
+        const auto &cmd = m_CommandBuffers[m_CurrentFrame];
+        recordFrame(cmd, frame_info, *m_TargetViews[m_CurrentFrame], m_CurrentFrame,
+                    {vk::ImageLayout::eTransferSrcOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferRead, 0}, prepare, func);
+
+        vk::CommandBufferSubmitInfo cmd_submit_info{*cmd};
+        const vk::SubmitInfo2       si{{}, {}, cmd_submit_info, {}};
+        m_RenderDevice->graphicsQueue().submit2(si, fence);
+
+        m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        m_FrameCount++;
+    }
+
+    TextureImage HeadlessRenderer::capture() const {
+        if (m_FrameCount == 0) {
+            throw std::logic_error("HeadlessRenderer::capture(): No frame has been rendered");
+        }
+        if (m_Format != vk::Format::eR8G8B8A8Srgb && m_Format != vk::Format::eR8G8B8A8Unorm) {
+            throw std::logic_error("HeadlessRenderer::capture(): Only RGBA8 targets can be captured");
+        }
+
+        const uint32_t last = (m_CurrentFrame + MAX_FRAMES_IN_FLIGHT - 1) % MAX_FRAMES_IN_FLIGHT;
+        m_RenderDevice->waitFence(m_InFlightFences[last]);
+
+        TextureImage result;
+        result.width  = m_Extent.width;
+        result.height = m_Extent.height;
+        result.pixels.resize(std::size_t{m_Extent.width} * m_Extent.height * 4);
+
+        auto [readback, info] = m_RenderDevice->createBuffer(
+            result.pixels.size(), vk::BufferUsageFlagBits::eTransferDst, MemoryUsage::AutoPreferHost,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        );
+
+        const auto fence = m_RenderDevice->createFence();
+        m_RenderDevice->singleTimeCommands<QueueType::GRAPHICS>(
+            [&](const vk::raii::CommandBuffer &cmd) {
+                vk::BufferImageCopy region{};
+                region.imageSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1);
+                region.imageExtent      = vk::Extent3D(m_Extent.width, m_Extent.height, 1);
+                cmd.copyImageToBuffer(*m_Targets[last].image, vk::ImageLayout::eTransferSrcOptimal, *readback.buffer, region);
+
+                const vk::MemoryBarrier2 to_host(vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::PipelineStageFlagBits2::eHost,
+                                                 vk::AccessFlagBits2::eHostRead);
+                cmd.pipelineBarrier2(vk::DependencyInfo({}, to_host));
+            },
+            fence
+        );
+        m_RenderDevice->waitFence(fence);
+
+        readback.allocation->invalidate(0, result.pixels.size());
+        std::memcpy(result.pixels.data(), info.pMappedData, result.pixels.size());
+        return result;
+    }
+} // namespace engine
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "engine/assets/texture_image.hpp"
+#include "engine/render/frame_renderer.hpp"
+#include "engine/render_device.hpp"
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Renders into offscreen images instead of a swapchain, one per frame in flight, for devices created with `RenderDeviceOptions::headless`.
+    // Frames are recorded exactly like WindowRenderer's (the frame info's image index is the frame in flight); nothing waits on a display,
+    // so frame times measure the renderer alone.
+    class HeadlessRenderer : public FrameRenderer {
+      public:
+        HeadlessRenderer(const std::shared_ptr<RenderDevice> &render_device, vk::Extent2D extent, vk::Format format = vk::Format::eR8G8B8A8Srgb);
+        ~HeadlessRenderer() override;
+
+        using FrameRenderer::renderFrame;
+        void renderFrame(const FrameFunction &prepare, const FrameFunction &func) override;
+
+        // Waits for the last rendered frame and reads its image back. Throws std::logic_error before the first frame or for formats that aren't RGBA8.
+        [[nodiscard]] TextureImage capture() const;
+
+        [[nodiscard]] vk::Extent2D    extent() const { return m_Extent; }
+        [[nodiscard]] vk::Format      format() const { return m_Format; }
+        [[nodiscard]] const RawImage &target(const uint32_t frame) const { return m_Targets[frame]; }
+
+      private:
+        std::shared_ptr<RenderDevice> m_RenderDevice;
+        vk::Extent2D                  m_Extent;
+        vk::Format                    m_Format;
+
+        uint32_t m_CurrentFrame = 0;
+
+        std::vector<RawImage>            m_Targets; // left in eTransferSrcOptimal after each frame
+        std::vector<vk::raii::ImageView> m_TargetViews;
+        std::vector<vk::raii::Fence>     m_InFlightFences;
+        vk::raii::CommandBuffers         m_CommandBuffers;
+    };
+
+} // namespace engine
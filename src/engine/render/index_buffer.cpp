@@ -0,0 +1,48 @@
+#include "index_buffer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace engine {
+    IndexBuffer::IndexBuffer(const std::shared_ptr<RenderDevice> &device, const std::span<const uint32_t> indices) : m_Count(static_cast<uint32_t>(indices.size())) {
+        if (indices.empty()) {
+            throw std::invalid_argument("IndexBuffer::IndexBuffer(): Index buffer must not be empty");
+        }
+
+        // 0xFFFF is left out so 16 bit buffers stay valid if primitive restart is ever enabled.
+        const uint32_t max_index = std::ranges::max(indices);
+        m_IndexType              = max_index < UINT16_MAX ? vk::IndexType::eUint16 : vk::IndexType::eUint32;
+
+        std::vector<uint16_t> narrowed;
+        const void           *data = indices.data();
+        vk::DeviceSize        size = indices.size_bytes();
+        if (m_IndexType == vk::IndexType::eUint16) {
+            narrowed.assign(indices.begin(), indices.end());
+            data = narrowed.data();
+            size = narrowed.size() * sizeof(uint16_t);
+        }
+
+        auto [staging, _] = device->createBuffer(size, vk::BufferUsageFlagBits::eTransferSrc, MemoryUsage::AutoPreferHost, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+        staging.write(size, data);
+
+        auto [buffer, __] = device->createBuffer(size, vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst, MemoryUsage::AutoPreferDevice, 0);
+        m_Buffer          = std::move(buffer);
+
+        device->copyBufferToBuffer(staging, m_Buffer, 0, 0, size);
+    }
+
+    void IndexBuffer::bind(const vk::raii::CommandBuffer &cmd, const vk::DeviceSize offset) const {
+        cmd.bindIndexBuffer(*m_Buffer.buffer, offset, m_IndexType);
+    }
+
+    void IndexBuffer::draw(const vk::raii::CommandBuffer &cmd, const uint32_t instance_count, const uint32_t first_instance) const {
+        cmd.drawIndexed(m_Count, instance_count, 0, 0, first_instance);
+    }
+
+    void IndexBuffer::drawRange(
+        const vk::raii::CommandBuffer &cmd, const uint32_t index_count, const uint32_t first_index, const int32_t vertex_offset, const uint32_t instance_count,
+        const uint32_t first_instance
+    ) {
+        cmd.drawIndexed(index_count, instance_count, first_index, vertex_offset, first_instance);
+    }
+} // namespace engine
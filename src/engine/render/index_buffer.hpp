@@ -0,0 +1,40 @@
+#pragma once
+
+#include "engine/render_device.hpp"
+
+#include <memory>
+#include <span>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Gpu-only index buffer. Indices are stored as 16 bit whenever every value fits (halving index fetch), 32 bit otherwise.
+    class IndexBuffer {
+      public:
+        IndexBuffer(const std::shared_ptr<RenderDevice> &device, std::span<const uint32_t> indices);
+
+        static inline std::shared_ptr<IndexBuffer> create(const std::shared_ptr<RenderDevice> &device, std::span<const uint32_t> indices) {
+            return std::make_shared<IndexBuffer>(device, indices);
+        }
+
+        [[nodiscard]] inline vk::IndexType    indexType() const { return m_IndexType; }
+        [[nodiscard]] inline uint32_t         count() const { return m_Count; }
+        [[nodiscard]] inline const RawBuffer &buffer() const { return m_Buffer; }
+
+        void bind(const vk::raii::CommandBuffer &cmd, vk::DeviceSize offset = 0) const;
+
+        // Draws every index. The buffer must be bound.
+        void draw(const vk::raii::CommandBuffer &cmd, uint32_t instance_count = 1, uint32_t first_instance = 0) const;
+
+        // Draws a sub range, e.g. one mesh out of a shared geometry buffer. The buffer must be bound.
+        static void drawRange(
+            const vk::raii::CommandBuffer &cmd, uint32_t index_count, uint32_t first_index, int32_t vertex_offset = 0, uint32_t instance_count = 1, uint32_t first_instance = 0
+        );
+
+      private:
+        RawBuffer     m_Buffer{nullptr};
+        vk::IndexType m_IndexType;
+        uint32_t      m_Count;
+    };
+
+} // namespace engine
@@ -0,0 +1,116 @@
+#include "indirect_draw_buffers.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace engine {
+    IndirectDrawBuffers::IndirectDrawBuffers(const std::shared_ptr<RenderDevice> &render_device, const uint32_t max_instances, const uint32_t max_draws)
+        : m_RenderDevice(render_device), m_MaxInstances(max_instances), m_MaxDraws(max_draws), m_Instances(max_instances) {
+        if (max_instances == 0 || max_draws == 0) {
+            throw std::invalid_argument("IndirectDrawBuffers::IndirectDrawBuffers(): max_instances and max_draws must be greater than zero");
+        }
+        // the cull shaders pass the instance index as each command's firstInstance
+        if (!m_RenderDevice->supportsIndirectFirstInstance()) {
+            throw std::runtime_error("IndirectDrawBuffers::IndirectDrawBuffers(): Device does not support drawIndirectFirstInstance");
+        }
+
+        for (auto &frame : m_Frames) {
+            auto [instances, instances_info] = m_RenderDevice->createBuffer(
+                sizeof(GpuInstance) * max_instances, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress, MemoryUsage::AutoPreferDevice,
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+            );
+            frame.instances       = std::move(instances);
+            frame.mapped          = static_cast<GpuInstance *>(instances_info.pMappedData);
+            frame.instanceAddress = m_RenderDevice->bufferAddress(frame.instances);
+
+            auto [draws, _] = m_RenderDevice->createBuffer(
+                DRAW_COMMANDS_OFFSET + sizeof(vk::DrawIndexedIndirectCommand) * max_draws,
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferDst |
+                    vk::BufferUsageFlagBits::eShaderDeviceAddress,
+                MemoryUsage::AutoPreferDevice, 0
+            );
+            frame.draws       = std::move(draws);
+            frame.drawAddress = m_RenderDevice->bufferAddress(frame.draws);
+        }
+    }
+
+    void IndirectDrawBuffers::setInstanceCount(const uint32_t count) {
+        if (count > m_MaxInstances) {
+            throw std::out_of_range("IndirectDrawBuffers::setInstanceCount(): Instance count exceeds the capacity given at construction");
+        }
+        m_InstanceCount = count;
+    }
+
+    void IndirectDrawBuffers::setInstance(const uint32_t index, const GpuInstance &instance) {
+        if (index >= m_MaxInstances) {
+            throw std::out_of_range("IndirectDrawBuffers::setInstance(): Index exceeds the capacity given at construction");
+        }
+        m_Instances[index] = instance;
+        markDirty(index, index + 1);
+    }
+
+    void IndirectDrawBuffers::setInstances(const uint32_t first, const std::span<const GpuInstance> instances) {
+        if (first + instances.size() > m_MaxInstances) {
+            throw std::out_of_range("IndirectDrawBuffers::setInstances(): Range exceeds the capacity given at construction");
+        }
+        std::ranges::copy(instances, m_Instances.begin() + first);
+        markDirty(first, first + static_cast<uint32_t>(instances.size()));
+    }
+
+    void IndirectDrawBuffers::beginCull(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame) {
+        auto &frame = m_Frames[current_frame];
+
+        if (frame.dirtyBegin < frame.dirtyEnd) {
+            const vk::DeviceSize offset = sizeof(GpuInstance) * frame.dirtyBegin;
+            const vk::DeviceSize size   = sizeof(GpuInstance) * (frame.dirtyEnd - frame.dirtyBegin);
+            std::memcpy(frame.mapped + frame.dirtyBegin, m_Instances.data() + frame.dirtyBegin, size);
+            frame.instances.allocation->flush(offset, size);
+
+            frame.dirtyBegin = UINT32_MAX;
+            frame.dirtyEnd   = 0;
+        }
+
+        cmd.fillBuffer(*frame.draws.buffer, 0, DRAW_COMMANDS_OFFSET, 0);
+
+        const vk::MemoryBarrier2 clear_barrier(
+            vk::PipelineStageFlagBits2::eClear, vk::AccessFlagBits2::eTransferWrite, vk::PipelineStageFlagBits2::eComputeShader,
+            vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite
+        );
+        cmd.pipelineBarrier2(vk::DependencyInfo({}, clear_barrier));
+    }
+
+    void IndirectDrawBuffers::endCull(const vk::raii::CommandBuffer &cmd) const {
+        const vk::MemoryBarrier2 draw_barrier(
+            vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderStorageWrite, vk::PipelineStageFlagBits2::eDrawIndirect,
+            vk::AccessFlagBits2::eIndirectCommandRead
+        );
+        cmd.pipelineBarrier2(vk::DependencyInfo({}, draw_barrier));
+    }
+
+    void IndirectDrawBuffers::draw(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame) const {
+        if (m_InstanceCount == 0) {
+            return;
+        }
+
+        const auto &frame = m_Frames[current_frame];
+        cmd.drawIndexedIndirectCount(*frame.draws.buffer, DRAW_COMMANDS_OFFSET, *frame.draws.buffer, 0, m_MaxDraws, sizeof(vk::DrawIndexedIndirectCommand));
+    }
+
+    RawBuffer IndirectDrawBuffers::createTable(const void *data, const vk::DeviceSize size) const {
+        auto [staging, _] = m_RenderDevice->createBuffer(size, vk::BufferUsageFlagBits::eTransferSrc, MemoryUsage::AutoPreferHost, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+        staging.write(size, data);
+
+        auto [buffer, __] = m_RenderDevice->createBuffer(
+            size, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eShaderDeviceAddress, MemoryUsage::AutoPreferDevice, 0
+        );
+        m_RenderDevice->copyBufferToBuffer(staging, buffer, 0, 0, size);
+        return std::move(buffer);
+    }
+
+    void IndirectDrawBuffers::markDirty(const uint32_t begin, const uint32_t end) {
+        for (auto &frame : m_Frames) {
+            frame.dirtyBegin = std::min(frame.dirtyBegin, begin);
+            frame.dirtyEnd   = std::max(frame.dirtyEnd, end);
+        }
+    }
+} // namespace engine
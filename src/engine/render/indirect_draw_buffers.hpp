@@ -0,0 +1,80 @@
+#pragma once
+
+#include "engine/render/frame_renderer.hpp"
+#include "engine/render_device.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Mirrors `Instance` in `assets/shaders/cull.comp`, `assets/shaders/cluster_cull.comp` and `assets/shaders/indirect.vert`.
+    struct GpuInstance {
+        glm::mat4 transform;
+        uint32_t  meshIndex;
+        uint32_t  _padding[3];
+    };
+    static_assert(sizeof(GpuInstance) == 80);
+
+    // Buffers shared by the GPU culling passes (GpuCulling, ClusterCulling). Per frame in flight: a mapped instance buffer that receives the instances
+    // changed since the slot was last used, and a device local buffer holding the draw count (padded to 16 bytes) followed by up to `max_draws`
+    // VkDrawIndexedIndirectCommands, written by a cull dispatch recorded between `beginCull` and `endCull` and consumed by `draw`.
+    class IndirectDrawBuffers {
+      public:
+        IndirectDrawBuffers(const std::shared_ptr<RenderDevice> &render_device, uint32_t max_instances, uint32_t max_draws);
+
+        void setInstanceCount(uint32_t count);
+        void setInstance(uint32_t index, const GpuInstance &instance);
+        void setInstances(uint32_t first, std::span<const GpuInstance> instances);
+
+        [[nodiscard]] inline uint32_t instanceCount() const { return m_InstanceCount; }
+        [[nodiscard]] inline uint32_t maxInstances() const { return m_MaxInstances; }
+        [[nodiscard]] inline uint32_t maxDraws() const { return m_MaxDraws; }
+
+        // Uploads the frame's dirty instances and zeroes its draw count, visible to compute shaders afterwards. Must be recorded outside of a render pass.
+        void beginCull(const vk::raii::CommandBuffer &cmd, uint32_t current_frame);
+        // Makes the commands written by the cull dispatch visible to `draw`.
+        void endCull(const vk::raii::CommandBuffer &cmd) const;
+
+        // Records the indirect draw. The count written by the cull pass can exceed `maxDraws`, maxDrawCount clamps it.
+        void draw(const vk::raii::CommandBuffer &cmd, uint32_t current_frame) const;
+
+        [[nodiscard]] vk::DeviceAddress instanceAddress(uint32_t current_frame) const { return m_Frames[current_frame].instanceAddress; }
+        [[nodiscard]] vk::DeviceAddress drawAddress(uint32_t current_frame) const { return m_Frames[current_frame].drawAddress; }
+
+        // Device local storage buffer holding `data`, uploaded through a staging buffer. For the read-only tables the cull shaders index.
+        [[nodiscard]] RawBuffer createTable(const void *data, vk::DeviceSize size) const;
+
+      private:
+        struct FrameResources {
+            RawBuffer         instances{nullptr};
+            GpuInstance      *mapped = nullptr;
+            vk::DeviceAddress instanceAddress{};
+
+            RawBuffer         draws{nullptr};
+            vk::DeviceAddress drawAddress{};
+
+            // instance range written on the cpu since this frame slot was last uploaded
+            uint32_t dirtyBegin = UINT32_MAX;
+            uint32_t dirtyEnd   = 0;
+        };
+
+        constexpr static vk::DeviceSize DRAW_COMMANDS_OFFSET = 16;
+
+        void markDirty(uint32_t begin, uint32_t end);
+
+        std::shared_ptr<RenderDevice> m_RenderDevice;
+
+        uint32_t                 m_MaxInstances;
+        uint32_t                 m_MaxDraws;
+        uint32_t                 m_InstanceCount = 0;
+        std::vector<GpuInstance> m_Instances;
+
+        std::array<FrameResources, MAX_FRAMES_IN_FLIGHT> m_Frames;
+    };
+
+} // namespace engine
@@ -0,0 +1,76 @@
+#include "instance_buffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace engine {
+    InstanceBuffer::InstanceBuffer(const std::shared_ptr<RenderDevice> &device, const vk::DeviceSize element_size, const uint32_t capacity, const VertexBufferLayout &layout)
+        : m_Layout(layout), m_ElementSize(element_size), m_RegionSize((element_size * capacity + 255) & ~vk::DeviceSize{255}), m_Capacity(capacity) {
+        if (m_Layout.bindings.size() != 1) {
+            throw std::invalid_argument("InstanceBuffer::InstanceBuffer(): Layout must have exactly one binding");
+        }
+        if (m_Layout.bindings.front().inputRate != vk::VertexInputRate::eInstance) {
+            throw std::invalid_argument("InstanceBuffer::InstanceBuffer(): Layout binding must use the instance input rate");
+        }
+
+        auto [buffer, info] = device->createBuffer(
+            m_RegionSize * MAX_FRAMES_IN_FLIGHT, vk::BufferUsageFlagBits::eVertexBuffer, MemoryUsage::AutoPreferDevice,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        );
+        m_Buffer = std::move(buffer);
+        m_Mapped = static_cast<std::byte *>(info.pMappedData);
+    }
+
+    void InstanceBuffer::bind(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame) const {
+        cmd.bindVertexBuffers(m_Layout.bindings.front().binding, {*m_Buffer.buffer}, {m_RegionSize * current_frame});
+    }
+
+    void InstanceBuffer::draw(
+        const vk::raii::CommandBuffer &cmd, const uint32_t current_frame, const VertexBuffer &mesh, const uint32_t vertex_count, const uint32_t first_vertex
+    ) const {
+        if (m_Counts[current_frame] == 0) {
+            return;
+        }
+
+        combinedLayout(mesh.layout()).setState(cmd);
+        mesh.bind(cmd, current_frame, mesh.layout().bindings.front().binding);
+        bind(cmd, current_frame);
+        cmd.draw(vertex_count, m_Counts[current_frame], first_vertex, 0);
+    }
+
+    void InstanceBuffer::drawIndexed(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame, const VertexBuffer &mesh, const IndexBuffer &indices) const {
+        if (m_Counts[current_frame] == 0) {
+            return;
+        }
+
+        combinedLayout(mesh.layout()).setState(cmd);
+        mesh.bind(cmd, current_frame, mesh.layout().bindings.front().binding);
+        indices.bind(cmd);
+        bind(cmd, current_frame);
+        indices.draw(cmd, m_Counts[current_frame]);
+    }
+
+    const VertexBufferLayout &InstanceBuffer::combinedLayout(const VertexBufferLayout &mesh) const {
+        const auto it = std::ranges::find(m_CombinedLayouts, mesh, &CombinedLayout::mesh);
+        if (it != m_CombinedLayouts.end()) {
+            return it->combined;
+        }
+        return m_CombinedLayouts.emplace_back(mesh, mesh.combinedWith(m_Layout)).combined;
+    }
+
+    void InstanceBuffer::write(const uint32_t current_frame, const void *data, const uint32_t count, const vk::DeviceSize element_size) {
+        if (element_size != m_ElementSize) {
+            throw std::invalid_argument("InstanceBuffer::update(): Instance type size does not match the buffer's element size");
+        }
+        if (count > m_Capacity) {
+            throw std::out_of_range("InstanceBuffer::update(): Instance count exceeds the capacity given at construction");
+        }
+
+        if (count > 0) {
+            const vk::DeviceSize offset = m_RegionSize * current_frame;
+            std::memcpy(m_Mapped + offset, data, m_ElementSize * count);
+            m_Buffer.allocation->flush(offset, m_ElementSize * count);
+        }
+        m_Counts[current_frame] = count;
+    }
+} // namespace engine
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "engine/render/frame_renderer.hpp"
+#include "engine/render/index_buffer.hpp"
+#include "engine/render/vertex_buffer.hpp"
+#include "engine/render_device.hpp"
+
+#include <array>
+#include <vector>
+#include <ranges>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Per-instance vertex stream rewritten every frame. Holds one region per frame in flight inside a single persistently mapped buffer,
+    // so writing the current frame's instances never touches data the gpu may still be reading for the previous frame.
+    // `layout` describes the single per-instance binding, which must use vk::VertexInputRate::eInstance.
+    class InstanceBuffer {
+      public:
+        InstanceBuffer(const std::shared_ptr<RenderDevice> &device, vk::DeviceSize element_size, uint32_t capacity, const VertexBufferLayout &layout);
+
+        template <typename T>
+        static inline std::shared_ptr<InstanceBuffer> create(const std::shared_ptr<RenderDevice> &device, const uint32_t capacity, const VertexBufferLayout &layout) {
+            static_assert(std::is_standard_layout_v<T> && "Invalid instance type (must be a standard layout type to ensure that it is safe to copy)");
+            return std::make_shared<InstanceBuffer>(device, sizeof(T), capacity, layout);
+        }
+
+        // Replaces the current frame's instances. Throws if `instances` holds more than the capacity given at construction.
+        template <std::ranges::contiguous_range R>
+        void update(const uint32_t current_frame, const R &instances) {
+            using range_value_t = std::ranges::range_value_t<R>;
+            static_assert(std::is_standard_layout_v<range_value_t> && "Invalid instance type (must be a standard layout type to ensure that it is safe to copy)");
+            write(current_frame, std::ranges::cdata(instances), static_cast<uint32_t>(std::ranges::size(instances)), sizeof(range_value_t));
+        }
+
+        [[nodiscard]] inline uint32_t                  count(const uint32_t current_frame) const { return m_Counts[current_frame]; }
+        [[nodiscard]] inline uint32_t                  capacity() const { return m_Capacity; }
+        [[nodiscard]] inline const VertexBufferLayout &layout() const { return m_Layout; }
+
+        // Binds the current frame's region to the layout's binding.
+        void bind(const vk::raii::CommandBuffer &cmd, uint32_t current_frame) const;
+
+        // Sets the combined mesh + instance vertex input state, binds both streams and draws every instance of the current frame in one call.
+        // The combined state is built once per distinct mesh layout and reused, so drawing doesn't allocate. Not thread safe.
+        void draw(const vk::raii::CommandBuffer &cmd, uint32_t current_frame, const VertexBuffer &mesh, uint32_t vertex_count, uint32_t first_vertex = 0) const;
+        void drawIndexed(const vk::raii::CommandBuffer &cmd, uint32_t current_frame, const VertexBuffer &mesh, const IndexBuffer &indices) const;
+
+      private:
+        struct CombinedLayout {
+            VertexBufferLayout mesh;
+            VertexBufferLayout combined;
+        };
+
+        const VertexBufferLayout &combinedLayout(const VertexBufferLayout &mesh) const;
+        void                      write(uint32_t current_frame, const void *data, uint32_t count, vk::DeviceSize element_size);
+
+        RawBuffer          m_Buffer{nullptr};
+        std::byte         *m_Mapped = nullptr;
+        VertexBufferLayout m_Layout;
+        vk::DeviceSize     m_ElementSize;
+        vk::DeviceSize     m_RegionSize;
+        uint32_t           m_Capacity;
+
+        std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_Counts{};
+
+        mutable std::vector<CombinedLayout> m_CombinedLayouts; // one per mesh layout drawn with, usually a handful
+    };
+
+} // namespace engine
@@ -0,0 +1,102 @@
+#include "layout_cache.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+
+namespace engine {
+    namespace {
+        template <typename Handle>
+        uint64_t handleBits(const Handle handle) {
+            return std::bit_cast<uint64_t>(static_cast<typename Handle::CType>(handle));
+        }
+    } // namespace
+
+    std::size_t LayoutCache::KeyHash::operator()(const Key &key) const {
+        uint64_t hash = 0xcbf29ce484222325;
+        for (const uint64_t word : key) {
+            hash ^= word + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+
+    LayoutCache::LayoutCache(const vk::raii::Device &device) : m_Device(device) {}
+
+    vk::DescriptorSetLayout LayoutCache::descriptorSetLayout(const std::span<const vk::DescriptorSetLayoutBinding> bindings, const vk::DescriptorSetLayoutCreateFlags flags) {
+        std::vector sorted(bindings.begin(), bindings.end());
+        std::ranges::sort(sorted, {}, &vk::DescriptorSetLayoutBinding::binding);
+
+        Key key{static_cast<uint64_t>(static_cast<VkDescriptorSetLayoutCreateFlags>(flags))};
+        for (const auto &binding : sorted) {
+            key.push_back(static_cast<uint64_t>(binding.binding) << 32 | static_cast<uint32_t>(binding.descriptorType));
+            key.push_back(static_cast<uint64_t>(binding.descriptorCount) << 32 | static_cast<VkShaderStageFlags>(binding.stageFlags));
+            if (binding.pImmutableSamplers) {
+                for (uint32_t i = 0; i < binding.descriptorCount; i++) {
+                    key.push_back(handleBits(binding.pImmutableSamplers[i]));
+                }
+            }
+        }
+
+        std::scoped_lock lock(m_Mutex);
+        auto             it = m_SetLayouts.find(key);
+        if (it == m_SetLayouts.end()) {
+            it = m_SetLayouts.emplace(std::move(key), vk::raii::DescriptorSetLayout(m_Device, vk::DescriptorSetLayoutCreateInfo(flags, sorted))).first;
+        }
+        return *it->second;
+    }
+
+    vk::PipelineLayout LayoutCache::pipelineLayout(const ShaderInputLayout &sil) {
+        Key key;
+        key.reserve(sil.descriptor_set_layouts.size() + sil.push_constant_ranges.size() + 1);
+        key.push_back(sil.descriptor_set_layouts.size());
+        for (const auto layout : sil.descriptor_set_layouts) {
+            key.push_back(handleBits(layout));
+        }
+        for (const auto &range : sil.push_constant_ranges) {
+            key.push_back(static_cast<uint64_t>(static_cast<VkShaderStageFlags>(range.stageFlags)) << 32 | static_cast<uint64_t>(range.offset) << 16 | range.size);
+        }
+
+        std::scoped_lock lock(m_Mutex);
+        auto             it = m_PipelineLayouts.find(key);
+        if (it == m_PipelineLayouts.end()) {
+            it = m_PipelineLayouts.emplace(std::move(key), vk::raii::PipelineLayout(m_Device, vk::PipelineLayoutCreateInfo({}, sil.descriptor_set_layouts, sil.push_constant_ranges)))
+                     .first;
+        }
+        return *it->second;
+    }
+
+    ShaderInputLayout LayoutCache::inputLayout(const ShaderReflection &reflection) {
+        ShaderInputLayout sil;
+        if (reflection.pushConstants) {
+            sil.push_constant_ranges.push_back(*reflection.pushConstants);
+        }
+
+        std::vector<vk::DescriptorSetLayoutBinding> bindings;
+        auto                                        next = reflection.bindings.begin();
+        for (uint32_t set = 0; set < reflection.setCount(); set++) {
+            bindings.clear();
+            for (; next != reflection.bindings.end() && next->set == set; ++next) {
+                if (next->count == 0) {
+                    throw std::invalid_argument(
+                        "LayoutCache::inputLayout(): Unsized descriptor array at set " + std::to_string(next->set) + " binding " + std::to_string(next->binding) +
+                        " needs an explicit layout"
+                    );
+                }
+                bindings.emplace_back(next->binding, next->type, next->count, next->stages);
+            }
+            sil.descriptor_set_layouts.push_back(descriptorSetLayout(bindings));
+        }
+
+        return sil;
+    }
+
+    std::size_t LayoutCache::descriptorSetLayoutCount() const {
+        std::scoped_lock lock(m_Mutex);
+        return m_SetLayouts.size();
+    }
+
+    std::size_t LayoutCache::pipelineLayoutCount() const {
+        std::scoped_lock lock(m_Mutex);
+        return m_PipelineLayouts.size();
+    }
+} // namespace engine
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "engine/render/shader_object.hpp"
+#include "engine/render/shader_reflection.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+    // Hash-consed descriptor set layouts and pipeline layouts. Asking twice for the same description returns the same handle,
+    // so materials built from compatible shaders share a pipeline layout and descriptor sets stay bound across shader switches.
+    // Handles live as long as the cache (i.e. the render device). Thread safe.
+    class LayoutCache {
+      public:
+        explicit LayoutCache(const vk::raii::Device &device);
+
+        // Bindings may come in any order.
+        vk::DescriptorSetLayout descriptorSetLayout(std::span<const vk::DescriptorSetLayoutBinding> bindings, vk::DescriptorSetLayoutCreateFlags flags = {});
+        vk::PipelineLayout      pipelineLayout(const ShaderInputLayout &sil);
+
+        // One set layout per set index up to the highest one used (gaps get empty layouts) and the reflected push constant range.
+        // Throws std::invalid_argument for unsized descriptor arrays, whose size has to be chosen with an explicit layout.
+        ShaderInputLayout inputLayout(const ShaderReflection &reflection);
+
+        [[nodiscard]] std::size_t descriptorSetLayoutCount() const;
+        [[nodiscard]] std::size_t pipelineLayoutCount() const;
+
+      private:
+        using Key = std::vector<uint64_t>;
+
+        struct KeyHash {
+            std::size_t operator()(const Key &key) const;
+        };
+
+        const vk::raii::Device &m_Device;
+
+        mutable std::mutex                                                m_Mutex;
+        std::unordered_map<Key, vk::raii::DescriptorSetLayout, KeyHash> m_SetLayouts;
+        std::unordered_map<Key, vk::raii::PipelineLayout, KeyHash>      m_PipelineLayouts;
+    };
+
+} // namespace engine
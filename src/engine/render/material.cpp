@@ -4,6 +4,10 @@
 
 #include "material.hpp"
 
+#include "engine/render/layout_cache.hpp"
+
+#include <algorithm>
+
 namespace engine {
     void ShaderInternal_Unlinked::bindTo(const vk::raii::CommandBuffer &cmd) const {
         for (const auto &shader : stages) {
@@ -11,13 +15,24 @@ namespace engine {
         }
     }
 
+    void ShaderInternal_Unlinked::bindTo(CommandState &state) const {
+        for (const auto &shader : stages) {
+            shader->bindTo(state);
+        }
+    }
+
     void ShaderInternal_Linked::bindTo(const vk::raii::CommandBuffer &cmd) const {
         linkedShader->bindTo(cmd);
     }
 
+    void ShaderInternal_Linked::bindTo(CommandState &state) const {
+        linkedShader->bindTo(state);
+    }
+
     struct Mat_StageInfo {
-        MaterialShaderStage     stage;
-        vk::ShaderStageFlagBits next_stage;
+        MaterialShaderStage          stage;
+        vk::ShaderStageFlagBits      next_stage;
+        std::span<const uint32_t>    code;
     };
 
     constexpr std::array raster_stages = {
@@ -25,14 +40,48 @@ namespace engine {
         vk::ShaderStageFlagBits::eFragment,
     };
 
+    namespace {
+        std::vector<std::vector<uint32_t>> loadStageCode(const std::vector<MaterialShaderStage> &stages) {
+            std::vector<std::vector<uint32_t>> code;
+            code.reserve(stages.size());
+            for (const auto &stage : stages) {
+                code.push_back(Shader::load_code(stage.path));
+            }
+            return code;
+        }
+    } // namespace
+
     MaterialShader::MaterialShader(const std::shared_ptr<RenderDevice> &renderDevice, const std::vector<MaterialShaderStage> &stages) : m_RenderDevice(renderDevice) {
+        const auto code = loadStageCode(stages);
+        create(stages, {code.begin(), code.end()});
+    }
+
+    MaterialShader::MaterialShader(
+        const std::shared_ptr<RenderDevice> &renderDevice, const std::vector<MaterialShaderStage> &stages, const std::vector<std::span<const uint32_t>> &code
+    )
+        : m_RenderDevice(renderDevice) {
+        create(stages, code);
+    }
+
+    void MaterialShader::create(const std::vector<MaterialShaderStage> &stages, const std::vector<std::span<const uint32_t>> &code) {
+        if (code.size() != stages.size()) {
+            throw std::invalid_argument("MaterialShader::MaterialShader(): Expected one code blob per stage");
+        }
+
         std::unordered_map<vk::ShaderStageFlagBits, Mat_StageInfo> stageInfos;
-        for (const auto &stage : stages) {
+        for (std::size_t i = 0; i < stages.size(); i++) {
+            const auto &stage = stages[i];
             if (stageInfos.contains(stage.stage)) {
                 throw std::invalid_argument("MaterialShader::MaterialShader(): Only one shader is allowed per stage");
             }
 
-            stageInfos[stage.stage] = {stage, vk::ShaderStageFlagBits::eAll};
+            if (std::ranges::find(raster_stages, stage.stage) == raster_stages.end()) {
+                throw std::invalid_argument(
+                    "MaterialShader::MaterialShader(): Unsupported stage " + vk::to_string(stage.stage) + " (compute shaders are created with ComputeShader)"
+                );
+            }
+
+            stageInfos[stage.stage] = {stage, vk::ShaderStageFlagBits::eAll, code[i]};
         }
 
         vk::ShaderStageFlagBits lastIncludedStage = raster_stages.back();
@@ -51,6 +100,22 @@ namespace engine {
             throw std::invalid_argument("MaterialShader::MaterialShader(): Missing required stage: " + vk::to_string(raster_stages.front()));
         }
 
+        if (std::ranges::all_of(stages, [](const MaterialShaderStage &stage) { return stage.sil.empty(); })) {
+            ShaderReflection reflection = ShaderReflection::reflect(code.front());
+            for (std::size_t i = 1; i < code.size(); i++) {
+                reflection.merge(ShaderReflection::reflect(code[i]));
+            }
+            m_InputLayout = m_RenderDevice->layoutCache().inputLayout(reflection);
+        } else {
+            for (const auto stage : raster_stages) {
+                if (stageInfos.contains(stage) && !stageInfos[stage].stage.sil.empty()) {
+                    m_InputLayout = stageInfos[stage].stage.sil;
+                    break;
+                }
+            }
+        }
+        m_Layout = m_RenderDevice->layoutCache().pipelineLayout(m_InputLayout);
+
         std::vector<ShaderInfo> shaderInfos;
         for (const auto &[_, stage] : stageInfos) {
             shaderInfos.push_back(
@@ -58,8 +123,8 @@ namespace engine {
                     .stage     = stage.stage.stage,
                     .nextStage = stage.next_stage,
                     .name      = stage.stage.entryPoint.c_str(),
-                    .code      = Shader::load_code(stage.stage.path),
-                    .sil       = stage.stage.sil,
+                    .code      = stage.code,
+                    .sil       = stage.stage.sil.empty() ? m_InputLayout : stage.stage.sil,
                 }
             );
         }
@@ -70,7 +135,17 @@ namespace engine {
     MaterialShader::MaterialShader(const std::shared_ptr<RenderDevice> &renderDevice, const std::vector<std::shared_ptr<Shader>> &stages)
         : m_RenderDevice(renderDevice), m_Shader(std::make_unique<ShaderInternal_Unlinked>(stages)) {}
 
+    void MaterialShader::swapShaders(MaterialShader &other) noexcept {
+        std::swap(m_Shader, other.m_Shader);
+        std::swap(m_InputLayout, other.m_InputLayout);
+        std::swap(m_Layout, other.m_Layout);
+    }
+
     void MaterialShader::bindTo(const vk::raii::CommandBuffer &cmd) const {
         m_Shader->bindTo(cmd);
     }
+
+    void MaterialShader::bindTo(CommandState &state) const {
+        m_Shader->bindTo(state);
+    }
 } // namespace engine
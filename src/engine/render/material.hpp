@@ -4,6 +4,7 @@
 #include "engine/render_device.hpp"
 
 #include <filesystem>
+#include <span>
 #include <vulkan/vulkan_raii.hpp>
 
 namespace engine {
@@ -23,6 +24,7 @@ namespace engine {
       public:
         virtual ~ShaderInternal()                                     = default;
         virtual void bindTo(const vk::raii::CommandBuffer &cmd) const = 0;
+        virtual void bindTo(CommandState &state) const                = 0;
     };
 
     class ShaderInternal_Unlinked : public ShaderInternal {
@@ -30,6 +32,7 @@ namespace engine {
         explicit ShaderInternal_Unlinked(const std::vector<std::shared_ptr<Shader>> &stages) : stages(stages) {}
 
         void bindTo(const vk::raii::CommandBuffer &cmd) const override;
+        void bindTo(CommandState &state) const override;
 
       private:
         std::vector<std::shared_ptr<Shader>> stages;
@@ -40,18 +43,32 @@ namespace engine {
         explicit ShaderInternal_Linked(const std::shared_ptr<LinkedShader> &linked_shader) : linkedShader(linked_shader) {}
 
         void bindTo(const vk::raii::CommandBuffer &cmd) const override;
+        void bindTo(CommandState &state) const override;
 
       private:
         std::shared_ptr<LinkedShader> linkedShader;
     };
 
+    // When no stage is given a sil, every stage shares one reflected from all of the stages' code. Otherwise the given layouts are used as is
+    // and the material's layout is the first one in pipeline order. Layouts come from the device's `LayoutCache`, so materials with the same
+    // interface share a pipeline layout and bound descriptor sets survive switching between them.
     class MaterialShader {
       public:
         MaterialShader(const std::shared_ptr<RenderDevice> &renderDevice, const std::vector<MaterialShaderStage> &stages);
+        // Takes already loaded SPIR-V, `code[i]` being the code of `stages[i]` (the stage paths are not read). The code only has to live through the constructor.
+        MaterialShader(const std::shared_ptr<RenderDevice> &renderDevice, const std::vector<MaterialShaderStage> &stages, const std::vector<std::span<const uint32_t>> &code);
         MaterialShader(const std::shared_ptr<RenderDevice> &renderDevice, const std::vector<std::shared_ptr<Shader>> &stages);
         ~MaterialShader() = default;
 
         void bindTo(const vk::raii::CommandBuffer &cmd) const;
+        void bindTo(CommandState &state) const;
+
+        // Exchanges the shader objects and layouts of two materials, e.g. to put a recompiled shader in place while keeping every reference to this material valid.
+        // Neither material may be in use by a recording on another thread, and the shaders ending up in `other` may still be in use by frames in flight.
+        void swapShaders(MaterialShader &other) noexcept;
+
+        [[nodiscard]] inline const ShaderInputLayout &inputLayout() const { return m_InputLayout; }
+        [[nodiscard]] inline vk::PipelineLayout       layout() const { return m_Layout; } // null for materials made from unlinked shaders
 
         inline static std::shared_ptr<MaterialShader> create_shared(const std::shared_ptr<RenderDevice> &renderDevice, const std::vector<MaterialShaderStage> &stages) {
             return std::make_shared<MaterialShader>(renderDevice, stages);
@@ -62,8 +79,12 @@ namespace engine {
         }
 
       private:
+        void create(const std::vector<MaterialShaderStage> &stages, const std::vector<std::span<const uint32_t>> &code);
+
         std::shared_ptr<RenderDevice>   m_RenderDevice;
         std::unique_ptr<ShaderInternal> m_Shader;
+        ShaderInputLayout               m_InputLayout;
+        vk::PipelineLayout              m_Layout;
     };
 
 } // namespace engine
@@ -0,0 +1,153 @@
+#include "shader_hot_reload.hpp"
+
+#include "engine/render/frame_renderer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <set>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+    namespace {
+        // Events of one save (truncate, write, rename...) are gathered until the directory has been quiet this long.
+        constexpr int                       DEBOUNCE_MS   = 50;
+        constexpr std::chrono::milliseconds POLL_INTERVAL = std::chrono::milliseconds(250);
+
+        // Extensions glslc infers a stage from. Anything else in the directory (compiled output, editor swap files) is ignored.
+        constexpr std::array SOURCE_EXTENSIONS = {".vert", ".frag", ".comp", ".geom", ".tesc", ".tese", ".mesh", ".task"};
+
+        bool isSource(const std::filesystem::path &path) {
+            return std::ranges::find(SOURCE_EXTENSIONS, path.extension().string()) != SOURCE_EXTENSIONS.end();
+        }
+    } // namespace
+
+    ShaderHotReloader::ShaderHotReloader(const std::shared_ptr<RenderDevice> &render_device, const std::shared_ptr<ShaderLibrary> &library, std::filesystem::path source_directory)
+        : m_RenderDevice(render_device), m_Library(library), m_SourceDirectory(std::move(source_directory)),
+          m_Thread([this](const std::stop_token &stop_token) { watch(stop_token); }) {}
+
+    ShaderHotReloader::~ShaderHotReloader() {
+        m_Thread.request_stop();
+        m_Thread.join();
+    }
+
+    uint32_t ShaderHotReloader::applyPending(const FrameRenderer &renderer) {
+        std::vector<Replacement> ready;
+        {
+            std::scoped_lock lock(m_Mutex);
+            ready.swap(m_Ready);
+        }
+
+        // counted in submitted frames, a frame skipped without submitting doesn't move its slot's fence
+        const uint64_t frame_count = renderer.frameCount();
+        while (!m_Retired.empty() && m_Retired.front().releaseAt <= frame_count) {
+            m_Retired.pop_front();
+        }
+
+        for (auto &[material, shaders] : ready) {
+            material->swapShaders(*shaders);
+            m_Retired.push_back({std::move(shaders), frame_count + MAX_FRAMES_IN_FLIGHT});
+        }
+
+        return static_cast<uint32_t>(ready.size());
+    }
+
+    void ShaderHotReloader::watch(const std::stop_token &stop_token) {
+#ifdef __linux__
+        const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0 || inotify_add_watch(fd, m_SourceDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            std::cerr << "Shader hot reload disabled, cannot watch " << m_SourceDirectory << std::endl;
+            if (fd >= 0) {
+                close(fd);
+            }
+            return;
+        }
+
+        alignas(inotify_event) char     buffer[4096];
+        std::set<std::filesystem::path> changed;
+        while (!stop_token.stop_requested()) {
+            pollfd pfd{fd, POLLIN, 0};
+            if (poll(&pfd, 1, changed.empty() ? static_cast<int>(POLL_INTERVAL.count()) : DEBOUNCE_MS) > 0) {
+                for (ssize_t length; (length = read(fd, buffer, sizeof(buffer))) > 0;) {
+                    for (const char *event_data = buffer; event_data < buffer + length;) {
+                        const auto *event = reinterpret_cast<const inotify_event *>(event_data);
+                        if (event->len > 0 && isSource(event->name)) {
+                            changed.insert(m_SourceDirectory / event->name);
+                        }
+                        event_data += sizeof(inotify_event) + event->len;
+                    }
+                }
+                continue;
+            }
+
+            for (const auto &source : changed) {
+                rebuild(source);
+            }
+            changed.clear();
+        }
+
+        close(fd);
+#else
+        const auto scan = [this] {
+            std::map<std::filesystem::path, std::filesystem::file_time_type> times;
+            std::error_code                                                   ec;
+            for (const auto &entry : std::filesystem::directory_iterator(m_SourceDirectory, ec)) {
+                if (entry.is_regular_file() && isSource(entry.path())) {
+                    times[entry.path()] = entry.last_write_time(ec);
+                }
+            }
+            return times;
+        };
+
+        auto times = scan();
+        while (!stop_token.stop_requested()) {
+            std::this_thread::sleep_for(POLL_INTERVAL);
+
+            auto current = scan();
+            for (const auto &[source, time] : current) {
+                if (const auto it = times.find(source); it == times.end() || it->second != time) {
+                    rebuild(source);
+                }
+            }
+            times = std::move(current);
+        }
+#endif
+    }
+
+    void ShaderHotReloader::rebuild(const std::filesystem::path &source) {
+        const std::filesystem::path output  = source.string() + ".spv";
+        const std::string           command = "glslc --target-env=vulkan1.3 \"" + source.string() + "\" -o \"" + output.string() + "\"";
+        if (std::system(command.c_str()) != 0) {
+            std::cerr << "Failed to compile shader " << source.string() << ", keeping the previous version" << std::endl;
+            return;
+        }
+
+        for (const auto &entry : m_Library->manifest()) {
+            const bool uses_output = std::ranges::any_of(entry.stages, [&](const MaterialShaderStage &stage) {
+                std::error_code ec;
+                return std::filesystem::equivalent(stage.path, output, ec);
+            });
+            if (!uses_output) {
+                continue;
+            }
+
+            try {
+                auto shaders = std::make_unique<MaterialShader>(m_RenderDevice, entry.stages);
+
+                std::scoped_lock lock(m_Mutex);
+                m_Ready.push_back({m_Library->get(entry.name), std::move(shaders)});
+                std::cout << "Reloaded material " << entry.name << " (" << source.string() << ")" << std::endl;
+            } catch (std::exception &e) {
+                std::cerr << "Failed to reload material " << entry.name << ": " << e.what() << std::endl;
+            }
+        }
+    }
+} // namespace engine
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "engine/render/frame_renderer.hpp"
+#include "engine/render/material.hpp"
+#include "engine/render/shader_library.hpp"
+#include "engine/render_device.hpp"
+
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+    // Development helper that watches a shader source directory, recompiles changed sources with glslc (as `build_shaders.sh` does)
+    // and rebuilds the library's materials using them. Compilation and shader creation happen on the reloader's own thread so neither
+    // the render thread nor the frame's thread pool jobs wait on it; finished materials are swapped in by `applyPending`.
+    // Watching uses inotify on Linux and polls modification times elsewhere.
+    class ShaderHotReloader {
+      public:
+        // The library's manifest must not change while the reloader runs.
+        ShaderHotReloader(const std::shared_ptr<RenderDevice> &render_device, const std::shared_ptr<ShaderLibrary> &library, std::filesystem::path source_directory);
+        ~ShaderHotReloader();
+
+        ShaderHotReloader(const ShaderHotReloader &)            = delete;
+        ShaderHotReloader &operator=(const ShaderHotReloader &) = delete;
+
+        // Call once per frame on the render thread, outside of recording, with the renderer drawing the materials. Swaps rebuilt shaders into
+        // their materials; the replaced shaders are kept alive until `renderer` has submitted MAX_FRAMES_IN_FLIGHT more frames, when no
+        // frame can still reference them. Returns the number of materials swapped.
+        uint32_t applyPending(const FrameRenderer &renderer);
+
+      private:
+        struct Replacement {
+            std::shared_ptr<MaterialShader> material;
+            std::unique_ptr<MaterialShader> shaders;
+        };
+
+        struct Retired {
+            std::unique_ptr<MaterialShader> shaders;
+            uint64_t                        releaseAt; // frame count
+        };
+
+        void watch(const std::stop_token &stop_token);
+        void rebuild(const std::filesystem::path &source);
+
+        std::shared_ptr<RenderDevice>  m_RenderDevice;
+        std::shared_ptr<ShaderLibrary> m_Library;
+        std::filesystem::path          m_SourceDirectory;
+
+        std::mutex               m_Mutex;
+        std::vector<Replacement> m_Ready;
+        std::deque<Retired>      m_Retired; // render thread only
+
+        std::jthread m_Thread; // last, so it stops before the state it uses is destroyed
+    };
+
+} // namespace engine
@@ -0,0 +1,75 @@
+#include "shader_library.hpp"
+
+#include <unordered_set>
+
+namespace engine {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        std::chrono::microseconds since(const Clock::time_point start) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+        }
+    } // namespace
+
+    ShaderLibrary::ShaderLibrary(
+        const std::shared_ptr<RenderDevice> &render_device, const std::shared_ptr<ThreadPool> &thread_pool, const std::shared_ptr<VirtualFileSystem> &file_system
+    )
+        : m_RenderDevice(render_device), m_ThreadPool(thread_pool), m_FileSystem(file_system) {
+        if (!m_FileSystem) {
+            m_FileSystem = std::make_shared<VirtualFileSystem>();
+            m_FileSystem->mountDirectory({});
+        }
+    }
+
+    void ShaderLibrary::load(const std::vector<MaterialManifestEntry> &manifest) {
+        std::unordered_set<std::string> names;
+        for (const auto &entry : manifest) {
+            if (m_Materials.contains(entry.name) || !names.insert(entry.name).second) {
+                throw std::invalid_argument("ShaderLibrary::load(): Material " + entry.name + " is loaded twice");
+            }
+        }
+
+        const auto start = Clock::now();
+
+        std::vector<std::shared_ptr<MaterialShader>> materials(manifest.size());
+        std::vector<ShaderLoadTiming>                timings(manifest.size());
+
+        // one entry per chunk, the calling thread works through the manifest alongside the workers.
+        m_ThreadPool->parallelFor(manifest.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const auto &entry = manifest[i];
+
+                // uncompressed archive entries are borrowed from the mapping and handed to the driver without a copy.
+                const auto                             read_start = Clock::now();
+                std::vector<AssetData>                 data;
+                std::vector<std::span<const uint32_t>> code;
+                data.reserve(entry.stages.size());
+                code.reserve(entry.stages.size());
+                for (const auto &stage : entry.stages) {
+                    code.push_back(data.emplace_back(m_FileSystem->load(stage.path.generic_string())).as<uint32_t>());
+                }
+                const auto read_time = since(read_start);
+
+                const auto create_start = Clock::now();
+                materials[i]            = std::make_shared<MaterialShader>(m_RenderDevice, entry.stages, code);
+
+                timings[i] = {entry.name, read_time, since(create_start)};
+            }
+        });
+
+        for (std::size_t i = 0; i < manifest.size(); i++) {
+            m_Materials.emplace(manifest[i].name, std::move(materials[i]));
+        }
+        m_Manifest.insert(m_Manifest.end(), manifest.begin(), manifest.end());
+        m_Timings.insert(m_Timings.end(), std::make_move_iterator(timings.begin()), std::make_move_iterator(timings.end()));
+        m_LastLoadTime = since(start);
+    }
+
+    const std::shared_ptr<MaterialShader> &ShaderLibrary::get(const std::string &name) const {
+        const auto it = m_Materials.find(name);
+        if (it == m_Materials.end()) {
+            throw std::out_of_range("ShaderLibrary::get(): No material named " + name);
+        }
+        return it->second;
+    }
+} // namespace engine
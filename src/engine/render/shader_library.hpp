@@ -0,0 +1,64 @@
+#pragma once
+
+#include "engine/assets/virtual_file_system.hpp"
+#include "engine/render/material.hpp"
+#include "engine/render_device.hpp"
+#include "engine/thread_pool.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+    struct MaterialManifestEntry {
+        std::string                      name;
+        std::vector<MaterialShaderStage> stages;
+    };
+
+    struct ShaderLoadTiming {
+        std::string               name;
+        std::chrono::microseconds readTime;   // reading (or mapping) every stage's SPIR-V
+        std::chrono::microseconds createTime; // reflection, layouts and shader object creation
+    };
+
+    // Named set of material shaders built from a manifest. Every material is read and created as its own job on the thread pool
+    // (shader object and layout creation are thread safe per device), so startup scales with cores instead of being one serial chain.
+    // Stage paths are asset names looked up in the file system; without one they are read relative to the working directory.
+    class ShaderLibrary {
+      public:
+        ShaderLibrary(
+            const std::shared_ptr<RenderDevice> &render_device, const std::shared_ptr<ThreadPool> &thread_pool, const std::shared_ptr<VirtualFileSystem> &file_system = nullptr
+        );
+
+        // Loads every entry and blocks until all are created. Throws std::invalid_argument for names that are already loaded or repeated in the manifest,
+        // and rethrows the first failure of any entry, in which case nothing from the manifest is added.
+        void load(const std::vector<MaterialManifestEntry> &manifest);
+
+        // Throws std::out_of_range for unknown names.
+        [[nodiscard]] const std::shared_ptr<MaterialShader> &get(const std::string &name) const;
+        [[nodiscard]] bool                                   contains(const std::string &name) const { return m_Materials.contains(name); }
+        [[nodiscard]] std::size_t                            size() const { return m_Materials.size(); }
+
+        // Every entry loaded so far, in manifest order.
+        [[nodiscard]] const std::vector<MaterialManifestEntry> &manifest() const { return m_Manifest; }
+
+        // Per material timings of every `load` so far, in manifest order.
+        [[nodiscard]] const std::vector<ShaderLoadTiming> &timings() const { return m_Timings; }
+        // Wall clock time of the last `load`.
+        [[nodiscard]] std::chrono::microseconds lastLoadTime() const { return m_LastLoadTime; }
+
+      private:
+        std::shared_ptr<RenderDevice>      m_RenderDevice;
+        std::shared_ptr<ThreadPool>        m_ThreadPool;
+        std::shared_ptr<VirtualFileSystem> m_FileSystem;
+
+        std::unordered_map<std::string, std::shared_ptr<MaterialShader>> m_Materials;
+        std::vector<MaterialManifestEntry>                               m_Manifest;
+        std::vector<ShaderLoadTiming>                                    m_Timings;
+        std::chrono::microseconds                                        m_LastLoadTime{};
+    };
+
+} // namespace engine
@@ -7,6 +7,50 @@
 #include <fstream>
 
 namespace engine {
+    namespace {
+        // written against the vk::raii::CommandBuffer interface, which CommandState mirrors
+        template <typename Commands>
+        void recordBindNull(Commands &cmd) {
+            cmd.bindShadersEXT(
+                {vk::ShaderStageFlagBits::eVertex, vk::ShaderStageFlagBits::eFragment, vk::ShaderStageFlagBits::eTessellationControl, vk::ShaderStageFlagBits::eTessellationEvaluation,
+                 vk::ShaderStageFlagBits::eGeometry},
+                {VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE}
+            );
+        }
+
+        template <typename Commands>
+        void recordGenericState(Commands &cmd) {
+            cmd.setRasterizerDiscardEnable(false);
+
+            cmd.setVertexInputEXT({}, {});
+            cmd.setPrimitiveTopology(vk::PrimitiveTopology::eTriangleList);
+            cmd.setPrimitiveRestartEnable(false);
+
+            cmd.setRasterizationSamplesEXT(vk::SampleCountFlagBits::e1);
+            cmd.setSampleMaskEXT(vk::SampleCountFlagBits::e1, {~0U});
+            cmd.setAlphaToCoverageEnableEXT(false);
+            cmd.setAlphaToOneEnableEXT(false);
+            cmd.setPolygonModeEXT(vk::PolygonMode::eFill);
+            cmd.setLineWidth(1.0f);
+            cmd.setCullMode(vk::CullModeFlagBits::eBack);
+            cmd.setFrontFace(vk::FrontFace::eClockwise);
+            cmd.setDepthWriteEnable(false);
+            cmd.setDepthTestEnable(false);
+            cmd.setDepthBoundsTestEnable(false);
+            cmd.setDepthBiasEnable(false);
+            cmd.setDepthClampEnableEXT(false);
+            cmd.setStencilTestEnable(false);
+
+            cmd.setLogicOpEnableEXT(false);
+            cmd.setColorBlendEnableEXT(0, true);
+            cmd.setColorWriteMaskEXT(0, vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA);
+            cmd.setColorBlendEquationEXT(0, vk::ColorBlendEquationEXT(vk::BlendFactor::eSrcAlpha, vk::BlendFactor::eOneMinusSrcAlpha, vk::BlendOp::eAdd, vk::BlendFactor::eOne, vk::BlendFactor::eZero, vk::BlendOp::eAdd));
+
+            constexpr static float blend_constants[4] = {0.0f,0.0f,0.0f,0.0f};
+            cmd.setBlendConstants(blend_constants);
+        }
+    } // namespace
+
     LinkedShader::LinkedShader(std::vector<std::unique_ptr<Shader>> shaders) : shaders(std::move(shaders)) {
         stages.resize(this->shaders.size());
         shader_objects.resize(this->shaders.size());
@@ -21,6 +65,10 @@ namespace engine {
         cmd.bindShadersEXT(stages, shader_objects);
     }
 
+    void LinkedShader::bindTo(CommandState &state) const {
+        state.bindShadersEXT(stages, shader_objects);
+    }
+
     Shader::Shader(const std::shared_ptr<RenderDevice> &render_device, const ShaderInfo &info)
         : m_RenderDevice(render_device), m_Shader(
                                              m_RenderDevice->device(),
@@ -53,42 +101,19 @@ namespace engine {
     }
 
     void Shader::bindNull(const vk::raii::CommandBuffer &cmd) {
-        cmd.bindShadersEXT(
-            {vk::ShaderStageFlagBits::eVertex, vk::ShaderStageFlagBits::eFragment, vk::ShaderStageFlagBits::eTessellationControl, vk::ShaderStageFlagBits::eTessellationEvaluation,
-             vk::ShaderStageFlagBits::eGeometry},
-            {VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE}
-        );
+        recordBindNull(cmd);
+    }
+
+    void Shader::bindNull(CommandState &state) {
+        recordBindNull(state);
     }
 
     void Shader::setGenericState(const vk::raii::CommandBuffer &cmd) {
-        cmd.setRasterizerDiscardEnable(false);
-
-        cmd.setVertexInputEXT({}, {});
-        cmd.setPrimitiveTopology(vk::PrimitiveTopology::eTriangleList);
-        cmd.setPrimitiveRestartEnable(false);
-
-        cmd.setRasterizationSamplesEXT(vk::SampleCountFlagBits::e1);
-        cmd.setSampleMaskEXT(vk::SampleCountFlagBits::e1, {~0U});
-        cmd.setAlphaToCoverageEnableEXT(false);
-        cmd.setAlphaToOneEnableEXT(false);
-        cmd.setPolygonModeEXT(vk::PolygonMode::eFill);
-        cmd.setLineWidth(1.0f);
-        cmd.setCullMode(vk::CullModeFlagBits::eBack);
-        cmd.setFrontFace(vk::FrontFace::eClockwise);
-        cmd.setDepthWriteEnable(false);
-        cmd.setDepthTestEnable(false);
-        cmd.setDepthBoundsTestEnable(false);
-        cmd.setDepthBiasEnable(false);
-        cmd.setDepthClampEnableEXT(false);
-        cmd.setStencilTestEnable(false);
-
-        cmd.setLogicOpEnableEXT(false);
-        cmd.setColorBlendEnableEXT(0, true);
-        cmd.setColorWriteMaskEXT(0, vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA);
-        cmd.setColorBlendEquationEXT(0, vk::ColorBlendEquationEXT(vk::BlendFactor::eSrcAlpha, vk::BlendFactor::eOneMinusSrcAlpha, vk::BlendOp::eAdd, vk::BlendFactor::eOne, vk::BlendFactor::eZero, vk::BlendOp::eAdd));
-
-        constexpr static float blend_constants[4] = {0.0f,0.0f,0.0f,0.0f};
-        cmd.setBlendConstants(blend_constants);
+        recordGenericState(cmd);
+    }
+
+    void Shader::setGenericState(CommandState &state) {
+        recordGenericState(state);
     }
 
     std::vector<uint32_t> Shader::load_code(const std::filesystem::path &path) {
@@ -107,6 +132,10 @@ namespace engine {
         cmd.bindShadersEXT(m_Stage, *m_Shader);
     }
 
+    void Shader::bindTo(CommandState &state) const {
+        state.bindShadersEXT(m_Stage, *m_Shader);
+    }
+
     Shader::Shader(const std::shared_ptr<RenderDevice> &render_device, vk::raii::ShaderEXT shader, vk::ShaderStageFlagBits stage)
         : m_RenderDevice(render_device), m_Shader(std::move(shader)), m_Stage(stage) {}
 } // namespace engine
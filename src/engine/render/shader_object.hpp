@@ -4,26 +4,31 @@
 
 #pragma once
 
+#include "engine/render/command_state.hpp"
 #include "engine/render_device.hpp"
 
 #include <vulkan/vulkan_raii.hpp>
 
 #include <filesystem>
+#include <span>
 #include <vector>
 
 namespace engine {
 
+    // Left empty, shaders derive it from their SPIR-V (see `ShaderReflection` and `LayoutCache`).
     struct ShaderInputLayout {
         std::vector<vk::PushConstantRange>   push_constant_ranges;
         std::vector<vk::DescriptorSetLayout> descriptor_set_layouts;
+
+        [[nodiscard]] inline bool empty() const { return push_constant_ranges.empty() && descriptor_set_layouts.empty(); }
     };
 
     struct ShaderInfo {
-        vk::ShaderStageFlagBits      stage;
-        vk::ShaderStageFlags         nextStage;
-        std::string                  name;
-        const std::vector<uint32_t> &code;
-        const ShaderInputLayout     &sil;
+        vk::ShaderStageFlagBits   stage;
+        vk::ShaderStageFlags      nextStage;
+        std::string               name;
+        std::span<const uint32_t> code;
+        const ShaderInputLayout  &sil;
     };
 
     class Shader;
@@ -38,6 +43,7 @@ namespace engine {
 
 
         void bindTo(const vk::raii::CommandBuffer &cmd) const;
+        void bindTo(CommandState &state) const;
     };
 
     class Shader {
@@ -52,13 +58,16 @@ namespace engine {
         inline const vk::raii::ShaderEXT &handle() const { return m_Shader; }
 
         static void bindNull(const vk::raii::CommandBuffer &cmd);
+        static void bindNull(CommandState &state);
         static void setGenericState(const vk::raii::CommandBuffer& cmd);
+        static void setGenericState(CommandState &state); // only records the states that differ from what the tracker has seen
 
         static std::vector<uint32_t> load_code(const std::filesystem::path &path);
 
         inline vk::ShaderStageFlagBits stage() const { return m_Stage; };
 
         void bindTo(const vk::raii::CommandBuffer &cmd) const;
+        void bindTo(CommandState &state) const;
 
       private:
         std::shared_ptr<RenderDevice> m_RenderDevice;
@@ -0,0 +1,383 @@
+#include "shader_reflection.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace engine {
+    namespace {
+        constexpr uint32_t SPIRV_MAGIC        = 0x07230203;
+        constexpr uint32_t SPIRV_HEADER_WORDS = 5;
+
+        // The handful of opcodes, decorations and enumerants from the SPIR-V specification that reflection needs.
+        enum Op : uint16_t {
+            OpEntryPoint                   = 15,
+            OpTypeBool                     = 20,
+            OpTypeInt                      = 21,
+            OpTypeFloat                    = 22,
+            OpTypeVector                   = 23,
+            OpTypeMatrix                   = 24,
+            OpTypeImage                    = 25,
+            OpTypeSampler                  = 26,
+            OpTypeSampledImage             = 27,
+            OpTypeArray                    = 28,
+            OpTypeRuntimeArray             = 29,
+            OpTypeStruct                   = 30,
+            OpTypePointer                  = 32,
+            OpConstant                     = 43,
+            OpSpecConstant                 = 50,
+            OpVariable                     = 59,
+            OpDecorate                     = 71,
+            OpMemberDecorate               = 72,
+            OpTypeAccelerationStructureKHR = 5341,
+        };
+
+        enum Decoration : uint32_t {
+            DecorationBlock         = 2,
+            DecorationBufferBlock   = 3,
+            DecorationArrayStride   = 6,
+            DecorationMatrixStride  = 7,
+            DecorationBinding       = 33,
+            DecorationDescriptorSet = 34,
+            DecorationOffset        = 35,
+        };
+
+        enum StorageClass : uint32_t {
+            StorageClassUniformConstant = 0,
+            StorageClassUniform         = 2,
+            StorageClassPushConstant    = 9,
+            StorageClassStorageBuffer   = 12,
+        };
+
+        constexpr uint32_t DIM_BUFFER       = 5;
+        constexpr uint32_t DIM_SUBPASS_DATA = 6;
+        constexpr uint32_t IMAGE_STORAGE    = 2; // `Sampled` operand of OpTypeImage for images used without a sampler
+
+        vk::ShaderStageFlagBits stageFromExecutionModel(const uint32_t model) {
+            switch (model) {
+            case 0:
+                return vk::ShaderStageFlagBits::eVertex;
+            case 1:
+                return vk::ShaderStageFlagBits::eTessellationControl;
+            case 2:
+                return vk::ShaderStageFlagBits::eTessellationEvaluation;
+            case 3:
+                return vk::ShaderStageFlagBits::eGeometry;
+            case 4:
+                return vk::ShaderStageFlagBits::eFragment;
+            case 5:
+                return vk::ShaderStageFlagBits::eCompute;
+            case 5364:
+                return vk::ShaderStageFlagBits::eTaskEXT;
+            case 5365:
+                return vk::ShaderStageFlagBits::eMeshEXT;
+            default:
+                throw std::invalid_argument("ShaderReflection::reflect(): Unsupported execution model " + std::to_string(model));
+            }
+        }
+
+        struct MemberLayout {
+            uint32_t offset       = 0;
+            uint32_t matrixStride = 0;
+        };
+
+        struct IdInfo {
+            uint16_t opcode      = 0;
+            uint32_t position    = 0; // word index of the defining instruction
+            uint32_t set         = 0;
+            uint32_t binding     = UINT32_MAX;
+            uint32_t arrayStride = 0;
+            bool     bufferBlock = false;
+        };
+
+        struct Variable {
+            uint32_t pointerType;
+            uint32_t id;
+            uint32_t storageClass;
+        };
+
+        // Indexes the type, constant and decoration instructions of a module by result id so types can be walked after the single pass.
+        class Module {
+          public:
+            explicit Module(const std::span<const uint32_t> code) : m_Code(code) {
+                if (code.size() < SPIRV_HEADER_WORDS || code[0] != SPIRV_MAGIC) {
+                    throw std::invalid_argument("ShaderReflection::reflect(): Not a SPIR-V module");
+                }
+                m_Ids.resize(code[3]);
+
+                for (uint32_t position = SPIRV_HEADER_WORDS; position < code.size();) {
+                    const uint32_t word_count = code[position] >> 16;
+                    const auto     opcode     = static_cast<uint16_t>(code[position] & 0xFFFF);
+                    if (word_count == 0 || position + word_count > code.size()) {
+                        throw std::invalid_argument("ShaderReflection::reflect(): Truncated instruction at word " + std::to_string(position));
+                    }
+
+                    const auto operands = code.subspan(position + 1, word_count - 1);
+                    switch (opcode) {
+                    case OpEntryPoint:
+                        if (!m_Stage) {
+                            m_Stage = stageFromExecutionModel(operands[0]);
+                        }
+                        break;
+                    case OpTypeBool:
+                    case OpTypeInt:
+                    case OpTypeFloat:
+                    case OpTypeVector:
+                    case OpTypeMatrix:
+                    case OpTypeImage:
+                    case OpTypeSampler:
+                    case OpTypeSampledImage:
+                    case OpTypeArray:
+                    case OpTypeRuntimeArray:
+                    case OpTypeStruct:
+                    case OpTypePointer:
+                    case OpTypeAccelerationStructureKHR:
+                        define(operands[0], opcode, position);
+                        break;
+                    case OpConstant:
+                    case OpSpecConstant:
+                        define(operands[1], opcode, position);
+                        break;
+                    case OpVariable:
+                        m_Variables.push_back({operands[0], operands[1], operands[2]});
+                        break;
+                    case OpDecorate:
+                        decorate(id(operands[0]), operands[1], operands.size() > 2 ? operands[2] : 0);
+                        break;
+                    case OpMemberDecorate:
+                        if (operands[2] == DecorationOffset || operands[2] == DecorationMatrixStride) {
+                            auto &members = m_Members[operands[0]];
+                            if (members.size() <= operands[1]) {
+                                members.resize(operands[1] + 1);
+                            }
+                            (operands[2] == DecorationOffset ? members[operands[1]].offset : members[operands[1]].matrixStride) = operands[3];
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+
+                    position += word_count;
+                }
+
+                if (!m_Stage) {
+                    throw std::invalid_argument("ShaderReflection::reflect(): Module has no entry point");
+                }
+            }
+
+            [[nodiscard]] vk::ShaderStageFlagBits      stage() const { return *m_Stage; }
+            [[nodiscard]] const std::vector<Variable> &variables() const { return m_Variables; }
+            [[nodiscard]] const IdInfo                &info(const uint32_t id) const { return m_Ids.at(id); }
+
+            // Operand `index` of the instruction defining `id`, not counting the opcode word.
+            [[nodiscard]] uint32_t operand(const uint32_t id, const uint32_t index) const { return m_Code[info(id).position + 1 + index]; }
+            [[nodiscard]] uint32_t operandCount(const uint32_t id) const { return (m_Code[info(id).position] >> 16) - 1; }
+
+            [[nodiscard]] uint32_t constant(const uint32_t id) const {
+                if (const auto opcode = info(id).opcode; opcode != OpConstant && opcode != OpSpecConstant) {
+                    throw std::invalid_argument("ShaderReflection::reflect(): Array length is not a constant");
+                }
+                return operand(id, 2);
+            }
+
+            // Byte size of a type inside an explicitly laid out block. Matrices and arrays use their decorated strides.
+            [[nodiscard]] uint32_t size(const uint32_t type, const uint32_t matrix_stride = 0) const {
+                switch (info(type).opcode) {
+                case OpTypeBool:
+                    return 4;
+                case OpTypeInt:
+                case OpTypeFloat:
+                    return operand(type, 1) / 8;
+                case OpTypeVector:
+                    return operand(type, 2) * size(operand(type, 1));
+                case OpTypeMatrix:
+                    return operand(type, 2) * (matrix_stride != 0 ? matrix_stride : size(operand(type, 1)));
+                case OpTypeArray: {
+                    const uint32_t stride = info(type).arrayStride;
+                    return constant(operand(type, 2)) * (stride != 0 ? stride : size(operand(type, 1), matrix_stride));
+                }
+                case OpTypeRuntimeArray:
+                    return 0;
+                case OpTypeStruct:
+                    return structEnd(type);
+                case OpTypePointer: // buffer references
+                    return 8;
+                default:
+                    throw std::invalid_argument("ShaderReflection::reflect(): Type without a size inside a block");
+                }
+            }
+
+            [[nodiscard]] uint32_t structBegin(const uint32_t type) const {
+                const auto members = m_Members.find(type);
+                if (members == m_Members.end() || members->second.empty()) {
+                    return 0;
+                }
+                return std::ranges::min(members->second, {}, &MemberLayout::offset).offset;
+            }
+
+            [[nodiscard]] uint32_t structEnd(const uint32_t type) const {
+                const auto members = m_Members.find(type);
+                uint32_t   end     = 0;
+                for (uint32_t i = 0; i < operandCount(type) - 1; i++) {
+                    const MemberLayout layout = members != m_Members.end() && i < members->second.size() ? members->second[i] : MemberLayout{};
+                    end                       = std::max(end, layout.offset + size(operand(type, 1 + i), layout.matrixStride));
+                }
+                return end;
+            }
+
+          private:
+            [[nodiscard]] IdInfo &id(const uint32_t id) {
+                if (id >= m_Ids.size()) {
+                    throw std::invalid_argument("ShaderReflection::reflect(): Id " + std::to_string(id) + " is out of the module's bound");
+                }
+                return m_Ids[id];
+            }
+
+            void define(const uint32_t result, const uint16_t opcode, const uint32_t position) {
+                auto &info    = id(result);
+                info.opcode   = opcode;
+                info.position = position;
+            }
+
+            static void decorate(IdInfo &info, const uint32_t decoration, const uint32_t value) {
+                switch (decoration) {
+                case DecorationBufferBlock:
+                    info.bufferBlock = true;
+                    break;
+                case DecorationArrayStride:
+                    info.arrayStride = value;
+                    break;
+                case DecorationBinding:
+                    info.binding = value;
+                    break;
+                case DecorationDescriptorSet:
+                    info.set = value;
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            std::span<const uint32_t>                               m_Code;
+            std::vector<IdInfo>                                     m_Ids;
+            std::unordered_map<uint32_t, std::vector<MemberLayout>> m_Members;
+            std::vector<Variable>                                   m_Variables;
+            std::optional<vk::ShaderStageFlagBits>                  m_Stage;
+        };
+
+        vk::DescriptorType descriptorType(const Module &module, const uint32_t type, const uint32_t storage_class) {
+            switch (storage_class) {
+            case StorageClassUniform:
+                return module.info(type).bufferBlock ? vk::DescriptorType::eStorageBuffer : vk::DescriptorType::eUniformBuffer;
+            case StorageClassStorageBuffer:
+                return vk::DescriptorType::eStorageBuffer;
+            default:
+                break;
+            }
+
+            switch (module.info(type).opcode) {
+            case OpTypeSampler:
+                return vk::DescriptorType::eSampler;
+            case OpTypeSampledImage:
+                return module.operand(module.operand(type, 1), 2) == DIM_BUFFER ? vk::DescriptorType::eUniformTexelBuffer : vk::DescriptorType::eCombinedImageSampler;
+            case OpTypeImage: {
+                const bool storage = module.operand(type, 6) == IMAGE_STORAGE;
+                switch (module.operand(type, 2)) {
+                case DIM_BUFFER:
+                    return storage ? vk::DescriptorType::eStorageTexelBuffer : vk::DescriptorType::eUniformTexelBuffer;
+                case DIM_SUBPASS_DATA:
+                    return vk::DescriptorType::eInputAttachment;
+                default:
+                    return storage ? vk::DescriptorType::eStorageImage : vk::DescriptorType::eSampledImage;
+                }
+            }
+            case OpTypeAccelerationStructureKHR:
+                return vk::DescriptorType::eAccelerationStructureKHR;
+            default:
+                throw std::invalid_argument("ShaderReflection::reflect(): Unsupported uniform constant type");
+            }
+        }
+
+        constexpr auto bindingOrder = [](const ReflectedBinding &binding) { return std::pair(binding.set, binding.binding); };
+    } // namespace
+
+    ShaderReflection ShaderReflection::reflect(const std::span<const uint32_t> code) {
+        const Module module(code);
+
+        ShaderReflection reflection{.stages = module.stage()};
+        for (const auto &[pointer_type, id, storage_class] : module.variables()) {
+            if (storage_class != StorageClassUniformConstant && storage_class != StorageClassUniform && storage_class != StorageClassStorageBuffer &&
+                storage_class != StorageClassPushConstant) {
+                continue;
+            }
+
+            uint32_t type = module.operand(pointer_type, 2);
+
+            if (storage_class == StorageClassPushConstant) {
+                const uint32_t begin      = module.structBegin(type);
+                reflection.pushConstants = vk::PushConstantRange(module.stage(), begin, module.structEnd(type) - begin);
+                continue;
+            }
+
+            const auto &variable = module.info(id);
+            if (variable.binding == UINT32_MAX) {
+                continue;
+            }
+
+            uint32_t count = 1;
+            for (;;) {
+                if (const auto opcode = module.info(type).opcode; opcode == OpTypeArray) {
+                    count *= module.constant(module.operand(type, 2));
+                } else if (opcode == OpTypeRuntimeArray) {
+                    count = 0;
+                } else {
+                    break;
+                }
+                type = module.operand(type, 1);
+            }
+
+            reflection.bindings.push_back({variable.set, variable.binding, descriptorType(module, type, storage_class), count, module.stage()});
+        }
+
+        std::ranges::sort(reflection.bindings, {}, bindingOrder);
+        return reflection;
+    }
+
+    void ShaderReflection::merge(const ShaderReflection &other) {
+        stages |= other.stages;
+
+        if (other.pushConstants) {
+            if (pushConstants) {
+                const uint32_t begin = std::min(pushConstants->offset, other.pushConstants->offset);
+                const uint32_t end   = std::max(pushConstants->offset + pushConstants->size, other.pushConstants->offset + other.pushConstants->size);
+                pushConstants        = vk::PushConstantRange(pushConstants->stageFlags | other.pushConstants->stageFlags, begin, end - begin);
+            } else {
+                pushConstants = other.pushConstants;
+            }
+        }
+
+        for (const auto &binding : other.bindings) {
+            const auto existing = std::ranges::find(bindings, bindingOrder(binding), bindingOrder);
+            if (existing == bindings.end()) {
+                bindings.push_back(binding);
+                continue;
+            }
+
+            if (existing->type != binding.type) {
+                throw std::invalid_argument(
+                    "ShaderReflection::merge(): Set " + std::to_string(binding.set) + " binding " + std::to_string(binding.binding) + " is declared as both " +
+                    vk::to_string(existing->type) + " and " + vk::to_string(binding.type)
+                );
+            }
+            existing->count = existing->count == 0 || binding.count == 0 ? 0 : std::max(existing->count, binding.count);
+            existing->stages |= binding.stages;
+        }
+
+        std::ranges::sort(bindings, {}, bindingOrder);
+    }
+
+    uint32_t ShaderReflection::setCount() const {
+        return bindings.empty() ? 0 : bindings.back().set + 1;
+    }
+} // namespace engine
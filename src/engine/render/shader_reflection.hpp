@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+    struct ReflectedBinding {
+        uint32_t             set;
+        uint32_t             binding;
+        vk::DescriptorType   type;
+        uint32_t             count; // 0 for unsized (runtime) arrays
+        vk::ShaderStageFlags stages;
+    };
+
+    // Resource interface of one or more shader stages, read straight from SPIR-V.
+    // Only the parts a layout needs are decoded: the entry point's stage, descriptor bindings and the push constant block.
+    struct ShaderReflection {
+        vk::ShaderStageFlags                 stages;
+        std::optional<vk::PushConstantRange> pushConstants;
+        std::vector<ReflectedBinding>        bindings; // sorted by (set, binding)
+
+        // Throws std::invalid_argument on malformed modules, modules without an entry point and descriptor types that cannot be derived from the module.
+        static ShaderReflection reflect(std::span<const uint32_t> code);
+
+        // Folds another stage in: bindings are unioned (stage flags or'd together), push constant ranges become one range covering both.
+        // Throws std::invalid_argument when both stages declare the same binding with different types.
+        void merge(const ShaderReflection &other);
+
+        // Number of descriptor sets a layout needs, i.e. highest set index + 1.
+        [[nodiscard]] uint32_t setCount() const;
+    };
+
+} // namespace engine
@@ -0,0 +1,174 @@
+#include "sprite_batcher.hpp"
+
+#include "engine/render/layout_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace engine {
+    namespace {
+        constexpr vk::ShaderStageFlags SPRITE_PUSH_CONSTANT_STAGES = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment;
+        // bytes actually pushed, without the struct's tail padding which reflected ranges don't include
+        constexpr uint32_t SPRITE_PUSH_CONSTANT_SIZE = offsetof(SpritePushConstants, texture) + sizeof(uint32_t);
+
+        constexpr uint64_t spriteKey(const uint16_t layer, const uint16_t shader, const uint32_t texture) {
+            return static_cast<uint64_t>(layer) << 48 | static_cast<uint64_t>(shader) << 32 | texture;
+        }
+    } // namespace
+
+    uint32_t Sprite::packColor(const glm::vec4 &color) {
+        const auto channel = [](const float c) { return static_cast<uint32_t>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return channel(color.x) | channel(color.y) << 8 | channel(color.z) << 16 | channel(color.w) << 24;
+    }
+
+    SpriteBatcher::SpriteBatcher(const std::shared_ptr<RenderDevice> &render_device, const uint32_t max_sprites)
+        : m_RenderDevice(render_device),
+          m_Layout(m_RenderDevice->layoutCache().pipelineLayout(shaderInputLayout())),
+          m_RegionSize((sizeof(Sprite) * max_sprites + 255) & ~vk::DeviceSize{255}), m_MaxSprites(max_sprites) {
+        if (max_sprites == 0) {
+            throw std::invalid_argument("SpriteBatcher::SpriteBatcher(): max_sprites must be greater than zero");
+        }
+
+        auto [buffer, info] = m_RenderDevice->createBuffer(
+            m_RegionSize * MAX_FRAMES_IN_FLIGHT, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress, MemoryUsage::AutoPreferDevice,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        );
+        m_Buffer        = std::move(buffer);
+        m_Mapped        = static_cast<std::byte *>(info.pMappedData);
+        m_BufferAddress = m_RenderDevice->bufferAddress(m_Buffer);
+    }
+
+    ShaderInputLayout SpriteBatcher::shaderInputLayout() {
+        return ShaderInputLayout{.push_constant_ranges = {vk::PushConstantRange(SPRITE_PUSH_CONSTANT_STAGES, 0, sizeof(SpritePushConstants))}};
+    }
+
+    void SpriteBatcher::draw(const Sprite &sprite, const MaterialShader &shader, const uint32_t texture, const uint16_t layer) {
+        if (m_Sprites.size() >= m_MaxSprites) {
+            throw std::out_of_range("SpriteBatcher::draw(): Sprite count exceeds the capacity given at construction");
+        }
+
+        // consecutive sprites almost always share a shader, so check the most recent one before searching
+        uint16_t shader_id;
+        if (!m_Shaders.empty() && m_Shaders.back().shader == &shader) {
+            shader_id = static_cast<uint16_t>(m_Shaders.size() - 1);
+        } else if (const auto it = std::ranges::find(m_Shaders, &shader, &BatchShader::shader); it != m_Shaders.end()) {
+            shader_id = static_cast<uint16_t>(it - m_Shaders.begin());
+        } else {
+            // ids are 16 bits of the sort key
+            if (m_Shaders.size() > std::numeric_limits<uint16_t>::max()) {
+                throw std::length_error("SpriteBatcher::draw(): Too many distinct shaders in one batch");
+            }
+            shader_id = static_cast<uint16_t>(m_Shaders.size());
+            m_Shaders.push_back(batchShader(shader));
+        }
+
+        m_Sprites.push_back(sprite);
+        m_Keys.push_back(spriteKey(layer, shader_id, texture));
+    }
+
+    void SpriteBatcher::draw(const Sprite &sprite, const MaterialShader &shader, const AtlasRegion &region, const uint16_t layer) {
+        Sprite remapped = sprite;
+        remapped.uvRect = region.uvRect;
+        draw(remapped, shader, region.texture, layer);
+    }
+
+    void SpriteBatcher::flush(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame, const glm::mat4 &view_projection, const TextureBinder &bind_texture) {
+        m_LastDrawCount = 0;
+        if (m_Sprites.empty()) {
+            return;
+        }
+
+        sortKeys();
+
+        auto *mapped = reinterpret_cast<Sprite *>(m_Mapped + m_RegionSize * current_frame);
+        for (std::size_t i = 0; i < m_Order.size(); i++) {
+            mapped[i] = m_Sprites[m_Order[i]];
+        }
+        m_Buffer.allocation->flush(m_RegionSize * current_frame, sizeof(Sprite) * m_Order.size());
+
+        // no vertex streams, sprite.vert pulls everything from the storage buffer
+        cmd.setVertexInputEXT({}, {});
+
+        SpritePushConstants push_constants{
+            .viewProjection = view_projection,
+            .sprites        = m_BufferAddress + m_RegionSize * current_frame,
+            .texture        = 0,
+        };
+
+        uint64_t           bound_shader  = UINT64_MAX;
+        uint64_t           bound_texture = UINT64_MAX;
+        vk::PipelineLayout bound_layout  = nullptr;
+        for (std::size_t begin = 0; begin < m_Keys.size();) {
+            const uint64_t key = m_Keys[begin];
+            std::size_t    end = begin + 1;
+            while (end < m_Keys.size() && m_Keys[end] == key) {
+                end++;
+            }
+
+            const auto     shader  = static_cast<uint16_t>(key >> 32);
+            const uint32_t texture = static_cast<uint32_t>(key);
+            const auto    &batch   = m_Shaders[shader];
+
+            if (shader != bound_shader) {
+                batch.shader->bindTo(cmd);
+                bound_shader = shader;
+            }
+            if (texture != bound_texture || batch.layout != bound_layout) {
+                if (bind_texture) {
+                    bind_texture(cmd, texture);
+                }
+                bound_texture = texture;
+            }
+            if (batch.layout != bound_layout) {
+                // push constants don't carry over to another layout
+                push_constants.texture = texture;
+                cmd.pushConstants(batch.layout, batch.stages, 0, vk::ArrayProxy<const std::byte>(SPRITE_PUSH_CONSTANT_SIZE, reinterpret_cast<const std::byte *>(&push_constants)));
+                bound_layout = batch.layout;
+            } else if (texture != push_constants.texture) {
+                push_constants.texture = texture;
+                cmd.pushConstants<uint32_t>(batch.layout, batch.stages, offsetof(SpritePushConstants, texture), texture);
+            }
+
+            cmd.draw(static_cast<uint32_t>((end - begin) * 6), 1, static_cast<uint32_t>(begin * 6), 0);
+            m_LastDrawCount++;
+            begin = end;
+        }
+
+        m_Sprites.clear();
+        m_Keys.clear();
+        m_Shaders.clear();
+    }
+
+    SpriteBatcher::BatchShader SpriteBatcher::batchShader(const MaterialShader &shader) const {
+        if (!shader.layout()) {
+            return {&shader, m_Layout, SPRITE_PUSH_CONSTANT_STAGES};
+        }
+
+        // every range touching the pushed bytes has to hold all of them, the push then uses the union of their stages
+        vk::ShaderStageFlags stages;
+        for (const auto &range : shader.inputLayout().push_constant_ranges) {
+            if (range.offset >= SPRITE_PUSH_CONSTANT_SIZE) {
+                continue;
+            }
+            if (range.offset != 0 || range.size < SPRITE_PUSH_CONSTANT_SIZE) {
+                throw std::invalid_argument("SpriteBatcher::draw(): Shader's push constant range does not cover SpritePushConstants");
+            }
+            stages |= range.stageFlags;
+        }
+        if (!stages) {
+            throw std::invalid_argument("SpriteBatcher::draw(): Shader has no push constant range for SpritePushConstants");
+        }
+        return {&shader, shader.layout(), stages};
+    }
+
+    void SpriteBatcher::sortKeys() {
+        m_Order.resize(m_Keys.size());
+        for (std::size_t i = 0; i < m_Order.size(); i++) {
+            m_Order[i] = static_cast<uint32_t>(i);
+        }
+        // stable, so equal keys keep submission order
+        radixSort(m_Keys, m_Order, m_SortScratch);
+    }
+} // namespace engine
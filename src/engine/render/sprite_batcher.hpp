@@ -0,0 +1,96 @@
+#pragma once
+
+#include "engine/assets/atlas_packer.hpp"
+#include "engine/radix_sort.hpp"
+#include "engine/render/frame_renderer.hpp"
+#include "engine/render/material.hpp"
+#include "engine/render/shader_object.hpp"
+#include "engine/render_device.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <functional>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Layout mirrors the std430 struct in `assets/shaders/sprite.vert`.
+    struct Sprite {
+        glm::vec2 position;
+        glm::vec2 size;
+        glm::vec2 origin   = {0.5f, 0.5f}; // pivot for placement and rotation, in [0, 1] over the quad
+        float     rotation = 0.0f;         // radians
+        uint32_t  color    = 0xFFFFFFFF;   // RGBA8, see `packColor`
+        glm::vec4 uvRect   = {0.0f, 0.0f, 1.0f, 1.0f}; // min uv, max uv
+
+        static uint32_t packColor(const glm::vec4 &color);
+    };
+    static_assert(sizeof(Sprite) == 48);
+
+    // Push constants expected by `sprite.vert`. Shaders drawn through the batcher either declare them like `sprite.vert` and reflect their layout,
+    // or are created with `SpriteBatcher::shaderInputLayout()`.
+    struct SpritePushConstants {
+        glm::mat4         viewProjection;
+        vk::DeviceAddress sprites;
+        uint32_t          texture;
+    };
+
+    // Collects sprites for a frame and draws them with as few draw calls as possible.
+    // On flush sprites are radix sorted by (layer, shader, texture), written in that order into the current frame's region of a persistently mapped buffer,
+    // and every run sharing shader and texture becomes a single non-indexed draw with the vertex shader pulling quads from the buffer by gl_VertexIndex.
+    // Layers draw back to front in increasing order; inside a layer submission order is only kept between sprites sharing shader and texture.
+    class SpriteBatcher {
+      public:
+        // Called whenever the texture changes between runs, e.g. to bind a descriptor set. The texture is also pushed as `SpritePushConstants::texture`.
+        using TextureBinder = std::function<void(const vk::raii::CommandBuffer &cmd, uint32_t texture)>;
+
+        SpriteBatcher(const std::shared_ptr<RenderDevice> &render_device, uint32_t max_sprites);
+
+        static ShaderInputLayout shaderInputLayout();
+
+        // The shader must outlive the next `flush`. Throws once more than `maxSprites` sprites are queued, and std::invalid_argument
+        // when the shader's push constant ranges don't cover SpritePushConstants.
+        void draw(const Sprite &sprite, const MaterialShader &shader, uint32_t texture = 0, uint16_t layer = 0);
+        // Draws an atlas image: the region replaces the sprite's uvRect and its page's texture id is used.
+        void draw(const Sprite &sprite, const MaterialShader &shader, const AtlasRegion &region, uint16_t layer = 0);
+
+        // Records the draws for everything queued since the last flush and clears the queue. Must be recorded inside rendering,
+        // at most once per frame since every flush writes the start of the frame's region.
+        void flush(const vk::raii::CommandBuffer &cmd, uint32_t current_frame, const glm::mat4 &view_projection, const TextureBinder &bind_texture = {});
+
+        [[nodiscard]] inline std::size_t size() const { return m_Sprites.size(); }
+        [[nodiscard]] inline uint32_t    maxSprites() const { return m_MaxSprites; }
+        [[nodiscard]] inline uint32_t    lastDrawCount() const { return m_LastDrawCount; }
+
+      private:
+        // Push constants go through each material's own pipeline layout, with the stages of its ranges, since reflected layouts differ from
+        // `shaderInputLayout()` (e.g. vertex only). Materials without a layout use the batcher's.
+        struct BatchShader {
+            const MaterialShader *shader;
+            vk::PipelineLayout    layout;
+            vk::ShaderStageFlags  stages;
+        };
+
+        [[nodiscard]] BatchShader batchShader(const MaterialShader &shader) const;
+        void                      sortKeys();
+
+        std::shared_ptr<RenderDevice> m_RenderDevice;
+        vk::PipelineLayout            m_Layout;
+
+        RawBuffer         m_Buffer{nullptr};
+        std::byte        *m_Mapped = nullptr;
+        vk::DeviceAddress m_BufferAddress{};
+        vk::DeviceSize    m_RegionSize;
+        uint32_t          m_MaxSprites;
+
+        std::vector<Sprite>                 m_Sprites;
+        std::vector<uint64_t>               m_Keys;
+        std::vector<uint32_t>               m_Order;
+        RadixSortScratch                    m_SortScratch;
+        std::vector<BatchShader>            m_Shaders; // shader ids of the current batch, index into this
+        uint32_t                            m_LastDrawCount = 0;
+    };
+
+} // namespace engine
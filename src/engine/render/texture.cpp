@@ -0,0 +1,333 @@
+#include "texture.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+
+namespace engine {
+    namespace {
+        constexpr vk::DeviceSize STAGING_ALIGNMENT = 16;
+
+        constexpr auto SAMPLED = std::tuple{vk::ImageLayout::eShaderReadOnlyOptimal, vk::PipelineStageFlagBits2::eAllCommands, vk::AccessFlags2(vk::AccessFlagBits2::eShaderSampledRead), vk::QueueFamilyIgnored};
+
+        vk::ImageSubresourceRange levels(const uint32_t base, const uint32_t count) {
+            return {vk::ImageAspectFlagBits::eColor, base, count, 0, 1};
+        }
+
+        bool isBlockCompressed(const vk::Format format) {
+            return format >= vk::Format::eBc1RgbUnormBlock && format <= vk::Format::eBc7SrgbBlock;
+        }
+
+        bool canSample(const RenderDevice &device, const vk::Format format) {
+            const auto features = device.physicalDevice().getFormatProperties(format).optimalTilingFeatures;
+            return (features & vk::FormatFeatureFlagBits::eSampledImage) && (!isBlockCompressed(format) || device.supportsBlockCompression());
+        }
+    } // namespace
+
+    DecodedTexture DecodedTexture::decode(const std::span<const std::byte> file, const TextureOptions &options) {
+        if (!TextureFile::matches(file)) {
+            return fromImage(TextureImage::decode(file), options);
+        }
+
+        const TextureFile cooked(file);
+        const uint64_t    first = cooked.level(0).offset;
+
+        DecodedTexture texture;
+        texture.desc.format    = textureFormat(cooked.format(), cooked.srgb());
+        texture.desc.extent    = vk::Extent2D(cooked.width(), cooked.height());
+        texture.desc.mipLevels = cooked.mipLevels();
+        for (uint32_t level = 0; level < cooked.mipLevels(); level++) {
+            texture.desc.levelOffsets.push_back(cooked.level(level).offset - first);
+        }
+        const auto levels = file.subspan(first);
+        texture.data.assign(levels.begin(), levels.end());
+        return texture;
+    }
+
+    DecodedTexture DecodedTexture::fromImage(TextureImage image, const TextureOptions &options) {
+        DecodedTexture texture;
+        texture.desc.format    = options.format;
+        texture.desc.extent    = vk::Extent2D(image.width, image.height);
+        texture.desc.mipLevels = options.mipmaps ? mipLevelCount(image.width, image.height) : 1;
+        texture.data           = std::move(image.pixels);
+        return texture;
+    }
+
+    vk::Format textureFormat(const BlockFormat format, const bool srgb) {
+        switch (format) {
+        case BlockFormat::BC1:
+            return srgb ? vk::Format::eBc1RgbSrgbBlock : vk::Format::eBc1RgbUnormBlock;
+        case BlockFormat::BC3:
+            return srgb ? vk::Format::eBc3SrgbBlock : vk::Format::eBc3UnormBlock;
+        case BlockFormat::BC4:
+            return vk::Format::eBc4UnormBlock;
+        case BlockFormat::BC5:
+            return vk::Format::eBc5UnormBlock;
+        case BlockFormat::BC7:
+            return srgb ? vk::Format::eBc7SrgbBlock : vk::Format::eBc7UnormBlock;
+        }
+        throw std::invalid_argument("textureFormat(): Unknown block format");
+    }
+
+    vk::raii::Sampler createSampler(const RenderDevice &device, const vk::Filter filter, const vk::SamplerAddressMode address_mode) {
+        vk::SamplerCreateInfo sci{};
+        sci.magFilter    = filter;
+        sci.minFilter    = filter;
+        sci.mipmapMode   = filter == vk::Filter::eNearest ? vk::SamplerMipmapMode::eNearest : vk::SamplerMipmapMode::eLinear;
+        sci.addressModeU = address_mode;
+        sci.addressModeV = address_mode;
+        sci.addressModeW = address_mode;
+        sci.maxLod       = vk::LodClampNone;
+        return vk::raii::Sampler(device.device(), sci);
+    }
+
+    Texture::Texture(const std::shared_ptr<RenderDevice> &device) : m_RenderDevice(device) {}
+
+    Texture::Texture(const std::shared_ptr<RenderDevice> &device, const TextureDesc &desc) : Texture(device) {
+        create(desc);
+    }
+
+    Texture::Texture(const std::shared_ptr<RenderDevice> &device, const uint32_t width, const uint32_t height, const TextureOptions &options)
+        : Texture(device, TextureDesc{options.format, vk::Extent2D(width, height), options.mipmaps ? mipLevelCount(width, height) : 1, {}}) {}
+
+    void Texture::create(const TextureDesc &desc) {
+        if (desc.extent.width == 0 || desc.extent.height == 0 || desc.mipLevels == 0) {
+            throw std::invalid_argument("Texture::create(): Texture must not be empty");
+        }
+        if (!desc.levelOffsets.empty() && desc.levelOffsets.size() != desc.mipLevels) {
+            throw std::invalid_argument("Texture::create(): Every prebuilt level needs an offset");
+        }
+
+        if (!canSample(*m_RenderDevice, desc.format)) {
+            throw std::runtime_error("Texture::create(): Format can not be sampled on this device");
+        }
+        const auto features = m_RenderDevice->physicalDevice().getFormatProperties(desc.format).optimalTilingFeatures;
+
+        m_Desc = desc;
+        // blits between levels need linear filtering support for the format, every desktop driver has it for RGBA8
+        const bool generate = m_Desc.levelOffsets.empty() && m_Desc.mipLevels > 1;
+        if (generate && !((features & vk::FormatFeatureFlagBits::eBlitSrc) && (features & vk::FormatFeatureFlagBits::eBlitDst) &&
+                          (features & vk::FormatFeatureFlagBits::eSampledImageFilterLinear))) {
+            m_Desc.mipLevels = 1;
+        }
+
+        auto [image, _] = m_RenderDevice->createImage(
+            vk::Extent3D(m_Desc.extent.width, m_Desc.extent.height, 1), m_Desc.format,
+            vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc, false, false, MemoryUsage::AutoPreferDevice, 0, {},
+            m_Desc.mipLevels
+        );
+        m_Image = std::move(image);
+
+        vk::ImageViewCreateInfo ivci{};
+        ivci.image            = *m_Image.image;
+        ivci.viewType         = vk::ImageViewType::e2D;
+        ivci.format           = m_Desc.format;
+        ivci.subresourceRange = levels(0, m_Desc.mipLevels);
+        m_View                = vk::raii::ImageView(m_RenderDevice->device(), ivci);
+        m_Ready               = false;
+    }
+
+    void Texture::recordUpload(const vk::raii::CommandBuffer &cmd, const RawBuffer &staging, const vk::DeviceSize offset) {
+        const uint32_t mip_levels = m_Desc.mipLevels;
+        imageTransition(
+            cmd, *m_Image.image, levels(0, mip_levels), {vk::ImageLayout::eUndefined, vk::PipelineStageFlagBits2::eAllCommands, vk::AccessFlagBits2::eNone, vk::QueueFamilyIgnored},
+            {vk::ImageLayout::eTransferDstOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::QueueFamilyIgnored}
+        );
+
+        if (!m_Desc.levelOffsets.empty()) {
+            std::vector<vk::BufferImageCopy> regions(mip_levels);
+            for (uint32_t level = 0; level < mip_levels; level++) {
+                regions[level].bufferOffset     = offset + m_Desc.levelOffsets[level];
+                regions[level].imageSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, level, 0, 1);
+                regions[level].imageExtent      = vk::Extent3D(std::max(m_Desc.extent.width >> level, 1u), std::max(m_Desc.extent.height >> level, 1u), 1);
+            }
+            cmd.copyBufferToImage(*staging.buffer, *m_Image.image, vk::ImageLayout::eTransferDstOptimal, regions);
+
+            imageTransition(
+                cmd, *m_Image.image, levels(0, mip_levels),
+                {vk::ImageLayout::eTransferDstOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::QueueFamilyIgnored}, SAMPLED
+            );
+            m_Ready = true;
+            return;
+        }
+
+        vk::BufferImageCopy region{};
+        region.bufferOffset     = offset;
+        region.imageSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1);
+        region.imageExtent      = vk::Extent3D(m_Desc.extent.width, m_Desc.extent.height, 1);
+        cmd.copyBufferToImage(*staging.buffer, *m_Image.image, vk::ImageLayout::eTransferDstOptimal, region);
+
+        generateMips(cmd, vk::Rect2D({0, 0}, m_Desc.extent));
+        m_Ready = true;
+    }
+
+    void Texture::recordUpdate(const vk::raii::CommandBuffer &cmd, const RawBuffer &staging, const vk::DeviceSize offset, const vk::Rect2D &region) {
+        if (!m_Desc.levelOffsets.empty()) {
+            throw std::logic_error("Texture::recordUpdate(): Prebuilt levels can only be uploaded whole");
+        }
+
+        const auto all = levels(0, m_Desc.mipLevels);
+        if (m_Ready) {
+            imageTransition(
+                cmd, *m_Image.image, all, SAMPLED,
+                {vk::ImageLayout::eTransferDstOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::QueueFamilyIgnored}
+            );
+        } else {
+            imageTransition(
+                cmd, *m_Image.image, all, {vk::ImageLayout::eUndefined, vk::PipelineStageFlagBits2::eAllCommands, vk::AccessFlagBits2::eNone, vk::QueueFamilyIgnored},
+                {vk::ImageLayout::eTransferDstOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::QueueFamilyIgnored}
+            );
+            cmd.clearColorImage(*m_Image.image, vk::ImageLayout::eTransferDstOptimal, vk::ClearColorValue(0.0f, 0.0f, 0.0f, 0.0f), all);
+            imageTransition(
+                cmd, *m_Image.image, all,
+                {vk::ImageLayout::eTransferDstOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::QueueFamilyIgnored},
+                {vk::ImageLayout::eTransferDstOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::QueueFamilyIgnored}
+            );
+        }
+
+        vk::BufferImageCopy copy{};
+        copy.bufferOffset     = offset;
+        copy.imageSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1);
+        copy.imageOffset      = vk::Offset3D(region.offset.x, region.offset.y, 0);
+        copy.imageExtent      = vk::Extent3D(region.extent.width, region.extent.height, 1);
+        cmd.copyBufferToImage(*staging.buffer, *m_Image.image, vk::ImageLayout::eTransferDstOptimal, copy);
+
+        generateMips(cmd, region);
+        m_Ready = true;
+    }
+
+    void Texture::generateMips(const vk::raii::CommandBuffer &cmd, const vk::Rect2D &region) {
+        const uint32_t mip_levels = m_Desc.mipLevels;
+
+        // each level is read by the blit producing the next one, then left in eTransferSrcOptimal. Only the texels whose footprint overlaps
+        // the region are blitted; a region reaching the end of a level takes the odd texel along so partial and full updates match
+        int32_t x0 = region.offset.x, y0 = region.offset.y;
+        int32_t x1 = x0 + static_cast<int32_t>(region.extent.width), y1 = y0 + static_cast<int32_t>(region.extent.height);
+        auto    width  = static_cast<int32_t>(m_Desc.extent.width);
+        auto    height = static_cast<int32_t>(m_Desc.extent.height);
+        for (uint32_t level = 1; level < mip_levels; level++) {
+            imageTransition(
+                cmd, *m_Image.image, levels(level - 1, 1),
+                {vk::ImageLayout::eTransferDstOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::QueueFamilyIgnored},
+                {vk::ImageLayout::eTransferSrcOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferRead, vk::QueueFamilyIgnored}
+            );
+
+            const int32_t next_width  = std::max(width / 2, 1);
+            const int32_t next_height = std::max(height / 2, 1);
+            const int32_t next_x0 = std::min(x0 / 2, next_width - 1), next_y0 = std::min(y0 / 2, next_height - 1);
+            const int32_t next_x1 = std::min((x1 + 1) / 2, next_width), next_y1 = std::min((y1 + 1) / 2, next_height);
+
+            vk::ImageBlit blit{};
+            blit.srcSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, level - 1, 0, 1);
+            blit.srcOffsets[0]  = vk::Offset3D(next_x0 * 2, next_y0 * 2, 0);
+            blit.srcOffsets[1]  = vk::Offset3D(next_x1 == next_width ? width : next_x1 * 2, next_y1 == next_height ? height : next_y1 * 2, 1);
+            blit.dstSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, level, 0, 1);
+            blit.dstOffsets[0]  = vk::Offset3D(next_x0, next_y0, 0);
+            blit.dstOffsets[1]  = vk::Offset3D(next_x1, next_y1, 1);
+            cmd.blitImage(*m_Image.image, vk::ImageLayout::eTransferSrcOptimal, *m_Image.image, vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
+
+            x0     = next_x0;
+            y0     = next_y0;
+            x1     = next_x1;
+            y1     = next_y1;
+            width  = next_width;
+            height = next_height;
+        }
+
+        if (mip_levels > 1) {
+            imageTransition(
+                cmd, *m_Image.image, levels(0, mip_levels - 1),
+                {vk::ImageLayout::eTransferSrcOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferRead, vk::QueueFamilyIgnored}, SAMPLED
+            );
+        }
+        imageTransition(
+            cmd, *m_Image.image, levels(mip_levels - 1, 1),
+            {vk::ImageLayout::eTransferDstOptimal, vk::PipelineStageFlagBits2::eAllTransfer, vk::AccessFlagBits2::eTransferWrite, vk::QueueFamilyIgnored}, SAMPLED
+        );
+    }
+
+    std::shared_ptr<Texture> Texture::load(const std::shared_ptr<RenderDevice> &device, const DecodedTexture &texture) {
+        auto result = std::make_shared<Texture>(device, texture.desc);
+
+        auto [staging, _] = device->createBuffer(texture.data.size(), vk::BufferUsageFlagBits::eTransferSrc, MemoryUsage::AutoPreferHost, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+        staging.write(texture.data.size(), texture.data.data());
+
+        const auto fence = device->createFence();
+        device->singleTimeCommands<QueueType::GRAPHICS>([&](const vk::raii::CommandBuffer &cmd) { result->recordUpload(cmd, staging, 0); }, fence);
+        device->waitFence(fence);
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Texture>> Texture::loadAll(
+        const std::shared_ptr<RenderDevice> &device, ThreadPool &thread_pool, const VirtualFileSystem &file_system, const std::vector<std::string> &names,
+        const TextureOptions &options
+    ) {
+        std::vector<DecodedTexture> decoded(names.size());
+        thread_pool.parallelFor(names.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                decoded[i] = DecodedTexture::decode(file_system.load(names[i]).bytes(), options);
+            }
+        });
+
+        std::vector<vk::DeviceSize> offsets(decoded.size());
+        vk::DeviceSize              size = 0;
+        for (std::size_t i = 0; i < decoded.size(); i++) {
+            offsets[i] = size;
+            size       = (size + decoded[i].data.size() + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+        }
+        if (size == 0) {
+            return {};
+        }
+
+        auto [staging, info] = device->createBuffer(
+            size, vk::BufferUsageFlagBits::eTransferSrc, MemoryUsage::AutoPreferHost, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        );
+        std::vector<std::shared_ptr<Texture>> textures(decoded.size());
+        thread_pool.parallelFor(decoded.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                std::memcpy(static_cast<std::byte *>(info.pMappedData) + offsets[i], decoded[i].data.data(), decoded[i].data.size());
+                textures[i] = std::make_shared<Texture>(device, decoded[i].desc);
+            }
+        });
+        staging.allocation->flush(0, size);
+
+        const auto fence = device->createFence();
+        device->singleTimeCommands<QueueType::GRAPHICS>(
+            [&](const vk::raii::CommandBuffer &cmd) {
+                for (std::size_t i = 0; i < textures.size(); i++) {
+                    textures[i]->recordUpload(cmd, staging, offsets[i]);
+                }
+            },
+            fence
+        );
+        device->waitFence(fence);
+        return textures;
+    }
+
+    StreamedTexture Texture::stream(
+        const std::shared_ptr<RenderDevice> &device, AssetStreamer &streamer, const std::filesystem::path &path, const int32_t priority, const TextureOptions &options
+    ) {
+        auto texture = std::shared_ptr<Texture>(new Texture(device));
+        // written by the decode job, read by the upload; the streamer orders the two
+        auto desc = std::make_shared<TextureDesc>();
+
+        auto handle = streamer.request(
+            path, priority,
+            [device, desc, options](const std::vector<std::byte> &file) {
+                auto decoded = DecodedTexture::decode(file, options);
+                // checked here, where a throw fails the request, rather than in the upload on the render thread
+                if (!canSample(*device, decoded.desc.format)) {
+                    throw std::runtime_error("Texture::stream(): Format can not be sampled on this device");
+                }
+                *desc = std::move(decoded.desc);
+                return std::move(decoded.data);
+            },
+            [texture, desc](const vk::raii::CommandBuffer &cmd, const RawBuffer &staging, const vk::DeviceSize offset, vk::DeviceSize) {
+                texture->create(*desc);
+                texture->recordUpload(cmd, staging, offset);
+            }
+        );
+        return {std::move(texture), std::move(handle)};
+    }
+} // namespace engine
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "engine/assets/asset_streamer.hpp"
+#include "engine/assets/texture_file.hpp"
+#include "engine/assets/texture_image.hpp"
+#include "engine/assets/virtual_file_system.hpp"
+#include "engine/render_device.hpp"
+#include "engine/thread_pool.hpp"
+
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    struct TextureOptions {
+        vk::Format format  = vk::Format::eR8G8B8A8Srgb; // eR8G8B8A8Unorm for data (normal maps, masks)
+        bool       mipmaps = true;                      // full chain generated on the GPU after the upload
+    };
+
+    // Shape of a texture and of its upload data.
+    struct TextureDesc {
+        vk::Format                  format = vk::Format::eR8G8B8A8Srgb;
+        vk::Extent2D                extent;
+        uint32_t                    mipLevels = 1;
+        std::vector<vk::DeviceSize> levelOffsets; // of prebuilt levels in the upload data; empty when level 0 is RGBA8 and the rest is generated
+    };
+
+    // Upload-ready contents of a texture file.
+    struct DecodedTexture {
+        TextureDesc            desc;
+        std::vector<std::byte> data;
+
+        // Cooked texture files (see TextureFile) are recognized by their header and uploaded as is, every level prebuilt; anything else is decoded
+        // with stb_image and mipmapped on the GPU as `options` say. Throws like TextureFile::TextureFile and TextureImage::decode.
+        static DecodedTexture decode(std::span<const std::byte> file, const TextureOptions &options = {});
+        static DecodedTexture fromImage(TextureImage image, const TextureOptions &options = {});
+    };
+
+    // Block-compressed format of a cooked texture.
+    vk::Format textureFormat(BlockFormat format, bool srgb);
+
+    // Trilinear sampler reaching every mip level.
+    vk::raii::Sampler createSampler(const RenderDevice &device, vk::Filter filter = vk::Filter::eLinear, vk::SamplerAddressMode address_mode = vk::SamplerAddressMode::eRepeat);
+
+    class Texture;
+
+    struct StreamedTexture {
+        std::shared_ptr<Texture> texture; // `ready()` once the upload has been recorded
+        StreamHandle             handle;
+    };
+
+    // Sampled 2D image with a view over all of its mips. RGBA8 textures get their mips generated from level 0 with linear blits (a single level when
+    // the format can't be blitted with linear filtering); block-compressed textures bring every level with them.
+    class Texture {
+      public:
+        // Contents are undefined until an upload is recorded. Throws std::runtime_error when the device can't sample the format.
+        explicit Texture(const std::shared_ptr<RenderDevice> &device, const TextureDesc &desc);
+        Texture(const std::shared_ptr<RenderDevice> &device, uint32_t width, uint32_t height, const TextureOptions &options = {});
+
+        // Uploads through a temporary staging buffer on the graphics queue and blocks until done.
+        static std::shared_ptr<Texture> load(const std::shared_ptr<RenderDevice> &device, const DecodedTexture &texture);
+        // Reads and decodes every asset on the thread pool, then uploads them all with a single submission and blocks until done.
+        // Throws like VirtualFileSystem::load and DecodedTexture::decode.
+        static std::vector<std::shared_ptr<Texture>> loadAll(
+            const std::shared_ptr<RenderDevice> &device, ThreadPool &thread_pool, const VirtualFileSystem &file_system, const std::vector<std::string> &names,
+            const TextureOptions &options = {}
+        );
+        // Reads, decodes and uploads through the streamer. The image is created by the upload, on the render thread; formats the device can not
+        // sample fail the request during decoding instead.
+        static StreamedTexture stream(
+            const std::shared_ptr<RenderDevice> &device, AssetStreamer &streamer, const std::filesystem::path &path, int32_t priority, const TextureOptions &options = {}
+        );
+
+        // Records the copy of the upload data at `offset` in `staging` (laid out as the desc says), the mip generation and the transition of every
+        // level to eShaderReadOnlyOptimal. The previous contents are discarded.
+        void recordUpload(const vk::raii::CommandBuffer &cmd, const RawBuffer &staging, vk::DeviceSize offset);
+        // Records the copy of `region` of level 0 (tightly packed rows at `offset` in `staging`), regenerates the mips under it and transitions every
+        // level back to eShaderReadOnlyOptimal. Texels outside the region are kept, a texture that was never uploaded starts out cleared to zero.
+        // Throws std::logic_error for textures with prebuilt levels.
+        void recordUpdate(const vk::raii::CommandBuffer &cmd, const RawBuffer &staging, vk::DeviceSize offset, const vk::Rect2D &region);
+
+        [[nodiscard]] bool                       ready() const { return m_Ready; }
+        [[nodiscard]] vk::Image                  image() const { return *m_Image.image; }
+        [[nodiscard]] const vk::raii::ImageView &view() const { return m_View; }
+        [[nodiscard]] vk::Format                 format() const { return m_Desc.format; }
+        [[nodiscard]] vk::Extent2D               extent() const { return m_Desc.extent; }
+        [[nodiscard]] uint32_t                   mipLevels() const { return m_Desc.mipLevels; }
+        [[nodiscard]] vk::DescriptorImageInfo    descriptorInfo(const vk::Sampler sampler) const { return {sampler, *m_View, vk::ImageLayout::eShaderReadOnlyOptimal}; }
+
+      private:
+        explicit Texture(const std::shared_ptr<RenderDevice> &device);
+
+        void create(const TextureDesc &desc);
+        // Level 0 is in eTransferDstOptimal, the rest undefined or eTransferDstOptimal; everything ends up in eShaderReadOnlyOptimal.
+        void generateMips(const vk::raii::CommandBuffer &cmd, const vk::Rect2D &region);
+
+        std::shared_ptr<RenderDevice> m_RenderDevice;
+        TextureDesc                   m_Desc;
+
+        RawImage            m_Image{nullptr};
+        vk::raii::ImageView m_View{nullptr};
+        bool                m_Ready = false;
+    };
+
+} // namespace engine
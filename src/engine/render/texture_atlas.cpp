@@ -0,0 +1,61 @@
+#include "texture_atlas.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace engine {
+    namespace {
+        constexpr vk::DeviceSize STAGING_ALIGNMENT = 16;
+    } // namespace
+
+    TextureAtlas::TextureAtlas(const std::shared_ptr<RenderDevice> &render_device, const TextureAtlasOptions &options)
+        : m_RenderDevice(render_device), m_Format(options.format), m_Packer(options.packer) {}
+
+    vk::DeviceSize TextureAtlas::update(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame) {
+        const uint32_t page_size = m_Packer.pageSize();
+        while (m_Pages.size() < m_Packer.pageCount()) {
+            m_Pages.push_back(std::make_unique<Texture>(m_RenderDevice, TextureDesc{m_Format, vk::Extent2D(page_size, page_size), m_Packer.mipLevels(), {}}));
+        }
+
+        std::vector<vk::DeviceSize> offsets(m_Pages.size());
+        vk::DeviceSize              size = 0;
+        for (uint32_t page = 0; page < m_Pages.size(); page++) {
+            const AtlasRect dirty = m_Packer.dirtyRect(page);
+            offsets[page]         = size;
+            size                  = (size + std::size_t{dirty.width} * dirty.height * 4 + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+        }
+        if (size == 0) {
+            return 0;
+        }
+
+        // the frame's fence has been waited on, so its staging buffer is free to be overwritten or replaced
+        Staging &staging = m_Staging[current_frame];
+        if (staging.capacity < size) {
+            staging.capacity    = std::max(size, staging.capacity * 2);
+            auto [buffer, info] = m_RenderDevice->createBuffer(
+                staging.capacity, vk::BufferUsageFlagBits::eTransferSrc, MemoryUsage::AutoPreferHost,
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+            );
+            staging.buffer = std::move(buffer);
+            staging.mapped = static_cast<std::byte *>(info.pMappedData);
+        }
+
+        for (uint32_t page = 0; page < m_Pages.size(); page++) {
+            const AtlasRect dirty = m_Packer.dirtyRect(page);
+            if (dirty.width == 0 || dirty.height == 0) {
+                continue;
+            }
+
+            const auto pixels = m_Packer.pagePixels(page);
+            for (uint32_t y = 0; y < dirty.height; y++) {
+                std::memcpy(
+                    staging.mapped + offsets[page] + std::size_t{y} * dirty.width * 4, &pixels[(std::size_t{dirty.y + y} * page_size + dirty.x) * 4], std::size_t{dirty.width} * 4
+                );
+            }
+            m_Pages[page]->recordUpdate(cmd, staging.buffer, offsets[page], vk::Rect2D({static_cast<int32_t>(dirty.x), static_cast<int32_t>(dirty.y)}, {dirty.width, dirty.height}));
+            m_Packer.clearDirty(page);
+        }
+        staging.buffer.allocation->flush(0, size);
+        return size;
+    }
+} // namespace engine
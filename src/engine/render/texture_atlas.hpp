@@ -0,0 +1,59 @@
+#pragma once
+
+#include "engine/assets/atlas_packer.hpp"
+#include "engine/render/frame_renderer.hpp"
+#include "engine/render/texture.hpp"
+#include "engine/render_device.hpp"
+
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    struct TextureAtlasOptions {
+        AtlasPackerOptions packer;
+        vk::Format         format = vk::Format::eR8G8B8A8Srgb; // eR8G8B8A8Unorm for data
+    };
+
+    // Atlas pages as sampled textures, so thousands of small images (sprites, glyphs, icons) draw with a handful of texture binds.
+    // Images are packed as soon as they are inserted (see AtlasPacker) and reach the GPU with the next `update`, which copies only the texels
+    // written since the previous one and regenerates the mips under them. Regions may be drawn from once that update has been recorded.
+    class TextureAtlas {
+      public:
+        explicit TextureAtlas(const std::shared_ptr<RenderDevice> &render_device, const TextureAtlasOptions &options = {});
+
+        // Throws like AtlasPacker::insert.
+        AtlasImageId insert(const TextureImage &image) { return m_Packer.insert(image); }
+        AtlasImageId insert(const std::span<const TextureImage> images) { return m_Packer.insert(images); }
+
+        [[nodiscard]] const AtlasRegion           &region(const AtlasImageId id) const { return m_Packer.region(id); }
+        [[nodiscard]] std::span<const AtlasRegion> regions() const { return m_Packer.regions(); }
+
+        // Call once per frame from the render thread, before rendering begins (`WindowRenderer::renderFrame`'s `prepare`). Creates the textures
+        // of new pages, stages the dirty texels in the frame's staging buffer (grown when too small) and records their upload. Returns the bytes uploaded.
+        vk::DeviceSize update(const vk::raii::CommandBuffer &cmd, uint32_t current_frame);
+
+        // Pages created by the last `update`, indexed by `AtlasRegion::page`.
+        [[nodiscard]] uint32_t           pageCount() const { return static_cast<uint32_t>(m_Pages.size()); }
+        [[nodiscard]] const Texture     &page(const uint32_t page) const { return *m_Pages.at(page); }
+        [[nodiscard]] const AtlasPacker &packer() const { return m_Packer; }
+
+      private:
+        struct Staging {
+            RawBuffer      buffer{nullptr};
+            std::byte     *mapped   = nullptr;
+            vk::DeviceSize capacity = 0;
+        };
+
+        std::shared_ptr<RenderDevice> m_RenderDevice;
+        vk::Format                    m_Format;
+        AtlasPacker                   m_Packer;
+
+        std::vector<std::unique_ptr<Texture>>     m_Pages;
+        std::array<Staging, MAX_FRAMES_IN_FLIGHT> m_Staging;
+    };
+
+} // namespace engine
@@ -0,0 +1,70 @@
+#include "uniform_allocator.hpp"
+
+#include <stdexcept>
+
+namespace engine {
+    UniformAllocator::UniformAllocator(const std::shared_ptr<RenderDevice> &render_device, const vk::DeviceSize frame_capacity) : m_RenderDevice(render_device) {
+        if (frame_capacity == 0) {
+            throw std::invalid_argument("UniformAllocator::UniformAllocator(): frame_capacity must be greater than zero");
+        }
+
+        const auto limits = m_RenderDevice->physicalDevice().getProperties().limits;
+        // a power of two per the spec, so every aligned size keeps the next offset aligned as well
+        m_Alignment  = limits.minUniformBufferOffsetAlignment;
+        m_MaxRange   = limits.maxUniformBufferRange;
+        m_RegionSize = (frame_capacity + m_Alignment - 1) & ~(m_Alignment - 1);
+
+        auto [buffer, info] = m_RenderDevice->createBuffer(
+            m_RegionSize * MAX_FRAMES_IN_FLIGHT, vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress, MemoryUsage::AutoPreferDevice,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        );
+        m_Buffer        = std::move(buffer);
+        m_Mapped        = static_cast<std::byte *>(info.pMappedData);
+        m_BufferAddress = m_RenderDevice->bufferAddress(m_Buffer);
+    }
+
+    void UniformAllocator::beginFrame(const uint32_t current_frame) {
+        m_CurrentFrame = current_frame;
+        m_Head.store(0, std::memory_order_relaxed);
+    }
+
+    UniformAllocation UniformAllocator::allocate(const vk::DeviceSize size) {
+        if (size == 0 || size > m_MaxRange) {
+            throw std::invalid_argument("UniformAllocator::allocate(): Size must be between 1 and maxUniformBufferRange");
+        }
+
+        const vk::DeviceSize aligned = (size + m_Alignment - 1) & ~(m_Alignment - 1);
+        const vk::DeviceSize head    = m_Head.fetch_add(aligned, std::memory_order_relaxed);
+        if (head + aligned > m_RegionSize) {
+            throw std::out_of_range("UniformAllocator::allocate(): Frame capacity exhausted");
+        }
+
+        const vk::DeviceSize offset = m_RegionSize * m_CurrentFrame + head;
+        return UniformAllocation{
+            .buffer  = *m_Buffer.buffer,
+            .offset  = offset,
+            .size    = size,
+            .address = m_BufferAddress + offset,
+            .data    = m_Mapped + offset,
+        };
+    }
+
+    void UniformAllocator::flush() {
+        if (const vk::DeviceSize size = used(); size > 0) {
+            m_Buffer.allocation->flush(m_RegionSize * m_CurrentFrame, size);
+        }
+    }
+
+    void UniformAllocator::push(
+        const vk::raii::CommandBuffer &cmd, const vk::PipelineBindPoint bind_point, const vk::PipelineLayout layout, const uint32_t set, const uint32_t binding,
+        const UniformAllocation &allocation
+    ) {
+        const vk::DescriptorBufferInfo info = allocation.descriptorInfo();
+        vk::WriteDescriptorSet         write{};
+        write.dstBinding      = binding;
+        write.descriptorCount = 1;
+        write.descriptorType  = vk::DescriptorType::eUniformBuffer;
+        write.pBufferInfo     = &info;
+        cmd.pushDescriptorSet(bind_point, layout, set, write);
+    }
+} // namespace engine
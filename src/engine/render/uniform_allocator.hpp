@@ -0,0 +1,81 @@
+#pragma once
+
+#include "engine/render/frame_renderer.hpp"
+#include "engine/render_device.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace engine {
+
+    // Constants written this frame, valid until the frame's region is reset.
+    struct UniformAllocation {
+        vk::Buffer        buffer;
+        vk::DeviceSize    offset  = 0;
+        vk::DeviceSize    size    = 0;
+        vk::DeviceAddress address = 0; // for shaders reading through a buffer reference pushed as a constant
+        std::byte        *data    = nullptr;
+
+        [[nodiscard]] vk::DescriptorBufferInfo descriptorInfo() const { return {buffer, offset, size}; }
+        // For eUniformBufferDynamic descriptors written over `UniformAllocator::buffer()` at offset 0.
+        [[nodiscard]] uint32_t dynamicOffset() const { return static_cast<uint32_t>(offset); }
+    };
+
+    // Linear allocator for transient constants (camera, per-draw data) over one persistently mapped buffer with a region per frame in flight.
+    // Allocating bumps an offset aligned to minUniformBufferOffsetAlignment and nothing is freed individually: `beginFrame` resets the frame's
+    // region once its fence has been waited on. Allocations reach shaders without allocating descriptor sets, either pushed with `push`,
+    // bound as dynamic offsets into a single set written over `buffer()`, or read through `address`.
+    class UniformAllocator {
+      public:
+        // `frame_capacity` bytes per frame in flight.
+        UniformAllocator(const std::shared_ptr<RenderDevice> &render_device, vk::DeviceSize frame_capacity);
+
+        // Call once per frame before the first allocation, after the frame's fence has been waited on (`WindowRenderer::renderFrame`'s `prepare`).
+        void beginFrame(uint32_t current_frame);
+
+        // Thread safe between `beginFrame` calls, so command buffers can be recorded in parallel. Throws std::out_of_range when the frame's region
+        // is exhausted and std::invalid_argument for sizes above maxUniformBufferRange.
+        UniformAllocation allocate(vk::DeviceSize size);
+
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        UniformAllocation allocate(const T &value) {
+            const UniformAllocation allocation = allocate(sizeof(T));
+            std::memcpy(allocation.data, &value, sizeof(T));
+            return allocation;
+        }
+
+        // Makes the frame's writes visible to the device. Call after the last allocation, before the command buffer is submitted.
+        void flush();
+
+        // Records a push of `allocation` as the uniform buffer at `binding` of `set`. The set's layout must be created with
+        // vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptor.
+        static void push(
+            const vk::raii::CommandBuffer &cmd, vk::PipelineBindPoint bind_point, vk::PipelineLayout layout, uint32_t set, uint32_t binding, const UniformAllocation &allocation
+        );
+
+        [[nodiscard]] vk::Buffer     buffer() const { return *m_Buffer.buffer; }
+        [[nodiscard]] vk::DeviceSize frameCapacity() const { return m_RegionSize; }
+        [[nodiscard]] vk::DeviceSize alignment() const { return m_Alignment; }
+        // Bytes allocated from the current frame's region, alignment included.
+        [[nodiscard]] vk::DeviceSize used() const { return std::min(m_Head.load(std::memory_order_relaxed), m_RegionSize); }
+
+      private:
+        std::shared_ptr<RenderDevice> m_RenderDevice;
+
+        RawBuffer         m_Buffer{nullptr};
+        std::byte        *m_Mapped = nullptr;
+        vk::DeviceAddress m_BufferAddress{};
+        vk::DeviceSize    m_Alignment;
+        vk::DeviceSize    m_MaxRange;
+        vk::DeviceSize    m_RegionSize;
+
+        uint32_t                    m_CurrentFrame = 0;
+        std::atomic<vk::DeviceSize> m_Head         = 0; // offset into the current frame's region, may overshoot it when allocations fail
+    };
+
+} // namespace engine
@@ -4,13 +4,73 @@
 
 #include "vertex_buffer.hpp"
 
+#include <cstring>
+
 namespace engine {
-    void VertexBuffer::bindAndSetState(const vk::raii::CommandBuffer &cmd, vk::DeviceSize offset) {
-        cmd.setVertexInputEXT(m_Layout.binding, m_Layout.attributes);
-        bind(cmd, m_Layout.binding.binding, offset);
+    VertexBufferLayout VertexBufferLayout::combinedWith(const VertexBufferLayout &other) const {
+        VertexBufferLayout combined = *this;
+        combined.bindings.insert(combined.bindings.end(), other.bindings.begin(), other.bindings.end());
+        combined.attributes.insert(combined.attributes.end(), other.attributes.begin(), other.attributes.end());
+        return combined;
+    }
+
+    void VertexBufferLayout::setState(const vk::raii::CommandBuffer &cmd) const {
+        cmd.setVertexInputEXT(bindings, attributes);
+    }
+
+    void VertexBufferLayout::setState(CommandState &state) const {
+        state.setVertexInputEXT(bindings, attributes);
+    }
+
+    VertexBuffer::VertexBuffer(const std::shared_ptr<RenderDevice> &device, const vk::DeviceSize capacity, const VertexBufferLayout &layout)
+        : m_Layout(layout), m_Storage(VertexBufferStorage::Streaming) {
+        createStreamingBuffer(device, capacity);
+    }
+
+    void VertexBuffer::bindAndSetState(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame, vk::DeviceSize offset) const {
+        m_Layout.setState(cmd);
+        bind(cmd, current_frame, m_Layout.bindings.front().binding, offset);
     }
 
-    void VertexBuffer::bind(const vk::raii::CommandBuffer &cmd, uint32_t binding, vk::DeviceSize offset) {
-        cmd.bindVertexBuffers(binding, {*m_Buffer.buffer}, {offset});
+    void VertexBuffer::bindAndSetState(CommandState &state, const uint32_t current_frame, const vk::DeviceSize offset) const {
+        m_Layout.setState(state);
+        bind(state.commandBuffer(), current_frame, m_Layout.bindings.front().binding, offset);
+    }
+
+    void VertexBuffer::bind(const vk::raii::CommandBuffer &cmd, const uint32_t current_frame, uint32_t binding, vk::DeviceSize offset) const {
+        // m_RegionStride is 0 unless streaming
+        cmd.bindVertexBuffers(binding, {*m_Buffer.buffer}, {m_RegionStride * current_frame + offset});
+    }
+
+    void VertexBuffer::createStreamingBuffer(const std::shared_ptr<RenderDevice> &device, const vk::DeviceSize capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("VertexBuffer::VertexBuffer(): Streaming capacity must be greater than zero");
+        }
+
+        m_RegionSize   = capacity;
+        m_RegionStride = (capacity + 255) & ~vk::DeviceSize{255};
+
+        auto [buffer, info] = device->createBuffer(
+            m_RegionStride * MAX_FRAMES_IN_FLIGHT, vk::BufferUsageFlagBits::eVertexBuffer, MemoryUsage::AutoPreferDevice,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        );
+        m_Buffer = std::move(buffer);
+        m_Mapped = static_cast<std::byte *>(info.pMappedData);
+    }
+
+    void VertexBuffer::write(const uint32_t current_frame, const void *data, const vk::DeviceSize size) {
+        if (m_Storage != VertexBufferStorage::Streaming) {
+            throw std::logic_error("VertexBuffer::update(): Only buffers with Streaming storage can be updated");
+        }
+        if (size > m_RegionSize) {
+            throw std::out_of_range("VertexBuffer::update(): Data exceeds the capacity given at construction");
+        }
+
+        if (size > 0) {
+            const vk::DeviceSize offset = m_RegionStride * current_frame;
+            std::memcpy(m_Mapped + offset, data, size);
+            m_Buffer.allocation->flush(offset, size);
+        }
+        m_Sizes[current_frame] = size;
     }
 } // engine
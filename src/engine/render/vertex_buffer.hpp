@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include "engine/render/command_state.hpp"
+#include "engine/render/frame_renderer.hpp"
 #include "engine/render_device.hpp"
 
+#include <array>
 #include <memory>
 #include <ranges>
 #include <vulkan/vulkan_raii.hpp>
@@ -13,12 +16,20 @@
 namespace engine {
     enum class VertexBufferStorage {
         Static, // Static vertex buffer storage is gpu-only and copied from cpu. Creating this will make a temporary dynamic buffer and use it to copy.
-        Dynamic // Dynamic vertex buffer storage is host-visible + host-coherent
+        Dynamic,  // Dynamic vertex buffer storage is host-visible + host-coherent
+        Streaming // Streaming vertex buffer storage keeps one persistently mapped region per frame in flight, rewritten every frame with `update`
     };
 
+    // Complete vertex input state, possibly spanning several bindings (e.g. a per-vertex mesh stream and a per-instance stream).
     struct VertexBufferLayout {
-        vk::VertexInputBindingDescription2EXT                binding;
+        std::vector<vk::VertexInputBindingDescription2EXT>   bindings;
         std::vector<vk::VertexInputAttributeDescription2EXT> attributes;
+
+        [[nodiscard]] VertexBufferLayout combinedWith(const VertexBufferLayout &other) const;
+        void                             setState(const vk::raii::CommandBuffer &cmd) const;
+        void                             setState(CommandState &state) const;
+
+        bool operator==(const VertexBufferLayout &) const = default;
     };
 
     class VertexBuffer {
@@ -28,9 +39,31 @@ namespace engine {
             return std::shared_ptr<VertexBuffer>(new VertexBuffer(device, storage, std::forward<R>(range), layout));
         }
 
+        // Streaming buffer of `capacity` bytes per frame in flight, initially empty.
+        static inline std::shared_ptr<VertexBuffer> createStreaming(const std::shared_ptr<RenderDevice> &device, const vk::DeviceSize capacity, const VertexBufferLayout &layout) {
+            return std::shared_ptr<VertexBuffer>(new VertexBuffer(device, capacity, layout));
+        }
+
+        template <typename T>
+        static inline std::shared_ptr<VertexBuffer> createStreaming(const std::shared_ptr<RenderDevice> &device, const uint32_t capacity, const VertexBufferLayout &layout) {
+            static_assert(std::is_standard_layout_v<T> && "Invalid buffer value type (must be a standard layout type to ensure that it is safe to copy)");
+            return createStreaming(device, sizeof(T) * capacity, layout);
+        }
+
+        VertexBuffer(const std::shared_ptr<RenderDevice> &device, vk::DeviceSize capacity, const VertexBufferLayout &layout);
+
+        // With Streaming storage the range is the initial contents of every region and its size the capacity.
         template <std::ranges::contiguous_range R>
-        VertexBuffer(const std::shared_ptr<RenderDevice> &device, const VertexBufferStorage storage, R range, const VertexBufferLayout &layout) : m_Layout(layout) {
-            if (storage == VertexBufferStorage::Dynamic) {
+        VertexBuffer(const std::shared_ptr<RenderDevice> &device, const VertexBufferStorage storage, R range, const VertexBufferLayout &layout) : m_Layout(layout), m_Storage(storage) {
+            if (storage == VertexBufferStorage::Streaming) {
+                using range_value_t = std::ranges::range_value_t<R>;
+                static_assert(std::is_standard_layout_v<range_value_t> && "Invalid buffer value type (must be a standard layout type to ensure that it is safe to copy)");
+
+                createStreamingBuffer(device, std::ranges::size(range) * sizeof(range_value_t));
+                for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; frame++) {
+                    write(frame, std::ranges::cdata(range), std::ranges::size(range) * sizeof(range_value_t));
+                }
+            } else if (storage == VertexBufferStorage::Dynamic) {
                 m_Buffer = createHostBuffer(device, std::forward<R &&>(range), false);
             } else {
                 using range_value_t                     = std::ranges::range_value_t<R>;
@@ -50,15 +83,43 @@ namespace engine {
         }
 
         inline const VertexBufferLayout &layout() const { return m_Layout; };
+        inline VertexBufferStorage       storage() const { return m_Storage; }
+
+        // Streaming storage only: bytes per region, and bytes written to the frame's region by its last `update`.
+        inline vk::DeviceSize capacity() const { return m_RegionSize; }
+        inline vk::DeviceSize size(const uint32_t current_frame) const { return m_Sizes[current_frame]; }
 
-        void bindAndSetState(const vk::raii::CommandBuffer &cmd, vk::DeviceSize offset = 0);
+        // Streaming storage only. Writes the current frame's region, which the gpu finished reading when this frame slot was last waited on.
+        // Throws if the range is larger than the capacity.
+        template <std::ranges::contiguous_range R>
+        void update(const uint32_t current_frame, const R &range) {
+            using range_value_t = std::ranges::range_value_t<R>;
+            static_assert(std::is_standard_layout_v<range_value_t> && "Invalid buffer value type (must be a standard layout type to ensure that it is safe to copy)");
+            write(current_frame, std::ranges::cdata(range), std::ranges::size(range) * sizeof(range_value_t));
+        }
 
-        void bind(const vk::raii::CommandBuffer &cmd, uint32_t binding, vk::DeviceSize offset = 0);
+        // Sets the whole layout as vertex input state and binds this buffer to the layout's first binding.
+        void bindAndSetState(const vk::raii::CommandBuffer &cmd, uint32_t current_frame, vk::DeviceSize offset = 0) const;
+        void bindAndSetState(CommandState &state, uint32_t current_frame, vk::DeviceSize offset = 0) const;
+
+        // Streaming buffers bind the current frame's region and `offset` is relative to it, so a frame only ever reads the region it wrote and
+        // a frame that skips `update` draws what its region held the last time. Other storages ignore `current_frame`.
+        void bind(const vk::raii::CommandBuffer &cmd, uint32_t current_frame, uint32_t binding, vk::DeviceSize offset = 0) const;
 
 
       private:
-        RawBuffer          m_Buffer{nullptr};
-        VertexBufferLayout m_Layout;
+        RawBuffer           m_Buffer{nullptr};
+        VertexBufferLayout  m_Layout;
+        VertexBufferStorage m_Storage;
+
+        std::byte     *m_Mapped       = nullptr;
+        vk::DeviceSize m_RegionSize   = 0;
+        vk::DeviceSize m_RegionStride = 0; // region size rounded up so every region starts 256 byte aligned
+
+        std::array<vk::DeviceSize, MAX_FRAMES_IN_FLIGHT> m_Sizes{};
+
+        void createStreamingBuffer(const std::shared_ptr<RenderDevice> &device, vk::DeviceSize capacity);
+        void write(uint32_t current_frame, const void *data, vk::DeviceSize size);
 
         template <std::ranges::contiguous_range R>
         static RawBuffer createHostBuffer(const std::shared_ptr<RenderDevice> &device, R range, bool forCopy) {
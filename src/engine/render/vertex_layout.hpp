@@ -0,0 +1,96 @@
+#pragma once
+
+#include "engine/geometry/vertex_packing.hpp"
+#include "engine/render/vertex_buffer.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vulkan/vulkan.hpp>
+
+namespace engine {
+
+    // Vertex input format of an attribute type. Specialise for additional types.
+    template <typename T>
+    struct VertexFormat;
+
+    // clang-format off
+    template <> struct VertexFormat<float>        { static constexpr vk::Format format = vk::Format::eR32Sfloat; };
+    template <> struct VertexFormat<glm::vec2>    { static constexpr vk::Format format = vk::Format::eR32G32Sfloat; };
+    template <> struct VertexFormat<glm::vec3>    { static constexpr vk::Format format = vk::Format::eR32G32B32Sfloat; };
+    template <> struct VertexFormat<glm::vec4>    { static constexpr vk::Format format = vk::Format::eR32G32B32A32Sfloat; };
+    template <> struct VertexFormat<uint32_t>     { static constexpr vk::Format format = vk::Format::eR32Uint; };
+    template <> struct VertexFormat<Half2>        { static constexpr vk::Format format = vk::Format::eR16G16Sfloat; };
+    template <> struct VertexFormat<Half4>        { static constexpr vk::Format format = vk::Format::eR16G16B16A16Sfloat; };
+    template <> struct VertexFormat<Snorm16x4>    { static constexpr vk::Format format = vk::Format::eR16G16B16A16Snorm; };
+    template <> struct VertexFormat<Octahedral16> { static constexpr vk::Format format = vk::Format::eR16G16Snorm; };
+    template <> struct VertexFormat<Unorm8x4>     { static constexpr vk::Format format = vk::Format::eR8G8B8A8Unorm; };
+    // clang-format on
+
+    // One attribute of a vertex struct with its offset known at compile time, written with `ENGINE_VERTEX_ATTRIBUTE`.
+    template <typename Vertex, typename Member, std::size_t Offset>
+    struct VertexAttribute {
+        using vertex_type = Vertex;
+        using member_type = Member;
+
+        static constexpr auto offset = static_cast<uint32_t>(Offset);
+    };
+
+    // offsetof is the only way to get a member's offset in a constant expression, hence the macro.
+#define ENGINE_VERTEX_ATTRIBUTE(vertex, member) ::engine::VertexAttribute<vertex, decltype(vertex::member), offsetof(vertex, member)>
+
+    namespace detail {
+        template <typename T>
+        concept HasVertexFormat = requires { VertexFormat<T>::format; };
+    } // namespace detail
+
+    // Attribute descriptions of one binding, formats come from `VertexFormat` of each member type and locations are assigned in order
+    // starting at `first_location`. Usable in constant expressions.
+    template <typename First, typename... Rest>
+    constexpr std::array<vk::VertexInputAttributeDescription2EXT, 1 + sizeof...(Rest)> makeVertexAttributes(const uint32_t binding = 0, const uint32_t first_location = 0) {
+        using vertex_type = typename First::vertex_type;
+        static_assert(std::is_standard_layout_v<vertex_type> && "Invalid vertex type (must be a standard layout type to ensure that it is safe to copy)");
+        static_assert((std::is_same_v<vertex_type, typename Rest::vertex_type> && ...) && "All attributes must be members of the same vertex type");
+        static_assert(detail::HasVertexFormat<typename First::member_type> && (detail::HasVertexFormat<typename Rest::member_type> && ...) && "Missing VertexFormat specialisation for an attribute type");
+
+        constexpr std::array formats = {VertexFormat<typename First::member_type>::format, VertexFormat<typename Rest::member_type>::format...};
+        constexpr std::array offsets = {First::offset, Rest::offset...};
+        constexpr std::array sizes   = {sizeof(typename First::member_type), sizeof(typename Rest::member_type)...};
+        static_assert(
+            [&] {
+                for (std::size_t i = 0; i < offsets.size(); i++) {
+                    if (offsets[i] + sizes[i] > sizeof(vertex_type)) {
+                        return false;
+                    }
+                }
+                return true;
+            }() && "Attribute lies outside of the vertex type"
+        );
+
+        std::array<vk::VertexInputAttributeDescription2EXT, 1 + sizeof...(Rest)> attributes{};
+        for (uint32_t i = 0; i < attributes.size(); i++) {
+            attributes[i] = vk::VertexInputAttributeDescription2EXT(first_location + i, binding, formats[i], offsets[i]);
+        }
+        return attributes;
+    }
+
+    // Generates the layout of one binding from the vertex struct's members:
+    //     makeVertexLayout<ENGINE_VERTEX_ATTRIBUTE(Vertex, position), ENGINE_VERTEX_ATTRIBUTE(Vertex, color)>()
+    // Members without a format, or from different structs, fail to compile.
+    template <typename First, typename... Rest>
+    VertexBufferLayout makeVertexLayout(const uint32_t binding = 0, const vk::VertexInputRate input_rate = vk::VertexInputRate::eVertex, const uint32_t first_location = 0) {
+        using vertex_type = typename First::vertex_type;
+
+        constexpr auto attributes = makeVertexAttributes<First, Rest...>();
+
+        VertexBufferLayout layout;
+        layout.bindings.emplace_back(binding, static_cast<uint32_t>(sizeof(vertex_type)), input_rate, 1);
+        for (const auto &attribute : attributes) {
+            layout.attributes.emplace_back(first_location + attribute.location, binding, attribute.format, attribute.offset);
+        }
+        return layout;
+    }
+
+} // namespace engine
@@ -19,7 +19,7 @@ namespace engine {
 
     WindowRenderer::~WindowRenderer() {}
 
-    void WindowRenderer::renderFrame(const std::function<void(const vk::raii::CommandBuffer& cmd, const SwapchainFrameInfo& frameInfo, uint32_t currentFrame)> &func) {
+    void WindowRenderer::renderFrame(const FrameFunction &prepare, const FrameFunction &func) {
         const auto &fence           = m_InFlightFences[m_CurrentFrame];
         const auto &image_available = m_ImageAvailableSemaphores[m_CurrentFrame];
         const auto &render_finished = m_RenderFinishedSemaphores[m_CurrentFrame];
@@ -34,34 +34,8 @@ namespace engine {
         m_RenderDevice->resetFence(fence);
 
         const auto &cmd = m_CommandBuffers[m_CurrentFrame];
-
-        cmd.reset();
-        cmd.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
-
-        imageTransition(cmd, frame_info->image, vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1),
-                        {vk::ImageLayout::eUndefined, vk::PipelineStageFlagBits2::eTopOfPipe, vk::AccessFlagBits2::eNone, 0},
-                        {vk::ImageLayout::eColorAttachmentOptimal, vk::PipelineStageFlagBits2::eColorAttachmentOutput, vk::AccessFlagBits2::eColorAttachmentWrite, 0});
-
-
-        vk::RenderingAttachmentInfo color_attachment = {*m_ImageViews[frame_info->imageIndex], vk::ImageLayout::eColorAttachmentOptimal,
-                                                        vk::ResolveModeFlagBits::eNone,        nullptr,
-                                                        vk::ImageLayout::eUndefined,           vk::AttachmentLoadOp::eClear,
-                                                        vk::AttachmentStoreOp::eStore,         vk::ClearColorValue{1.0f, 0.0f, 0.0f, 1.0f}};
-
-        vk::RenderingInfo rendering_info{};
-        rendering_info.setRenderArea({{0, 0}, frame_info->extent});
-        rendering_info.setLayerCount(1);
-        rendering_info.setColorAttachments(color_attachment);
-
-        cmd.beginRendering(rendering_info);
-        func(cmd, frame_info.value(), m_CurrentFrame);
-        cmd.endRendering();
-
-        imageTransition(cmd, frame_info->image, vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1),
-                        {vk::ImageLayout::eColorAttachmentOptimal, vk::PipelineStageFlagBits2::eColorAttachmentOutput, vk::AccessFlagBits2::eColorAttachmentWrite, 0},
-                        {vk::ImageLayout::ePresentSrcKHR, vk::PipelineStageFlagBits2::eBottomOfPipe, vk::AccessFlagBits2::eNone, 0});
-
-        cmd.end();
+        recordFrame(cmd, frame_info.value(), *m_ImageViews[frame_info->imageIndex], m_CurrentFrame,
+                    {vk::ImageLayout::ePresentSrcKHR, vk::PipelineStageFlagBits2::eBottomOfPipe, vk::AccessFlagBits2::eNone, 0}, prepare, func);
 
         vk::SemaphoreSubmitInfo     wait_info{*image_available, 0, vk::PipelineStageFlagBits2::eAllCommands};
         vk::SemaphoreSubmitInfo     signal_info{*render_finished, 0, vk::PipelineStageFlagBits2::eAllCommands};
@@ -72,6 +46,7 @@ namespace engine {
         m_Swapchain->present(render_finished);
 
         m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        m_FrameCount++;
     }
 
     void WindowRenderer::recreateImageViews(const std::vector<vk::Image> &images, vk::SurfaceFormatKHR surfaceFormat, vk::Extent2D extent) {
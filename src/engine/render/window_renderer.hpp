@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "engine/render/frame_renderer.hpp"
 #include "engine/render_device.hpp"
 #include "engine/swapchain.hpp"
 #include <vulkan/vulkan_raii.hpp>
@@ -11,14 +12,13 @@
 
 namespace engine {
 
-    constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
-
-    class WindowRenderer {
+    class WindowRenderer : public FrameRenderer {
       public:
         WindowRenderer(const std::shared_ptr<RenderDevice> &render_device, const std::shared_ptr<Swapchain> &swapchain);
-        ~WindowRenderer();
+        ~WindowRenderer() override;
 
-        void renderFrame(const std::function<void(const vk::raii::CommandBuffer& cmd, const SwapchainFrameInfo& frameInfo, uint32_t currentFrame)> &func);
+        using FrameRenderer::renderFrame;
+        void renderFrame(const FrameFunction &prepare, const FrameFunction &func) override;
 
       private:
         void recreateImageViews(const std::vector<vk::Image> &images, vk::SurfaceFormatKHR surfaceFormat, vk::Extent2D extent);
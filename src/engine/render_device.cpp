@@ -10,6 +10,7 @@
 #include "render_device.hpp"
 
 #include "GLFW/glfw3.h"
+#include "engine/render/layout_cache.hpp"
 
 #include <iostream>
 
@@ -40,13 +41,21 @@ namespace engine {
         vmaUnmapMemory(allocator, allocation);
     }
 
+    void Allocation::flush(const vk::DeviceSize offset, const vk::DeviceSize size) const {
+        vmaFlushAllocation(allocator, allocation, offset, size);
+    }
+
+    void Allocation::invalidate(const vk::DeviceSize offset, const vk::DeviceSize size) const {
+        vmaInvalidateAllocation(allocator, allocation, offset, size);
+    }
+
     void RawBuffer::write(const std::size_t size, const void *data) const {
         void *dst = allocation->map();
         std::memcpy(dst, data, size);
         allocation->unmap();
     }
 
-    RenderDevice::RenderDevice() {
+    RenderDevice::RenderDevice(const RenderDeviceOptions &options) : m_Headless(options.headless) {
         VmaAllocatorCreateFlags allocatorFlags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT | VMA_ALLOCATOR_CREATE_KHR_MAINTENANCE4_BIT | VMA_ALLOCATOR_CREATE_KHR_MAINTENANCE5_BIT;
 
         {
@@ -60,9 +69,11 @@ namespace engine {
 
             std::vector<const char *> instance_extensions{};
 
-            uint32_t     extension_count     = 0;
-            const char **required_extensions = glfwGetRequiredInstanceExtensions(&extension_count);
-            instance_extensions.assign(required_extensions, required_extensions + extension_count);
+            if (!m_Headless) {
+                uint32_t     extension_count     = 0;
+                const char **required_extensions = glfwGetRequiredInstanceExtensions(&extension_count);
+                instance_extensions.assign(required_extensions, required_extensions + extension_count);
+            }
 
             create_info.setPEnabledExtensionNames(instance_extensions);
 
@@ -75,19 +86,25 @@ namespace engine {
         }
 
         {
-            std::vector<const char *> device_extensions{VK_EXT_SHADER_OBJECT_EXTENSION_NAME, VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+            std::vector<const char *> device_extensions{VK_EXT_SHADER_OBJECT_EXTENSION_NAME};
+            if (!m_Headless) {
+                device_extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+            }
+
+            // nothing is presented headless, presentation support is neither needed nor queried (it would need GLFW)
+            const auto can_present = [&](const uint32_t family) { return !m_Headless && glfwGetPhysicalDevicePresentationSupport(*m_Instance, *m_PhysicalDevice, family); };
 
             auto qfps = m_PhysicalDevice.getQueueFamilyProperties();
             for (uint32_t i = 0; i < qfps.size(); ++i) {
                 const auto &qfp = qfps[i];
                 if (m_GraphicsQueueFamily == UINT32_MAX && qfp.queueFlags & vk::QueueFlagBits::eGraphics) {
                     m_GraphicsQueueFamily = i;
-                    if (glfwGetPhysicalDevicePresentationSupport(*m_Instance, *m_PhysicalDevice, i)) {
+                    if (can_present(i)) {
                         m_PresentQueueFamily = i;
                     }
                 }
 
-                if (m_PresentQueueFamily == UINT32_MAX && glfwGetPhysicalDevicePresentationSupport(*m_Instance, *m_PhysicalDevice, i)) {
+                if (m_PresentQueueFamily == UINT32_MAX && can_present(i)) {
                     m_PresentQueueFamily = i;
                 }
 
@@ -96,11 +113,19 @@ namespace engine {
                     m_TransferQueueFamily = i;
                 }
 
-                if (m_GraphicsQueueFamily != UINT32_MAX && m_TransferQueueFamily != UINT32_MAX && m_PresentQueueFamily != UINT32_MAX) {
+                if (options.asyncCompute && m_ComputeQueueFamily == UINT32_MAX && !(qfp.queueFlags & vk::QueueFlagBits::eGraphics) &&
+                    (qfp.queueFlags & vk::QueueFlagBits::eCompute)) {
+                    m_ComputeQueueFamily = i;
+                }
+
+                if (m_GraphicsQueueFamily != UINT32_MAX && m_TransferQueueFamily != UINT32_MAX && (m_PresentQueueFamily != UINT32_MAX || m_Headless) &&
+                    (m_ComputeQueueFamily != UINT32_MAX || !options.asyncCompute)) {
                     break;
                 }
             }
 
+            const auto supported = m_PhysicalDevice.getFeatures();
+
             vk::PhysicalDeviceFeatures2 f2{};
             f2.features.wideLines          = true;
             f2.features.largePoints        = true;
@@ -109,6 +134,12 @@ namespace engine {
             f2.features.sparseBinding      = true;
             f2.features.multiDrawIndirect  = true;
             f2.features.fillModeNonSolid   = true;
+            // cooked textures are BCn, optional so the device still comes up where it's missing (mobile, some software rasterizers)
+            f2.features.textureCompressionBC = supported.textureCompressionBC;
+            m_BlockCompression               = f2.features.textureCompressionBC;
+            // GPU culling passes the instance index as the indirect commands' firstInstance
+            f2.features.drawIndirectFirstInstance = supported.drawIndirectFirstInstance;
+            m_IndirectFirstInstance               = f2.features.drawIndirectFirstInstance;
 
             vk::PhysicalDeviceVulkan11Features v11f{};
             v11f.shaderDrawParameters = true;
@@ -126,7 +157,8 @@ namespace engine {
             v13f.maintenance4 = true;
 
             vk::PhysicalDeviceVulkan14Features v14f{};
-            v14f.maintenance5 = true;
+            v14f.maintenance5   = true;
+            v14f.pushDescriptor = true; // transient uniforms are pushed instead of allocating sets per draw
 
             vk::PhysicalDeviceShaderObjectFeaturesEXT sof{};
             sof.shaderObject = true;
@@ -149,7 +181,17 @@ namespace engine {
                 qcis.emplace_back(vk::DeviceQueueCreateInfo({}, m_TransferQueueFamily, queuePriorities));
             }
 
-            if (m_PresentQueueFamily != m_GraphicsQueueFamily && m_PresentQueueFamily != m_TransferQueueFamily) {
+            if (m_ComputeQueueFamily == UINT32_MAX) {
+                m_ComputeQueueFamily = m_GraphicsQueueFamily;
+            } else {
+                qcis.emplace_back(vk::DeviceQueueCreateInfo({}, m_ComputeQueueFamily, queuePriorities));
+            }
+
+            if (m_Headless) {
+                m_PresentQueueFamily = m_GraphicsQueueFamily;
+            }
+
+            if (m_PresentQueueFamily != m_GraphicsQueueFamily && m_PresentQueueFamily != m_TransferQueueFamily && m_PresentQueueFamily != m_ComputeQueueFamily) {
                 qcis.emplace_back(vk::DeviceQueueCreateInfo({}, m_PresentQueueFamily, queuePriorities));
             }
 
@@ -193,13 +235,17 @@ namespace engine {
             m_GraphicsQueue = m_Device.getQueue(m_GraphicsQueueFamily, 0);
             m_PresentQueue  = m_Device.getQueue(m_PresentQueueFamily, 0);
             m_TransferQueue = m_Device.getQueue(m_TransferQueueFamily, 0);
+            m_ComputeQueue  = m_Device.getQueue(m_ComputeQueueFamily, 0);
         }
 
         {
             m_GraphicsCommandPool = vk::raii::CommandPool(m_Device, {vk::CommandPoolCreateFlagBits::eResetCommandBuffer, m_GraphicsQueueFamily});
             m_TransferCommandPool = vk::raii::CommandPool(m_Device, {vk::CommandPoolCreateFlagBits::eResetCommandBuffer, m_TransferQueueFamily});
+            m_ComputeCommandPool  = vk::raii::CommandPool(m_Device, {vk::CommandPoolCreateFlagBits::eResetCommandBuffer, m_ComputeQueueFamily});
         }
 
+        m_LayoutCache = std::make_unique<LayoutCache>(m_Device);
+
         {
             VmaVulkanFunctions vkf{};
             vkf.vkGetInstanceProcAddr = VULKAN_HPP_DEFAULT_DISPATCHER.vkGetInstanceProcAddr;
@@ -217,6 +263,8 @@ namespace engine {
         }
     }
 
+    RenderDevice::~RenderDevice() = default;
+
     vk::raii::Semaphore RenderDevice::createSemaphore() const {
         return vk::raii::Semaphore(m_Device, vk::SemaphoreCreateInfo{});
     }
@@ -273,13 +321,14 @@ namespace engine {
 
     std::pair<RawImage, VmaAllocationInfo> RenderDevice::createImage(
         const vk::Extent3D size, const vk::Format format, const vk::ImageUsageFlags usage, const bool preinitialized, const bool linear, const MemoryUsage &memory_usage,
-        const VmaAllocationCreateFlags allocationFlags, const std::vector<uint32_t> &queue_families
+        const VmaAllocationCreateFlags allocationFlags, const std::vector<uint32_t> &queue_families, const uint32_t mip_levels
     ) const {
         vk::ImageCreateInfo ici{};
+        ici.imageType     = size.depth > 1 ? vk::ImageType::e3D : vk::ImageType::e2D; // the struct defaults to 1D
         ici.format        = format;
         ici.extent        = size;
         ici.arrayLayers   = 1;
-        ici.mipLevels     = 1;
+        ici.mipLevels     = mip_levels;
         ici.usage         = usage;
         ici.samples       = vk::SampleCountFlagBits::e1;
         ici.initialLayout = preinitialized ? vk::ImageLayout::ePreinitialized : vk::ImageLayout::eUndefined;
@@ -299,6 +348,10 @@ namespace engine {
         return createImage(ici, aci);
     }
 
+    vk::DeviceAddress RenderDevice::bufferAddress(const RawBuffer &buffer) const {
+        return m_Device.getBufferAddress(vk::BufferDeviceAddressInfo(*buffer.buffer));
+    }
+
     void RenderDevice::copyBufferToBuffer(
         const RawBuffer &srcBuffer, const RawBuffer &dstBuffer, const vk::DeviceSize srcOffset, const vk::DeviceSize dstOffset, vk::DeviceSize size
     ) const {
@@ -319,6 +372,11 @@ namespace engine {
         return vk::raii::CommandBuffers(m_Device, {*m_TransferCommandPool, vk::CommandBufferLevel::ePrimary, count});
     }
 
+    template <>
+    vk::raii::CommandBuffers RenderDevice::allocateCommandBuffers<QueueType::COMPUTE>(uint32_t count) const {
+        return vk::raii::CommandBuffers(m_Device, {*m_ComputeCommandPool, vk::CommandBufferLevel::ePrimary, count});
+    }
+
     void imageTransition(
         const vk::raii::CommandBuffer &cmd, const vk::Image image, const vk::ImageSubresourceRange &isr,
         std::tuple<vk::ImageLayout, vk::PipelineStageFlagBits2, vk::AccessFlags2, uint32_t> sourceState,
@@ -5,12 +5,15 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <vulkan/vulkan_raii.hpp>
 
 #include <vk_mem_alloc.h>
 
 namespace engine {
-    enum class QueueType { GRAPHICS, TRANSFER };
+    enum class QueueType { GRAPHICS, TRANSFER, COMPUTE };
+
+    class LayoutCache;
 
     class Allocation {
       public:
@@ -29,6 +32,8 @@ namespace engine {
 
         void *map() const;
         void  unmap() const;
+        void  flush(vk::DeviceSize offset, vk::DeviceSize size) const;
+        void  invalidate(vk::DeviceSize offset, vk::DeviceSize size) const;
 
       private:
         VmaAllocation allocation;
@@ -86,10 +91,19 @@ namespace engine {
         AutoPreferHost   = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
     };
 
+    struct RenderDeviceOptions {
+        // Look for a compute-capable family without graphics support so compute work can overlap with rendering.
+        // Without one (or when disabled) the compute queue is the graphics queue.
+        bool asyncCompute = true;
+        // No GLFW, surface or swapchain extensions: rendering goes to offscreen images (see HeadlessRenderer), so the device also comes up
+        // without a display, e.g. on lavapipe in CI or on render servers. The present queue is the graphics queue.
+        bool headless = false;
+    };
+
     class RenderDevice {
       public:
-        explicit RenderDevice();
-        ~RenderDevice() = default;
+        explicit RenderDevice(const RenderDeviceOptions &options = {});
+        ~RenderDevice();
 
         [[nodiscard]] const vk::raii::Context        &context() const { return m_Context; }
         [[nodiscard]] const vk::raii::Instance       &instance() const { return m_Instance; }
@@ -98,11 +112,19 @@ namespace engine {
         [[nodiscard]] uint32_t                        graphicsQueueFamily() const { return m_GraphicsQueueFamily; }
         [[nodiscard]] uint32_t                        presentQueueFamily() const { return m_PresentQueueFamily; }
         [[nodiscard]] uint32_t                        transferQueueFamily() const { return m_TransferQueueFamily; }
+        [[nodiscard]] uint32_t                        computeQueueFamily() const { return m_ComputeQueueFamily; }
+        [[nodiscard]] bool                            hasAsyncCompute() const { return m_ComputeQueueFamily != m_GraphicsQueueFamily; }
+        [[nodiscard]] bool                            supportsBlockCompression() const { return m_BlockCompression; }
+        [[nodiscard]] bool                            supportsIndirectFirstInstance() const { return m_IndirectFirstInstance; }
+        [[nodiscard]] bool                            headless() const { return m_Headless; }
         [[nodiscard]] const vk::raii::Queue          &graphicsQueue() const { return m_GraphicsQueue; }
         [[nodiscard]] const vk::raii::Queue          &presentQueue() const { return m_PresentQueue; }
         [[nodiscard]] const vk::raii::Queue          &transferQueue() const { return m_TransferQueue; }
+        [[nodiscard]] const vk::raii::Queue          &computeQueue() const { return m_ComputeQueue; }
         [[nodiscard]] const vk::raii::CommandPool    &graphicsCommandPool() const { return m_GraphicsCommandPool; }
         [[nodiscard]] const vk::raii::CommandPool    &transferCommandPool() const { return m_TransferCommandPool; }
+        [[nodiscard]] const vk::raii::CommandPool    &computeCommandPool() const { return m_ComputeCommandPool; }
+        [[nodiscard]] LayoutCache                    &layoutCache() const { return *m_LayoutCache; }
 
         [[nodiscard]] inline vk::raii::Fence createFence(bool signaled = false) const {
             return vk::raii::Fence(m_Device, {signaled ? vk::FenceCreateFlagBits::eSignaled : vk::FenceCreateFlags{}});
@@ -124,17 +146,19 @@ namespace engine {
         ) const;
         std::pair<RawImage, VmaAllocationInfo> createImage(
             vk::Extent3D size, vk::Format format, vk::ImageUsageFlags usage, bool preinitialized, bool linear, const MemoryUsage &memory_usage,
-            VmaAllocationCreateFlags allocationFlags, const std::vector<uint32_t> &queue_families = {}
+            VmaAllocationCreateFlags allocationFlags, const std::vector<uint32_t> &queue_families = {}, uint32_t mip_levels = 1
         ) const;
 
         inline void waitFence(const vk::raii::Fence &fence, const uint64_t timeout = UINT64_MAX) const { [[maybe_unused]] auto _ = m_Device.waitForFences(*fence, true, timeout); }
         inline void resetFence(const vk::raii::Fence &fence) const { m_Device.resetFences(*fence); };
 
+        [[nodiscard]] vk::DeviceAddress bufferAddress(const RawBuffer &buffer) const;
+
         void copyBufferToBuffer(const RawBuffer &srcBuffer, const RawBuffer &dstBuffer, vk::DeviceSize srcOffset, vk::DeviceSize dstOffset, vk::DeviceSize size) const;
 
         template <QueueType QT>
         inline void singleTimeCommands(const std::function<void(const vk::raii::CommandBuffer &command_buffer)> &f, const vk::raii::Fence &fence) const {
-            static_assert((QT == QueueType::GRAPHICS || QT == QueueType::TRANSFER) && "Queue Type is invalid (must be graphics or transfer)");
+            static_assert((QT == QueueType::GRAPHICS || QT == QueueType::TRANSFER || QT == QueueType::COMPUTE) && "Queue Type is invalid (must be graphics, transfer or compute)");
 
             auto cmd = std::move(allocateCommandBuffers<QT>(1)[0]);
             cmd.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
@@ -148,6 +172,8 @@ namespace engine {
                 m_GraphicsQueue.submit(submit_info, fence);
             } else if constexpr (QT == QueueType::TRANSFER) {
                 m_TransferQueue.submit(submit_info, fence);
+            } else if constexpr (QT == QueueType::COMPUTE) {
+                m_ComputeQueue.submit(submit_info, fence);
             }
         }
 
@@ -160,13 +186,22 @@ namespace engine {
         uint32_t m_GraphicsQueueFamily{UINT32_MAX};
         uint32_t m_PresentQueueFamily{UINT32_MAX};
         uint32_t m_TransferQueueFamily{UINT32_MAX};
+        uint32_t m_ComputeQueueFamily{UINT32_MAX};
+
+        bool m_BlockCompression      = false;
+        bool m_IndirectFirstInstance = false;
+        bool m_Headless              = false;
 
         vk::raii::Queue m_GraphicsQueue{nullptr};
         vk::raii::Queue m_PresentQueue{nullptr};
         vk::raii::Queue m_TransferQueue{nullptr};
+        vk::raii::Queue m_ComputeQueue{nullptr};
 
         vk::raii::CommandPool m_GraphicsCommandPool{nullptr};
         vk::raii::CommandPool m_TransferCommandPool{nullptr};
+        vk::raii::CommandPool m_ComputeCommandPool{nullptr};
+
+        std::unique_ptr<LayoutCache> m_LayoutCache;
 
         Allocator m_Allocator{nullptr};
     };
@@ -177,6 +212,9 @@ namespace engine {
     template <>
     [[nodiscard]] vk::raii::CommandBuffers RenderDevice::allocateCommandBuffers<QueueType::TRANSFER>(uint32_t count) const;
 
+    template <>
+    [[nodiscard]] vk::raii::CommandBuffers RenderDevice::allocateCommandBuffers<QueueType::COMPUTE>(uint32_t count) const;
+
     void imageTransition(
         const vk::raii::CommandBuffer &cmd, vk::Image image, const vk::ImageSubresourceRange &isr,
         std::tuple<vk::ImageLayout, vk::PipelineStageFlagBits2, vk::AccessFlags2, uint32_t> sourceState,
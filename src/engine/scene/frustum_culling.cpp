@@ -0,0 +1,277 @@
+#include "frustum_culling.hpp"
+
+#include "engine/simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace engine {
+    namespace {
+        constexpr float PADDING_RADIUS = -FLT_MAX;
+        constexpr float PADDING_EXTENT = -FLT_MAX / 4.0f; // summed over three axes this must stay finite
+
+        glm::vec4 normalizePlane(const glm::vec4 &plane) {
+            const float inv_length = 1.0f / std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            return plane * inv_length;
+        }
+
+        template <BoundingVolumeType Type>
+        std::size_t cullScalar(const Frustum &frustum, const BoundingVolumes &volumes, const std::size_t begin, const std::size_t end, uint32_t *out) {
+            std::size_t n = 0;
+            for (std::size_t i = begin; i < end; i++) {
+                const glm::vec3 center{volumes.centerX()[i], volumes.centerY()[i], volumes.centerZ()[i]};
+                bool            visible;
+                if constexpr (Type == BoundingVolumeType::Sphere) {
+                    visible = frustum.intersectsSphere(center, volumes.radius()[i]);
+                } else {
+                    visible = frustum.intersectsBox(center, {volumes.extentX()[i], volumes.extentY()[i], volumes.extentZ()[i]});
+                }
+
+                // branchless append, the slot is simply overwritten when the volume is culled.
+                out[n] = static_cast<uint32_t>(i);
+                n += visible ? 1 : 0;
+            }
+            return n;
+        }
+
+#if defined(ENGINE_SIMD_X86)
+        template <BoundingVolumeType Type>
+        std::size_t cullSse(const Frustum &frustum, const BoundingVolumes &volumes, const std::size_t begin, const std::size_t end, uint32_t *out) {
+            __m128 px[6], py[6], pz[6], pw[6], ax[6], ay[6], az[6];
+            for (int p = 0; p < 6; p++) {
+                const auto &plane = frustum.planes[p];
+                px[p]             = _mm_set1_ps(plane.x);
+                py[p]             = _mm_set1_ps(plane.y);
+                pz[p]             = _mm_set1_ps(plane.z);
+                pw[p]             = _mm_set1_ps(plane.w);
+                ax[p]             = _mm_set1_ps(std::abs(plane.x));
+                ay[p]             = _mm_set1_ps(std::abs(plane.y));
+                az[p]             = _mm_set1_ps(std::abs(plane.z));
+            }
+
+            const __m128 zero = _mm_setzero_ps();
+            std::size_t  n    = 0;
+            for (std::size_t i = begin; i < end; i += 4) {
+                const __m128 x = _mm_loadu_ps(volumes.centerX() + i);
+                const __m128 y = _mm_loadu_ps(volumes.centerY() + i);
+                const __m128 z = _mm_loadu_ps(volumes.centerZ() + i);
+
+                __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                if constexpr (Type == BoundingVolumeType::Sphere) {
+                    const __m128 neg_r = _mm_sub_ps(zero, _mm_loadu_ps(volumes.radius() + i));
+                    for (int p = 0; p < 6; p++) {
+                        const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], x), _mm_mul_ps(py[p], y)), _mm_add_ps(_mm_mul_ps(pz[p], z), pw[p]));
+                        visible        = _mm_and_ps(visible, _mm_cmpgt_ps(d, neg_r));
+                    }
+                } else {
+                    const __m128 ex = _mm_loadu_ps(volumes.extentX() + i);
+                    const __m128 ey = _mm_loadu_ps(volumes.extentY() + i);
+                    const __m128 ez = _mm_loadu_ps(volumes.extentZ() + i);
+                    for (int p = 0; p < 6; p++) {
+                        const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], x), _mm_mul_ps(py[p], y)), _mm_add_ps(_mm_mul_ps(pz[p], z), pw[p]));
+                        const __m128 e = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex), _mm_mul_ps(ay[p], ey)), _mm_mul_ps(az[p], ez));
+                        visible        = _mm_and_ps(visible, _mm_cmpgt_ps(_mm_add_ps(d, e), zero));
+                    }
+                }
+
+                for (auto bits = static_cast<uint32_t>(_mm_movemask_ps(visible)); bits != 0; bits &= bits - 1) {
+                    out[n++] = static_cast<uint32_t>(i + std::countr_zero(bits));
+                }
+            }
+            return n;
+        }
+
+        template <BoundingVolumeType Type>
+        ENGINE_TARGET_AVX2 std::size_t cullAvx2(const Frustum &frustum, const BoundingVolumes &volumes, const std::size_t begin, const std::size_t end, uint32_t *out) {
+            __m256 px[6], py[6], pz[6], pw[6], ax[6], ay[6], az[6];
+            for (int p = 0; p < 6; p++) {
+                const auto &plane = frustum.planes[p];
+                px[p]             = _mm256_set1_ps(plane.x);
+                py[p]             = _mm256_set1_ps(plane.y);
+                pz[p]             = _mm256_set1_ps(plane.z);
+                pw[p]             = _mm256_set1_ps(plane.w);
+                ax[p]             = _mm256_set1_ps(std::abs(plane.x));
+                ay[p]             = _mm256_set1_ps(std::abs(plane.y));
+                az[p]             = _mm256_set1_ps(std::abs(plane.z));
+            }
+
+            const __m256 zero = _mm256_setzero_ps();
+            std::size_t  n    = 0;
+            for (std::size_t i = begin; i < end; i += 8) {
+                const __m256 x = _mm256_loadu_ps(volumes.centerX() + i);
+                const __m256 y = _mm256_loadu_ps(volumes.centerY() + i);
+                const __m256 z = _mm256_loadu_ps(volumes.centerZ() + i);
+
+                __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                if constexpr (Type == BoundingVolumeType::Sphere) {
+                    const __m256 neg_r = _mm256_sub_ps(zero, _mm256_loadu_ps(volumes.radius() + i));
+                    for (int p = 0; p < 6; p++) {
+                        const __m256 d = _mm256_fmadd_ps(px[p], x, _mm256_fmadd_ps(py[p], y, _mm256_fmadd_ps(pz[p], z, pw[p])));
+                        visible        = _mm256_and_ps(visible, _mm256_cmp_ps(d, neg_r, _CMP_GT_OQ));
+                    }
+                } else {
+                    const __m256 ex = _mm256_loadu_ps(volumes.extentX() + i);
+                    const __m256 ey = _mm256_loadu_ps(volumes.extentY() + i);
+                    const __m256 ez = _mm256_loadu_ps(volumes.extentZ() + i);
+                    for (int p = 0; p < 6; p++) {
+                        const __m256 d = _mm256_fmadd_ps(px[p], x, _mm256_fmadd_ps(py[p], y, _mm256_fmadd_ps(pz[p], z, pw[p])));
+                        const __m256 e = _mm256_fmadd_ps(ax[p], ex, _mm256_fmadd_ps(ay[p], ey, _mm256_mul_ps(az[p], ez)));
+                        visible        = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(d, e), zero, _CMP_GT_OQ));
+                    }
+                }
+
+                for (auto bits = static_cast<uint32_t>(_mm256_movemask_ps(visible)); bits != 0; bits &= bits - 1) {
+                    out[n++] = static_cast<uint32_t>(i + std::countr_zero(bits));
+                }
+            }
+            return n;
+        }
+#endif
+
+        template <BoundingVolumeType Type>
+        std::size_t cullRange(const Frustum &frustum, const BoundingVolumes &volumes, const std::size_t begin, const std::size_t end, uint32_t *out) {
+#if defined(ENGINE_SIMD_X86)
+            if (simd::hasAvx2()) {
+                return cullAvx2<Type>(frustum, volumes, begin, end, out);
+            }
+            return cullSse<Type>(frustum, volumes, begin, end, out);
+#else
+            return cullScalar<Type>(frustum, volumes, begin, end, out);
+#endif
+        }
+    } // namespace
+
+    Frustum Frustum::fromViewProjection(const glm::mat4 &view_projection) {
+        const auto row = [&](const int r) { return glm::vec4(view_projection[0][r], view_projection[1][r], view_projection[2][r], view_projection[3][r]); };
+        const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+        Frustum frustum{};
+        frustum.planes[0] = normalizePlane(r3 + r0);
+        frustum.planes[1] = normalizePlane(r3 - r0);
+        frustum.planes[2] = normalizePlane(r3 + r1);
+        frustum.planes[3] = normalizePlane(r3 - r1);
+        frustum.planes[4] = normalizePlane(r2);
+        frustum.planes[5] = normalizePlane(r3 - r2);
+        return frustum;
+    }
+
+    bool Frustum::intersectsSphere(const glm::vec3 &center, const float radius) const {
+        for (const auto &plane : planes) {
+            if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w <= -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::intersectsBox(const glm::vec3 &center, const glm::vec3 &extents) const {
+        for (const auto &plane : planes) {
+            const float d = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            const float e = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+            if (d + e <= 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint32_t BoundingVolumes::addSphere(const glm::vec3 &center, const float radius) {
+        const uint32_t index = append();
+        setSphere(index, center, radius);
+        return index;
+    }
+
+    uint32_t BoundingVolumes::addBox(const glm::vec3 &min, const glm::vec3 &max) {
+        const uint32_t index = append();
+        setBox(index, min, max);
+        return index;
+    }
+
+    void BoundingVolumes::setSphere(const uint32_t index, const glm::vec3 &center, const float radius) {
+        set(index, center, glm::vec3(radius, radius, radius), radius);
+    }
+
+    void BoundingVolumes::setBox(const uint32_t index, const glm::vec3 &min, const glm::vec3 &max) {
+        const glm::vec3 extents = (max - min) * 0.5f;
+        set(index, (min + max) * 0.5f, extents, glm::length(extents));
+    }
+
+    void BoundingVolumes::reserve(const std::size_t count) {
+        const std::size_t padded = (count + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        for (auto *array : {&m_CenterX, &m_CenterY, &m_CenterZ, &m_ExtentX, &m_ExtentY, &m_ExtentZ, &m_Radius}) {
+            array->reserve(padded);
+        }
+    }
+
+    void BoundingVolumes::clear() {
+        for (auto *array : {&m_CenterX, &m_CenterY, &m_CenterZ, &m_ExtentX, &m_ExtentY, &m_ExtentZ, &m_Radius}) {
+            array->clear();
+        }
+        m_Count = 0;
+    }
+
+    uint32_t BoundingVolumes::append() {
+        if (m_Count == m_CenterX.size()) {
+            const std::size_t padded = m_CenterX.size() + BLOCK_SIZE;
+            for (auto *array : {&m_CenterX, &m_CenterY, &m_CenterZ}) {
+                array->resize(padded, 0.0f);
+            }
+            for (auto *array : {&m_ExtentX, &m_ExtentY, &m_ExtentZ}) {
+                array->resize(padded, PADDING_EXTENT);
+            }
+            m_Radius.resize(padded, PADDING_RADIUS);
+        }
+        return static_cast<uint32_t>(m_Count++);
+    }
+
+    void BoundingVolumes::set(const uint32_t index, const glm::vec3 &center, const glm::vec3 &extents, const float radius) {
+        m_CenterX[index] = center.x;
+        m_CenterY[index] = center.y;
+        m_CenterZ[index] = center.z;
+        m_ExtentX[index] = extents.x;
+        m_ExtentY[index] = extents.y;
+        m_ExtentZ[index] = extents.z;
+        m_Radius[index]  = radius;
+    }
+
+    FrustumCuller::FrustumCuller(const std::shared_ptr<ThreadPool> &thread_pool) : m_ThreadPool(thread_pool) {}
+
+    void FrustumCuller::cull(const Frustum &frustum, const BoundingVolumes &volumes, const BoundingVolumeType type, std::vector<uint32_t> &visible) {
+        const std::size_t padded = volumes.paddedSize();
+        if (volumes.size() == 0) {
+            visible.clear();
+            return;
+        }
+
+        // every chunk writes into its own slice of the output (sized for the worst case) and the slices are packed together afterwards.
+        visible.resize(padded);
+        const std::size_t chunks = (padded + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        m_ChunkCounts.assign(chunks, 0);
+
+        const auto cull_chunks = [&](const std::size_t first, const std::size_t last) {
+            for (std::size_t c = first; c < last; c++) {
+                const std::size_t begin = c * CHUNK_SIZE;
+                const std::size_t end   = std::min(padded, begin + CHUNK_SIZE);
+                uint32_t         *out   = visible.data() + begin;
+                m_ChunkCounts[c] = type == BoundingVolumeType::Sphere ? cullRange<BoundingVolumeType::Sphere>(frustum, volumes, begin, end, out)
+                                                                      : cullRange<BoundingVolumeType::Box>(frustum, volumes, begin, end, out);
+            }
+        };
+
+        if (m_ThreadPool && chunks > 1) {
+            m_ThreadPool->parallelFor(chunks, 1, cull_chunks);
+        } else {
+            cull_chunks(0, chunks);
+        }
+
+        std::size_t count = m_ChunkCounts[0];
+        for (std::size_t c = 1; c < chunks; c++) {
+            std::memmove(visible.data() + count, visible.data() + c * CHUNK_SIZE, m_ChunkCounts[c] * sizeof(uint32_t));
+            count += m_ChunkCounts[c];
+        }
+        visible.resize(count);
+    }
+} // namespace engine
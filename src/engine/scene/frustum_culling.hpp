@@ -0,0 +1,81 @@
+#pragma once
+
+#include "engine/thread_pool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine {
+
+    struct Frustum {
+        // xyz is the inward facing unit normal, w the plane offset. Order: left, right, bottom, top, near, far.
+        std::array<glm::vec4, 6> planes;
+
+        // Extracts the planes from a clip space matrix using Vulkan's [0, 1] depth range.
+        static Frustum fromViewProjection(const glm::mat4 &view_projection);
+
+        [[nodiscard]] bool intersectsSphere(const glm::vec3 &center, float radius) const;
+        [[nodiscard]] bool intersectsBox(const glm::vec3 &center, const glm::vec3 &extents) const;
+    };
+
+    enum class BoundingVolumeType {
+        Sphere, // center + radius
+        Box     // center + half extents (axis aligned)
+    };
+
+    // Bounding volumes stored as separate component arrays padded to a multiple of `BLOCK_SIZE`.
+    // Padding lanes hold volumes that never pass a plane test, so culling kernels run whole blocks without a scalar tail.
+    class BoundingVolumes {
+      public:
+        constexpr static std::size_t BLOCK_SIZE = 8;
+
+        uint32_t addSphere(const glm::vec3 &center, float radius);
+        uint32_t addBox(const glm::vec3 &min, const glm::vec3 &max);
+
+        void setSphere(uint32_t index, const glm::vec3 &center, float radius);
+        void setBox(uint32_t index, const glm::vec3 &min, const glm::vec3 &max);
+
+        void reserve(std::size_t count);
+        void clear();
+
+        [[nodiscard]] inline std::size_t size() const { return m_Count; }
+        [[nodiscard]] inline std::size_t paddedSize() const { return m_CenterX.size(); }
+
+        [[nodiscard]] inline const float *centerX() const { return m_CenterX.data(); }
+        [[nodiscard]] inline const float *centerY() const { return m_CenterY.data(); }
+        [[nodiscard]] inline const float *centerZ() const { return m_CenterZ.data(); }
+        [[nodiscard]] inline const float *extentX() const { return m_ExtentX.data(); }
+        [[nodiscard]] inline const float *extentY() const { return m_ExtentY.data(); }
+        [[nodiscard]] inline const float *extentZ() const { return m_ExtentZ.data(); }
+        [[nodiscard]] inline const float *radius() const { return m_Radius.data(); }
+
+      private:
+        uint32_t append();
+        void     set(uint32_t index, const glm::vec3 &center, const glm::vec3 &extents, float radius);
+
+        std::size_t        m_Count = 0;
+        std::vector<float> m_CenterX, m_CenterY, m_CenterZ;
+        std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+        std::vector<float> m_Radius;
+    };
+
+    // Tests bounding volumes against a frustum 8 at a time (AVX2 when the cpu has it, SSE otherwise) and writes the indices of the visible ones in ascending order.
+    // Large sets are split into chunks culled on the thread pool, the per-chunk results are compacted into one list afterwards.
+    class FrustumCuller {
+      public:
+        explicit FrustumCuller(const std::shared_ptr<ThreadPool> &thread_pool = nullptr);
+
+        void cull(const Frustum &frustum, const BoundingVolumes &volumes, BoundingVolumeType type, std::vector<uint32_t> &visible);
+
+        constexpr static std::size_t CHUNK_SIZE = 16384;
+
+      private:
+        std::shared_ptr<ThreadPool> m_ThreadPool;
+        std::vector<std::size_t>    m_ChunkCounts;
+    };
+
+} // namespace engine
@@ -0,0 +1,56 @@
+#include "lod_selection.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+    namespace {
+        // keeps the projected error finite for cameras inside the bounding sphere, which always get full detail anyway
+        constexpr float MIN_LOD_DISTANCE = 1e-3f;
+
+        float pixelError(const MeshLod &lod, const float distance, const LodSelectionParams &params) {
+            return lod.error * params.projectionScale / distance;
+        }
+    } // namespace
+
+    float LodSelectionParams::projectionScaleFor(const float fov_y, const float viewport_height) {
+        return viewport_height / (2.0f * std::tan(fov_y * 0.5f));
+    }
+
+    void LodSelector::resize(const std::size_t instance_count) {
+        m_Current.resize(instance_count, 0);
+    }
+
+    void LodSelector::reset() {
+        std::ranges::fill(m_Current, 0);
+    }
+
+    uint32_t LodSelector::select(const std::size_t instance, const MeshLodChain &chain, const glm::vec3 &center, const float radius, const LodSelectionParams &params) {
+        if (chain.lods.size() <= 1) {
+            return m_Current[instance] = 0;
+        }
+
+        const float distance = std::max(glm::length(center - params.cameraPosition) - radius, MIN_LOD_DISTANCE);
+        const auto  last     = static_cast<uint32_t>(chain.lods.size() - 1);
+        uint32_t    lod      = std::min<uint32_t>(m_Current[instance], last);
+
+        while (lod > 0 && pixelError(chain.lods[lod], distance, params) > params.maxPixelError) {
+            lod--;
+        }
+        while (lod < last && pixelError(chain.lods[lod + 1], distance, params) <= params.maxPixelError * (1.0f - params.hysteresis)) {
+            lod++;
+        }
+
+        m_Current[instance] = static_cast<uint8_t>(lod);
+        return lod;
+    }
+
+    uint32_t LodSelector::selectForDistance(const MeshLodChain &chain, float distance, const LodSelectionParams &params) {
+        distance     = std::max(distance, MIN_LOD_DISTANCE);
+        uint32_t lod = 0;
+        while (lod + 1 < chain.lods.size() && pixelError(chain.lods[lod + 1], distance, params) <= params.maxPixelError) {
+            lod++;
+        }
+        return lod;
+    }
+} // namespace engine
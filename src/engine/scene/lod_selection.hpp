@@ -0,0 +1,42 @@
+#pragma once
+
+#include "engine/geometry/mesh_lod.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+    struct LodSelectionParams {
+        glm::vec3 cameraPosition{0.0f};
+        float     projectionScale = 1.0f; // pixels per unit at distance 1, see `projectionScaleFor`
+        float     maxPixelError   = 1.0f; // coarsest level whose projected error stays below this is chosen
+        float     hysteresis      = 0.25f; // a coarser level must beat the threshold by this fraction before switching to it
+
+        static float projectionScaleFor(float fov_y, float viewport_height);
+    };
+
+    // Per instance LOD choice from the projected size of each level's simplification error.
+    // Remembers the level chosen last frame per instance: refining happens as soon as the current level exceeds the pixel threshold,
+    // coarsening only once the next level is below `(1 - hysteresis)` of it, so instances sitting at a boundary distance do not flicker between levels.
+    class LodSelector {
+      public:
+        void resize(std::size_t instance_count);
+        void reset();
+
+        [[nodiscard]] inline std::size_t size() const { return m_Current.size(); }
+        [[nodiscard]] inline uint32_t    current(const std::size_t instance) const { return m_Current[instance]; }
+
+        // `center` and `radius` are the instance's world space bounding sphere.
+        uint32_t select(std::size_t instance, const MeshLodChain &chain, const glm::vec3 &center, float radius, const LodSelectionParams &params);
+
+        // Stateless selection (no hysteresis) for a camera distance measured to the bounding sphere surface.
+        static uint32_t selectForDistance(const MeshLodChain &chain, float distance, const LodSelectionParams &params);
+
+      private:
+        std::vector<uint8_t> m_Current;
+    };
+
+} // namespace engine
@@ -0,0 +1,288 @@
+#include "transform_hierarchy.hpp"
+
+#include "engine/simd.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace engine {
+    namespace {
+        // out = a * b for column-major 4x4 matrices. `out` must not alias `b`.
+        using MultiplyMat4 = void (*)(const float *a, const float *b, float *out);
+
+#if defined(ENGINE_SIMD_X86)
+        void multiplyMat4Sse(const float *a, const float *b, float *out) {
+            const __m128 a0 = _mm_loadu_ps(a);
+            const __m128 a1 = _mm_loadu_ps(a + 4);
+            const __m128 a2 = _mm_loadu_ps(a + 8);
+            const __m128 a3 = _mm_loadu_ps(a + 12);
+            for (int c = 0; c < 4; c++) {
+                const float *bc = b + c * 4;
+                __m128       r  = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+                r               = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+                r               = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+                r               = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+                _mm_storeu_ps(out + c * 4, r);
+            }
+        }
+
+        // two output columns per iteration: broadcast each column of `a` to both halves and scale by the matching elements of two `b` columns.
+        ENGINE_TARGET_AVX2 void multiplyMat4Avx2(const float *a, const float *b, float *out) {
+            const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a));
+            const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 4));
+            const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 8));
+            const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 12));
+            for (int c = 0; c < 4; c += 2) {
+                const float *b0 = b + c * 4;
+                const float *b1 = b0 + 4;
+                __m256       r  = _mm256_mul_ps(a0, _mm256_setr_m128(_mm_set1_ps(b0[0]), _mm_set1_ps(b1[0])));
+                r               = _mm256_fmadd_ps(a1, _mm256_setr_m128(_mm_set1_ps(b0[1]), _mm_set1_ps(b1[1])), r);
+                r               = _mm256_fmadd_ps(a2, _mm256_setr_m128(_mm_set1_ps(b0[2]), _mm_set1_ps(b1[2])), r);
+                r               = _mm256_fmadd_ps(a3, _mm256_setr_m128(_mm_set1_ps(b0[3]), _mm_set1_ps(b1[3])), r);
+                _mm256_storeu_ps(out + c * 4, r);
+            }
+        }
+#else
+        void multiplyMat4Scalar(const float *a, const float *b, float *out) {
+            for (int c = 0; c < 4; c++) {
+                for (int r = 0; r < 4; r++) {
+                    out[c * 4 + r] = a[r] * b[c * 4] + a[4 + r] * b[c * 4 + 1] + a[8 + r] * b[c * 4 + 2] + a[12 + r] * b[c * 4 + 3];
+                }
+            }
+        }
+#endif
+
+        MultiplyMat4 selectMultiplyMat4() {
+#if defined(ENGINE_SIMD_X86)
+            return simd::hasAvx2() ? multiplyMat4Avx2 : multiplyMat4Sse;
+#else
+            return multiplyMat4Scalar;
+#endif
+        }
+    } // namespace
+
+    TransformHierarchy::TransformHierarchy(const std::shared_ptr<ThreadPool> &thread_pool) : m_ThreadPool(thread_pool) {}
+
+    TransformNode TransformHierarchy::create(const TransformNode parent) {
+        TransformNode handle;
+        if (!m_FreeHandles.empty()) {
+            handle = m_FreeHandles.back();
+            m_FreeHandles.pop_back();
+        } else {
+            handle = static_cast<TransformNode>(m_Indices.size());
+            m_Indices.push_back(NULL_TRANSFORM_NODE);
+        }
+
+        const auto     index        = static_cast<uint32_t>(m_Handles.size());
+        const uint32_t parent_index = parent == NULL_TRANSFORM_NODE ? NULL_TRANSFORM_NODE : m_Indices[parent];
+        const uint32_t depth        = parent_index == NULL_TRANSFORM_NODE ? 0 : m_Depths[parent_index] + 1;
+
+        m_Indices[handle] = index;
+        m_Handles.push_back(handle);
+        m_Parents.push_back(parent_index);
+        m_Depths.push_back(depth);
+        m_Local.emplace_back(1.0f);
+        m_World.emplace_back(1.0f);
+        m_Dirty.push_back(1);
+        m_Changed.push_back(0);
+        m_Removed.push_back(0);
+
+        // appending at the deepest level keeps the depth order intact, anything else needs a re-sort.
+        if (m_Levels.empty()) {
+            m_Levels.push_back(0);
+        }
+        const auto level_count = static_cast<uint32_t>(m_Levels.size() - 1);
+        if (!m_LayoutDirty && depth + 1 == level_count) {
+            m_Levels.back()++;
+        } else if (!m_LayoutDirty && depth == level_count) {
+            m_Levels.push_back(index + 1);
+        } else {
+            m_LayoutDirty = true;
+        }
+
+        m_MinDirtyDepth = std::min(m_MinDirtyDepth, depth);
+        return handle;
+    }
+
+    void TransformHierarchy::destroy(const TransformNode node) {
+        m_Removed[m_Indices[node]] = 1;
+        m_LayoutDirty              = true;
+    }
+
+    void TransformHierarchy::setParent(const TransformNode node, const TransformNode parent) {
+        const uint32_t index        = m_Indices[node];
+        const uint32_t parent_index = parent == NULL_TRANSFORM_NODE ? NULL_TRANSFORM_NODE : m_Indices[parent];
+
+        for (uint32_t p = parent_index; p != NULL_TRANSFORM_NODE; p = m_Parents[p]) {
+            if (p == index) {
+                throw std::invalid_argument("TransformHierarchy::setParent(): Parenting a node under its own descendant would create a cycle");
+            }
+        }
+
+        m_Parents[index] = parent_index;
+        m_LayoutDirty    = true;
+        markDirty(index);
+    }
+
+    void TransformHierarchy::setLocal(const TransformNode node, const glm::vec3 &translation, const glm::quat &rotation, const glm::vec3 &scale) {
+        glm::mat4 m = glm::mat4_cast(rotation);
+        m[0] *= scale.x;
+        m[1] *= scale.y;
+        m[2] *= scale.z;
+        m[3]  = glm::vec4(translation, 1.0f);
+        setLocal(node, m);
+    }
+
+    void TransformHierarchy::setLocal(const TransformNode node, const glm::mat4 &local) {
+        const uint32_t index = m_Indices[node];
+        m_Local[index]       = local;
+        markDirty(index);
+    }
+
+    TransformNode TransformHierarchy::parent(const TransformNode node) const {
+        const uint32_t p = m_Parents[m_Indices[node]];
+        return p == NULL_TRANSFORM_NODE ? NULL_TRANSFORM_NODE : m_Handles[p];
+    }
+
+    void TransformHierarchy::update() {
+        if (m_LayoutDirty) {
+            rebuildLayout();
+        }
+
+        std::ranges::fill(m_Changed, 0);
+        if (m_MinDirtyDepth == UINT32_MAX || m_Levels.empty()) {
+            return;
+        }
+
+        // levels run in order so parents are final before their children read them, nodes within a level are independent.
+        for (std::size_t depth = m_MinDirtyDepth; depth + 1 < m_Levels.size(); depth++) {
+            const std::size_t begin = m_Levels[depth];
+            const std::size_t end   = m_Levels[depth + 1];
+
+            if (m_ThreadPool && end - begin >= PARALLEL_GRAIN * 2) {
+                m_ThreadPool->parallelFor(end - begin, PARALLEL_GRAIN, [&](const std::size_t b, const std::size_t e) { updateRange(begin + b, begin + e); });
+            } else {
+                updateRange(begin, end);
+            }
+        }
+
+        std::ranges::fill(m_Dirty, 0);
+        m_MinDirtyDepth = UINT32_MAX;
+    }
+
+    void TransformHierarchy::updateRange(const std::size_t begin, const std::size_t end) {
+        const MultiplyMat4 multiply_mat4 = selectMultiplyMat4();
+
+        for (std::size_t i = begin; i < end; i++) {
+            const uint32_t p = m_Parents[i];
+            if (p == NULL_TRANSFORM_NODE) {
+                if (m_Dirty[i]) {
+                    m_World[i]   = m_Local[i];
+                    m_Changed[i] = 1;
+                }
+            } else if (m_Dirty[i] | m_Changed[p]) {
+                multiply_mat4(&m_World[p][0][0], &m_Local[i][0][0], &m_World[i][0][0]);
+                m_Changed[i] = 1;
+            }
+        }
+    }
+
+    void TransformHierarchy::markDirty(const uint32_t index) {
+        m_Dirty[index]  = 1;
+        m_MinDirtyDepth = std::min(m_MinDirtyDepth, m_Depths[index]);
+    }
+
+    void TransformHierarchy::rebuildLayout() {
+        constexpr uint32_t unresolved = UINT32_MAX;
+        const auto         count      = static_cast<uint32_t>(m_Handles.size());
+
+        // resolve depths parent-first; removal is inherited by every descendant.
+        std::vector<uint32_t> depths(count, unresolved);
+        std::vector<uint32_t> chain;
+        for (uint32_t i = 0; i < count; i++) {
+            for (uint32_t current = i; current != NULL_TRANSFORM_NODE && depths[current] == unresolved; current = m_Parents[current]) {
+                chain.push_back(current);
+            }
+
+            while (!chain.empty()) {
+                const uint32_t node = chain.back();
+                chain.pop_back();
+
+                if (const uint32_t p = m_Parents[node]; p == NULL_TRANSFORM_NODE) {
+                    depths[node] = 0;
+                } else {
+                    depths[node]   = depths[p] + 1;
+                    m_Removed[node] |= m_Removed[p];
+                }
+            }
+        }
+
+        // stable counting sort by depth, siblings keep their relative order.
+        uint32_t max_depth = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (!m_Removed[i]) {
+                max_depth = std::max(max_depth, depths[i]);
+            }
+        }
+
+        std::vector<uint32_t> levels(max_depth + 2, 0);
+        for (uint32_t i = 0; i < count; i++) {
+            if (!m_Removed[i]) {
+                levels[depths[i] + 1]++;
+            }
+        }
+        for (std::size_t d = 1; d < levels.size(); d++) {
+            levels[d] += levels[d - 1];
+        }
+
+        std::vector<uint32_t> cursor(levels.begin(), levels.end() - 1);
+        std::vector<uint32_t> remap(count, NULL_TRANSFORM_NODE);
+        for (uint32_t i = 0; i < count; i++) {
+            if (!m_Removed[i]) {
+                remap[i] = cursor[depths[i]]++;
+            }
+        }
+
+        const uint32_t             total = levels.back();
+        std::vector<TransformNode> handles(total);
+        std::vector<uint32_t>      parents(total);
+        std::vector<uint32_t>      new_depths(total);
+        std::vector<glm::mat4>     local(total);
+        std::vector<glm::mat4>     world(total);
+        std::vector<uint8_t>       dirty(total);
+
+        m_MinDirtyDepth = UINT32_MAX;
+        for (uint32_t i = 0; i < count; i++) {
+            const uint32_t n = remap[i];
+            if (n == NULL_TRANSFORM_NODE) {
+                m_Indices[m_Handles[i]] = NULL_TRANSFORM_NODE;
+                m_FreeHandles.push_back(m_Handles[i]);
+                continue;
+            }
+
+            handles[n]    = m_Handles[i];
+            parents[n]    = m_Parents[i] == NULL_TRANSFORM_NODE ? NULL_TRANSFORM_NODE : remap[m_Parents[i]];
+            new_depths[n] = depths[i];
+            local[n]      = m_Local[i];
+            world[n]      = m_World[i];
+            dirty[n]      = m_Dirty[i];
+
+            m_Indices[handles[n]] = n;
+            if (dirty[n]) {
+                m_MinDirtyDepth = std::min(m_MinDirtyDepth, depths[i]);
+            }
+        }
+
+        m_Handles = std::move(handles);
+        m_Parents = std::move(parents);
+        m_Depths  = std::move(new_depths);
+        m_Local   = std::move(local);
+        m_World   = std::move(world);
+        m_Dirty   = std::move(dirty);
+        m_Levels  = std::move(levels);
+        m_Changed.assign(total, 0);
+        m_Removed.assign(total, 0);
+
+        m_LayoutDirty = false;
+    }
+} // namespace engine
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "engine/thread_pool.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine {
+
+    using TransformNode                         = uint32_t;
+    constexpr TransformNode NULL_TRANSFORM_NODE = UINT32_MAX;
+
+    // Parent/child transforms stored as structure-of-arrays sorted by depth, so every parent is updated before its children and a whole depth level can be processed in one linear pass.
+    // Nodes are addressed through stable handles, the dense order changes whenever the hierarchy is restructured.
+    // Local changes only mark the node dirty; `update` recomputes world matrices for dirty nodes and their descendants and leaves every other branch alone.
+    class TransformHierarchy {
+      public:
+        explicit TransformHierarchy(const std::shared_ptr<ThreadPool> &thread_pool = nullptr);
+
+        TransformNode create(TransformNode parent = NULL_TRANSFORM_NODE);
+
+        // Destroys the node and all of its descendants. Handles are recycled after the next `update`.
+        void destroy(TransformNode node);
+
+        void setParent(TransformNode node, TransformNode parent);
+        void setLocal(TransformNode node, const glm::vec3 &translation, const glm::quat &rotation, const glm::vec3 &scale);
+        void setLocal(TransformNode node, const glm::mat4 &local);
+
+        [[nodiscard]] TransformNode      parent(TransformNode node) const;
+        [[nodiscard]] const glm::mat4   &local(TransformNode node) const { return m_Local[m_Indices[node]]; }
+        [[nodiscard]] const glm::mat4   &world(TransformNode node) const { return m_World[m_Indices[node]]; }
+        [[nodiscard]] bool               worldChanged(TransformNode node) const { return m_Changed[m_Indices[node]] != 0; }
+        [[nodiscard]] inline std::size_t size() const { return m_Handles.size(); }
+
+        // Propagates world matrices. Levels wider than `PARALLEL_GRAIN * 2` nodes are split across the thread pool.
+        void update();
+
+        constexpr static std::size_t PARALLEL_GRAIN = 2048;
+
+      private:
+        void rebuildLayout();
+        void updateRange(std::size_t begin, std::size_t end);
+        void markDirty(uint32_t index);
+
+        std::shared_ptr<ThreadPool> m_ThreadPool;
+
+        // dense, depth sorted
+        std::vector<TransformNode> m_Handles;
+        std::vector<uint32_t>      m_Parents;
+        std::vector<uint32_t>      m_Depths;
+        std::vector<glm::mat4>     m_Local;
+        std::vector<glm::mat4>     m_World;
+        std::vector<uint8_t>       m_Dirty;   // local changed since the last update
+        std::vector<uint8_t>       m_Changed; // world recomputed by the last update
+        std::vector<uint8_t>       m_Removed;
+
+        // m_Levels[d] is the first dense index at depth d, the last entry is the node count.
+        std::vector<uint32_t> m_Levels;
+
+        // handle -> dense index
+        std::vector<uint32_t>      m_Indices;
+        std::vector<TransformNode> m_FreeHandles;
+
+        uint32_t m_MinDirtyDepth = UINT32_MAX;
+        bool     m_LayoutDirty   = false;
+    };
+
+} // namespace engine
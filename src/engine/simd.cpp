@@ -0,0 +1,41 @@
+#include "simd.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace engine::simd {
+    namespace {
+        bool detectAvx2() {
+#if !defined(ENGINE_SIMD_X86)
+            return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+
+            // the OS has to save ymm registers on context switch (OSXSAVE + XCR0 bits 1 and 2), otherwise AVX is unusable even when the cpu has it.
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool fma     = (info[2] & (1 << 12)) != 0;
+            const bool f16c    = (info[2] & (1 << 29)) != 0;
+            if (!osxsave || !fma || !f16c || (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+#endif
+        }
+    } // namespace
+
+    bool hasAvx2() {
+        static const bool supported = detectAvx2();
+        return supported;
+    }
+} // namespace engine::simd
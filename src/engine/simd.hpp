@@ -0,0 +1,19 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ENGINE_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Marks a function as compiled for a newer instruction set than the baseline. Callers must check `simd::hasAvx2()` (etc.) before calling it.
+// MSVC accepts intrinsics for any instruction set without per-function attributes.
+// The AVX2 tier includes FMA and F16C, every cpu shipping AVX2 has both.
+#if defined(ENGINE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ENGINE_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#else
+#define ENGINE_TARGET_AVX2
+#endif
+
+namespace engine::simd {
+    [[nodiscard]] bool hasAvx2();
+} // namespace engine::simd
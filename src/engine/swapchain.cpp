@@ -15,6 +15,14 @@ namespace engine {
         cmd.setScissorWithCount(scissor);
     }
 
+    void SwapchainFrameInfo::setViewportAndScissor(CommandState &state) const {
+        const vk::Viewport viewport = {0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+        const vk::Rect2D   scissor  = {{0, 0}, extent};
+
+        state.setViewportWithCount(viewport);
+        state.setScissorWithCount(scissor);
+    }
+
     Swapchain::Swapchain(const std::shared_ptr<RenderDevice> &render_system, const std::shared_ptr<Window> &window)
         : m_Window(window), m_RenderDevice(render_system), m_Swapchain(nullptr) {
         reconfigure();
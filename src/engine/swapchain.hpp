@@ -1,4 +1,5 @@
 #pragma once
+#include "render/command_state.hpp"
 #include "utils.hpp"
 #include "window.hpp"
 
@@ -13,6 +14,7 @@ namespace engine {
         vk::Extent2D         extent;
 
         void setViewportAndScissor(const vk::raii::CommandBuffer& cmd) const;
+        void setViewportAndScissor(CommandState &state) const;
     };
 
     class Swapchain {
@@ -0,0 +1,122 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace engine {
+    ThreadPool::ThreadPool(const uint32_t thread_count) {
+        m_Threads.reserve(thread_count);
+        for (uint32_t i = 0; i < thread_count; i++) {
+            m_Threads.emplace_back([this](const std::stop_token &stop_token) { workerLoop(stop_token); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        // stop and join explicitly, the queue and condition variable must outlive the workers.
+        for (auto &thread : m_Threads) {
+            thread.request_stop();
+        }
+        for (auto &thread : m_Threads) {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::enqueue(std::function<void()> job) {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Jobs.push_back(std::move(job));
+        }
+        m_JobAvailable.notify_one();
+    }
+
+    void ThreadPool::parallelFor(const std::size_t count, std::size_t grain, const std::function<void(std::size_t begin, std::size_t end)> &f) {
+        if (count == 0) {
+            return;
+        }
+
+        grain                    = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (count + grain - 1) / grain;
+
+        if (chunks == 1 || m_Threads.empty()) {
+            f(0, count);
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr       error;
+        std::mutex               error_mutex;
+
+        const auto work = [&] {
+            for (std::size_t chunk = next.fetch_add(1, std::memory_order_relaxed); chunk < chunks; chunk = next.fetch_add(1, std::memory_order_relaxed)) {
+                try {
+                    f(chunk * grain, std::min(count, (chunk + 1) * grain));
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        const std::size_t        helpers = std::min<std::size_t>(chunks - 1, m_Threads.size());
+        std::atomic<std::size_t> pending{helpers};
+        for (std::size_t i = 0; i < helpers; i++) {
+            enqueue([&] {
+                work();
+                pending.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        work();
+        waitFor([&] { return pending.load(std::memory_order_acquire) == 0; });
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void ThreadPool::waitFor(const std::function<bool()> &done) {
+        while (!done()) {
+            if (!runPendingJob()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool ThreadPool::runPendingJob() {
+        std::function<void()> job;
+        {
+            std::lock_guard lock(m_Mutex);
+            if (m_Jobs.empty()) {
+                return false;
+            }
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+        }
+
+        job();
+        return true;
+    }
+
+    uint32_t ThreadPool::defaultThreadCount() {
+        // leave one core for the thread driving the frame loop, it participates in parallel work while waiting anyway.
+        const uint32_t hc = std::thread::hardware_concurrency();
+        return hc > 1 ? hc - 1 : 1;
+    }
+
+    void ThreadPool::workerLoop(const std::stop_token &stop_token) {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(m_Mutex);
+                if (!m_JobAvailable.wait(lock, stop_token, [this] { return !m_Jobs.empty(); })) {
+                    return;
+                }
+                job = std::move(m_Jobs.front());
+                m_Jobs.pop_front();
+            }
+
+            job();
+        }
+    }
+} // namespace engine
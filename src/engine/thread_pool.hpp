@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+    // Fixed set of worker threads pulling jobs from a single shared queue.
+    // Threads that block waiting on pool work (`parallelFor`, `waitFor`) run queued jobs while they wait, so nested parallel work cannot deadlock the pool.
+    class ThreadPool {
+      public:
+        explicit ThreadPool(uint32_t thread_count = defaultThreadCount());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &)            = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        [[nodiscard]] inline uint32_t threadCount() const { return static_cast<uint32_t>(m_Threads.size()); }
+
+        void enqueue(std::function<void()> job);
+
+        template <typename F>
+        auto submit(F &&f) -> std::future<std::invoke_result_t<F>> {
+            using result_t = std::invoke_result_t<F>;
+            auto task      = std::make_shared<std::packaged_task<result_t()>>(std::forward<F>(f));
+            auto future    = task->get_future();
+            enqueue([task] { (*task)(); });
+            return future;
+        }
+
+        // Splits [0, count) into chunks of `grain` elements and runs `f(begin, end)` for each chunk on the workers and the calling thread.
+        // Returns once every chunk has finished. Exceptions thrown by `f` are rethrown on the calling thread (the first one wins).
+        void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t begin, std::size_t end)> &f);
+
+        // Runs queued jobs on the calling thread until `done()` returns true.
+        void waitFor(const std::function<bool()> &done);
+
+        // Pops and runs one queued job on the calling thread. Returns false if the queue was empty.
+        bool runPendingJob();
+
+        static uint32_t defaultThreadCount();
+
+      private:
+        void workerLoop(const std::stop_token &stop_token);
+
+        std::vector<std::jthread>         m_Threads;
+        std::deque<std::function<void()>> m_Jobs;
+        std::mutex                        m_Mutex;
+        std::condition_variable_any       m_JobAvailable;
+    };
+
+} // namespace engine
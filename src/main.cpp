@@ -1,16 +1,42 @@
 #include "app/engine_app.hpp"
 
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
-
-int main() {
+// gameengine [--headless [--frames N] [--size WxH] [--capture file.png]]
+int main(const int argc, char **argv) {
     try {
-        auto *app = new app::EngineApp();
+        app::EngineAppOptions options;
+        for (int i = 1; i < argc; i++) {
+            const std::string_view arg(argv[i]);
+            if (arg == "--headless") {
+                options.headless = true;
+            } else if (arg == "--frames" && i + 1 < argc) {
+                options.frames = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--size" && i + 1 < argc) {
+                const std::string size(argv[++i]);
+                const auto        x = size.find('x');
+                if (x == std::string::npos) {
+                    throw std::invalid_argument("Size must look like 1920x1080");
+                }
+                options.extent = vk::Extent2D(static_cast<uint32_t>(std::stoul(size.substr(0, x))), static_cast<uint32_t>(std::stoul(size.substr(x + 1))));
+            } else if (arg == "--capture" && i + 1 < argc) {
+                options.capture = argv[++i];
+            } else {
+                std::cerr << "usage: gameengine [--headless [--frames N] [--size WxH] [--capture file.png]]" << std::endl;
+                return 1;
+            }
+        }
+
+        auto *app = new app::EngineApp(options);
         app->run();
 
         delete app;
     } catch (std::exception &e) {
         std::cerr << e.what() << std::endl;
+        return 1; // so CI runs fail
     }
 
     return 0;
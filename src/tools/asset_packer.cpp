@@ -0,0 +1,62 @@
+// Packs files into an asset archive: asset_packer [--compress] <output> <file or directory>...
+// Entries are named by their path relative to the working directory, which is how the engine asks for them ("assets/shaders/main.vert.spv").
+// With --compress entries are deflated, except SPIR-V which stays uncompressed so shaders are created straight from the mapping.
+
+#include "engine/assets/asset_archive.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace {
+    engine::AssetCompression compressionFor(const std::filesystem::path &path, const bool compress) {
+        return compress && path.extension() != ".spv" ? engine::AssetCompression::Deflate : engine::AssetCompression::None;
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    bool                               compress = false;
+    std::vector<std::filesystem::path> args;
+    for (int i = 1; i < argc; i++) {
+        if (std::string_view(argv[i]) == "--compress") {
+            compress = true;
+        } else {
+            args.emplace_back(argv[i]);
+        }
+    }
+
+    if (args.size() < 2) {
+        std::cerr << "usage: asset_packer [--compress] <output> <file or directory>..." << std::endl;
+        return 1;
+    }
+
+    try {
+        engine::AssetArchiveWriter writer;
+
+        const auto add = [&](const std::filesystem::path &path) {
+            const std::string name = path.lexically_normal().generic_string();
+            writer.addFile(name, path, compressionFor(path, compress));
+            std::cout << "Packed " << name << std::endl;
+        };
+
+        for (auto it = args.begin() + 1; it != args.end(); ++it) {
+            if (std::filesystem::is_directory(*it)) {
+                for (const auto &entry : std::filesystem::recursive_directory_iterator(*it)) {
+                    if (entry.is_regular_file()) {
+                        add(entry.path());
+                    }
+                }
+            } else {
+                add(*it);
+            }
+        }
+
+        writer.write(args.front());
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Cooks an image into a block-compressed texture: texture_cooker [--format bc1|bc3|bc4|bc5|bc7] [--linear] [--no-mips] <input> <output>
+// The mip chain is built on the CPU (in linear light unless --linear says the data isn't color) and every level is encoded on all cores.
+// The engine uploads the result as is, no decoding at load time.
+
+#include "engine/assets/texture_compression.hpp"
+#include "engine/assets/texture_file.hpp"
+#include "engine/assets/texture_image.hpp"
+#include "engine/thread_pool.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace {
+    std::optional<engine::BlockFormat> parseFormat(const std::string_view name) {
+        if (name == "bc1") {
+            return engine::BlockFormat::BC1;
+        }
+        if (name == "bc3") {
+            return engine::BlockFormat::BC3;
+        }
+        if (name == "bc4") {
+            return engine::BlockFormat::BC4;
+        }
+        if (name == "bc5") {
+            return engine::BlockFormat::BC5;
+        }
+        if (name == "bc7") {
+            return engine::BlockFormat::BC7;
+        }
+        return std::nullopt;
+    }
+
+    std::vector<std::byte> readFile(const std::filesystem::path &path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open " + path.string());
+        }
+        std::vector<std::byte> data(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        return data;
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    engine::BlockFormat                format = engine::BlockFormat::BC7;
+    bool                               srgb   = true;
+    bool                               mips   = true;
+    std::vector<std::filesystem::path> args;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--format" && i + 1 < argc) {
+            const auto parsed = parseFormat(argv[++i]);
+            if (!parsed) {
+                std::cerr << "Unknown format " << argv[i] << std::endl;
+                return 1;
+            }
+            format = *parsed;
+        } else if (arg == "--linear") {
+            srgb = false;
+        } else if (arg == "--no-mips") {
+            mips = false;
+        } else {
+            args.emplace_back(arg);
+        }
+    }
+
+    if (args.size() != 2) {
+        std::cerr << "usage: texture_cooker [--format bc1|bc3|bc4|bc5|bc7] [--linear] [--no-mips] <input> <output>" << std::endl;
+        return 1;
+    }
+
+    // single and two channel formats hold data, never color
+    if (format == engine::BlockFormat::BC4 || format == engine::BlockFormat::BC5) {
+        srgb = false;
+    }
+
+    try {
+        using Clock      = std::chrono::steady_clock;
+        const auto start = Clock::now();
+
+        engine::ThreadPool   thread_pool;
+        engine::TextureImage image = engine::TextureImage::decode(readFile(args[0]));
+
+        const uint32_t                      width  = image.width;
+        const uint32_t                      height = image.height;
+        const uint32_t                      count  = mips ? engine::mipLevelCount(width, height) : 1;
+        std::vector<std::vector<std::byte>> levels;
+        for (uint32_t level = 0; level < count; level++) {
+            levels.push_back(engine::compressImage(format, image, &thread_pool));
+            if (level + 1 < count) {
+                image = image.downsampled(srgb);
+            }
+        }
+
+        const auto    file = engine::TextureFile::serialize(format, srgb, width, height, levels);
+        std::ofstream output(args[1], std::ios::binary);
+        if (!output.write(reinterpret_cast<const char *>(file.data()), static_cast<std::streamsize>(file.size()))) {
+            throw std::runtime_error("Failed to write " + args[1].string());
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+        std::cout << "Cooked " << args[0].string() << " (" << width << "x" << height << ", " << count << " levels, " << file.size() << " bytes) in " << elapsed.count()
+                  << "ms" << std::endl;
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}